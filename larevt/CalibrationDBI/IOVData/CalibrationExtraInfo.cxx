@@ -5,47 +5,47 @@ namespace lariov {
 
   void CalibrationExtraInfo::AddOrReplaceBoolData(std::string const& label, bool const data)
   {
-    fBoolData[label] = data;
+    fBoolData.Set(label, data);
   }
 
   void CalibrationExtraInfo::AddOrReplaceIntData(std::string const& label, int const data)
   {
-    fIntData[label] = data;
+    fIntData.Set(label, data);
   }
 
   void CalibrationExtraInfo::AddOrReplaceVecIntData(std::string const& label,
                                                     std::vector<int> const& data)
   {
-    fVecIntData[label] = data;
+    fVecIntData.Set(label, data);
   }
 
   void CalibrationExtraInfo::AddOrReplaceFloatData(std::string const& label, float const data)
   {
-    fFloatData[label] = data;
+    fFloatData.Set(label, data);
   }
 
   void CalibrationExtraInfo::AddOrReplaceVecFloatData(std::string const& label,
                                                       std::vector<float> const& data)
   {
-    fVecFloatData[label] = data;
+    fVecFloatData.Set(label, data);
   }
 
   void CalibrationExtraInfo::AddOrReplaceStringData(std::string const& label,
                                                     std::string const& data)
   {
-    fStringData[label] = data;
+    fStringData.Set(label, data);
   }
 
   void CalibrationExtraInfo::ClearDataByLabel(std::string const& label)
   {
     unsigned int n_erased = 0;
 
-    n_erased += fBoolData.erase(label);
-    n_erased += fIntData.erase(label);
-    n_erased += fVecIntData.erase(label);
-    n_erased += fFloatData.erase(label);
-    n_erased += fVecFloatData.erase(label);
-    n_erased += fStringData.erase(label);
+    n_erased += fBoolData.Erase(label);
+    n_erased += fIntData.Erase(label);
+    n_erased += fVecIntData.Erase(label);
+    n_erased += fFloatData.Erase(label);
+    n_erased += fVecFloatData.Erase(label);
+    n_erased += fStringData.Erase(label);
 
     if (n_erased > 1) {
       std::cout << "INFO(CalibrationExtraInfo): Erased more than one entry with label " << label
@@ -55,17 +55,17 @@ namespace lariov {
 
   void CalibrationExtraInfo::ClearAllData()
   {
-    fBoolData.clear();
-    fIntData.clear();
-    fVecIntData.clear();
-    fFloatData.clear();
-    fVecFloatData.clear();
-    fStringData.clear();
+    fBoolData.Clear();
+    fIntData.Clear();
+    fVecIntData.Clear();
+    fFloatData.Clear();
+    fVecFloatData.Clear();
+    fStringData.Clear();
   }
 
   bool CalibrationExtraInfo::GetBoolData(std::string const& label) const
   {
-    if (fBoolData.find(label) != fBoolData.end()) { return fBoolData.at(label); }
+    if (auto data = fBoolData.Find(label)) { return *data; }
 
     throw IOVDataError("CalibrationExtraInfo: Could not find extra bool data " + label +
                        " for calibration " + fName);
@@ -73,7 +73,7 @@ namespace lariov {
 
   int CalibrationExtraInfo::GetIntData(std::string const& label) const
   {
-    if (fIntData.find(label) != fIntData.end()) { return fIntData.at(label); }
+    if (auto data = fIntData.Find(label)) { return *data; }
 
     throw IOVDataError("CalibrationExtraInfo: Could not find extra int data " + label +
                        " for calibration " + fName);
@@ -81,7 +81,7 @@ namespace lariov {
 
   std::vector<int> const& CalibrationExtraInfo::GetVecIntData(std::string const& label) const
   {
-    if (fVecIntData.find(label) != fVecIntData.end()) { return fVecIntData.at(label); }
+    if (auto data = fVecIntData.Find(label)) { return *data; }
 
     throw IOVDataError("CalibrationExtraInfo: Could not find extra vector int data " + label +
                        " for calibration " + fName);
@@ -89,7 +89,7 @@ namespace lariov {
 
   float CalibrationExtraInfo::GetFloatData(std::string const& label) const
   {
-    if (fFloatData.find(label) != fFloatData.end()) { return fFloatData.at(label); }
+    if (auto data = fFloatData.Find(label)) { return *data; }
 
     throw IOVDataError("CalibrationExtraInfo: Could not find extra float data " + label +
                        " for calibration " + fName);
@@ -97,7 +97,7 @@ namespace lariov {
 
   std::vector<float> const& CalibrationExtraInfo::GetVecFloatData(std::string const& label) const
   {
-    if (fVecFloatData.find(label) != fVecFloatData.end()) { return fVecFloatData.at(label); }
+    if (auto data = fVecFloatData.Find(label)) { return *data; }
 
     throw IOVDataError("CalibrationExtraInfo: Could not find extra vector float data " + label +
                        " for calibration " + fName);
@@ -105,7 +105,7 @@ namespace lariov {
 
   std::string const& CalibrationExtraInfo::GetStringData(std::string const& label) const
   {
-    if (fStringData.find(label) != fStringData.end()) { return fStringData.at(label); }
+    if (auto data = fStringData.Find(label)) { return *data; }
 
     throw IOVDataError("CalibrationExtraInfo: Could not find extra string data " + label +
                        " for calibration " + fName);
@@ -1,12 +1,22 @@
 #ifndef CALIBRATIONEXTRAINFO_H
 #define CALIBRATIONEXTRAINFO_H
 
-#include <map>
+#include <algorithm>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace lariov {
 
+  /**
+     Extra data of a calibration, by label.
+
+     Calibration rows hold a shared pointer to their extra information, so
+     that all the rows of an interval of validity can share a single instance
+     and only the channels with their own extra data carry a copy.  Data is
+     kept in vectors sorted by label, which are compact and fast to copy and
+     look up for the few labels a calibration has.
+  */
   class CalibrationExtraInfo {
 
   public:
@@ -35,17 +45,64 @@ namespace lariov {
     void ClearAllData();
 
   private:
+    /// Values sorted by label
+    template <typename T>
+    class LabelMap {
+    public:
+      void Set(std::string const& label, T const& value)
+      {
+        auto it = LowerBound(label);
+        if (it != fData.end() && it->first == label)
+          it->second = value;
+        else
+          fData.emplace(it, label, value);
+      }
+
+      T const* Find(std::string const& label) const
+      {
+        auto it = LowerBound(label);
+        return (it != fData.end() && it->first == label) ? &it->second : nullptr;
+      }
+
+      unsigned int Erase(std::string const& label)
+      {
+        auto it = LowerBound(label);
+        if (it == fData.end() || it->first != label) return 0;
+        fData.erase(it);
+        return 1;
+      }
+
+      void Clear() { fData.clear(); }
+
+    private:
+      using Data_t = std::vector<std::pair<std::string, T>>;
+      Data_t fData;
+
+      typename Data_t::iterator LowerBound(std::string const& label)
+      {
+        return std::lower_bound(fData.begin(), fData.end(), label, LabelLess);
+      }
+      typename Data_t::const_iterator LowerBound(std::string const& label) const
+      {
+        return std::lower_bound(fData.begin(), fData.end(), label, LabelLess);
+      }
+      static bool LabelLess(std::pair<std::string, T> const& entry, std::string const& label)
+      {
+        return entry.first < label;
+      }
+    };
+
     std::string fName;
 
-    std::map<std::string, bool> fBoolData;
+    LabelMap<bool> fBoolData;
 
-    std::map<std::string, int> fIntData;
-    std::map<std::string, std::vector<int>> fVecIntData;
+    LabelMap<int> fIntData;
+    LabelMap<std::vector<int>> fVecIntData;
 
-    std::map<std::string, float> fFloatData;
-    std::map<std::string, std::vector<float>> fVecFloatData;
+    LabelMap<float> fFloatData;
+    LabelMap<std::vector<float>> fVecFloatData;
 
-    std::map<std::string, std::string> fStringData;
+    LabelMap<std::string> fStringData;
   };
 }
 
@@ -26,8 +26,9 @@ namespace lariov {
     /// Constructor
     ChData(unsigned int ch) : fChannel(ch) {}
 
-    /// Default destructor
-    virtual ~ChData() {}
+    /// Default destructor.  Not virtual: rows are stored by value in snapshots
+    /// and never deleted through a ChData pointer, so they carry no vtable.
+    ~ChData() = default;
 
     unsigned int Channel() const { return fChannel; }
     void SetChannel(unsigned int ch) { fChannel = ch; }
@@ -0,0 +1,115 @@
+/**
+ * \file ChannelCalibrationBundle.h
+ *
+ * \ingroup Snapshot
+ *
+ * \brief Class def header for a class ChannelCalibrationBundle
+ */
+
+/** \addtogroup Snapshot
+
+    @{*/
+#ifndef IOVDATA_CHANNELCALIBRATIONBUNDLE_H
+#define IOVDATA_CHANNELCALIBRATIONBUNDLE_H
+
+#include "ChannelStatus.h"
+#include "IOVDataError.h"
+#include "IOVTimeStamp.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace lariov {
+
+  /**
+     \class ChannelCalibrationBundle
+     Pedestal, electronics calibration and status of each channel, joined in
+     a single array indexed by channel number.
+
+     Each record takes half a cache line, so that the calibration of a
+     channel is read with one memory access and no search.  Only the values
+     needed while processing the signal are kept; uncertainties and extra
+     information are still available from the providers.
+
+     A bundle is immutable once built.  Its interval of validity is the
+     intersection of the ones of the snapshots it was built from (see
+     ChannelCalibrationBundleProvider).
+  */
+  class ChannelCalibrationBundle {
+
+  public:
+    /// Bits of Record::sources, one per provider having a row for the channel
+    enum Source : std::uint8_t { kPedestal = 0x1, kElectronics = 0x2, kStatus = 0x4 };
+
+    /// Data from all the sources
+    static constexpr std::uint8_t kAllSources = kPedestal | kElectronics | kStatus;
+
+    struct alignas(32) Record {
+      float pedMean = 0.f;
+      float pedRms = 0.f;
+      float gain = 0.f;
+      float shapingTime = 0.f;
+      std::uint8_t status = kUNKNOWN; // A chStatus value.
+      std::uint8_t sources = 0;       // Bits from Source.
+
+      bool IsComplete() const { return sources == kAllSources; }
+      bool IsGood() const { return status == kGOOD; }
+    };
+
+    ChannelCalibrationBundle() : fStart(0, 0), fEnd(0, 0) {}
+
+    const IOVTimeStamp& Start() const { return fStart; }
+    const IOVTimeStamp& End() const { return fEnd; }
+
+    void SetIoV(const IOVTimeStamp& start, const IOVTimeStamp& end)
+    {
+      if (start >= end) {
+        throw IOVDataError(
+          "Called ChannelCalibrationBundle::SetIoV with start timestamp >= end timestamp!");
+      }
+      fStart = start;
+      fEnd = end;
+    }
+
+    bool IsValid(const IOVTimeStamp& ts) const { return (ts >= fStart && ts < fEnd); }
+
+    /// One past the largest channel that may have a record
+    size_t ChannelLimit() const { return fRecords.size(); }
+
+    bool HasChannel(unsigned int ch) const
+    {
+      return ch < fRecords.size() && fRecords[ch].sources != 0;
+    }
+
+    const Record& GetRecord(unsigned int ch) const
+    {
+      if (!HasChannel(ch)) {
+        std::string msg("Channel not found: ");
+        msg += std::to_string(ch);
+        throw IOVDataError(msg);
+      }
+      return fRecords[ch];
+    }
+
+    /// Records of all channels up to ChannelLimit(), for loops over many channels
+    const Record* Records() const { return fRecords.data(); }
+
+    /// Replaces the content with channelLimit empty records
+    void Reset(size_t channelLimit) { fRecords.assign(channelLimit, Record()); }
+
+    /// Record of channel ch, which must be below ChannelLimit(), for filling
+    Record& MutableRecord(unsigned int ch) { return fRecords[ch]; }
+
+  private:
+    IOVTimeStamp fStart;
+    IOVTimeStamp fEnd;
+    std::vector<Record> fRecords; // Indexed by channel.
+  };
+
+  static_assert(sizeof(ChannelCalibrationBundle::Record) == 32,
+                "ChannelCalibrationBundle records must pack two per cache line");
+
+} //end namespace lariov
+#endif
+/** @} */ // end of doxygen group
@@ -0,0 +1,79 @@
+#include "ChannelStatusSnapshot.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace lariov {
+
+  void ChannelStatusSnapshot::BuildIndex()
+  {
+    size_t const limit = ChannelLimit();
+
+    std::array<size_t, kUNKNOWN + 1> counts{};
+    fPackedStatus.assign(limit, kNoStatus);
+    for (unsigned int ch = 0; ch != limit; ++ch) {
+      if (!HasChannel(ch)) continue;
+      chStatus const status = GetRow(ch).Status();
+      fPackedStatus[ch] = std::uint8_t(status);
+      ++counts[status];
+    }
+
+    size_t const nWords = (limit + 63) / 64;
+    for (size_t status = 0; status != fByStatus.size(); ++status) {
+      fByStatus[status].clear();
+      fByStatus[status].reserve(counts[status]);
+      fBitsByStatus[status].assign(nWords, 0);
+    }
+    for (unsigned int ch = 0; ch != limit; ++ch) {
+      std::uint8_t const status = fPackedStatus[ch];
+      if (status == kNoStatus) continue;
+      fByStatus[status].push_back(ch);
+      fBitsByStatus[status][ch / 64] |= std::uint64_t(1) << (ch % 64);
+    }
+
+    fBad.clear();
+    fBad.reserve(counts[kDEAD] + counts[kLOWNOISE]);
+    std::merge(fByStatus[kDEAD].begin(),
+               fByStatus[kDEAD].end(),
+               fByStatus[kLOWNOISE].begin(),
+               fByStatus[kLOWNOISE].end(),
+               std::back_inserter(fBad));
+
+    fBadBits.resize(nWords);
+    for (size_t i = 0; i != nWords; ++i)
+      fBadBits[i] = fBitsByStatus[kDEAD][i] | fBitsByStatus[kLOWNOISE][i];
+  }
+
+  bool ChannelStatusSnapshot::MatchStatus(const DBChannelID_t* channels,
+                                          size_t n,
+                                          unsigned int statusMask,
+                                          std::uint64_t* result) const
+  {
+    size_t const nWords = (n + 63) / 64;
+    if (fPackedStatus.empty()) {
+      std::fill(result, result + nWords, 0);
+      return n == 0;
+    }
+
+    const std::uint8_t* packed = fPackedStatus.data();
+    DBChannelID_t const limit = DBChannelID_t(fPackedStatus.size());
+    unsigned int missing = 0;
+    for (size_t w = 0; w != nWords; ++w) {
+      size_t const first = w * 64;
+      size_t const count = std::min<size_t>(n - first, 64);
+      std::uint64_t word = 0;
+      for (size_t i = 0; i != count; ++i) {
+        DBChannelID_t const ch = channels[first + i];
+        unsigned int const inRange = ch < limit;
+        unsigned int const stored = packed[inRange ? ch : 0]; // Always a valid load.
+        unsigned int const status = inRange ? stored : kNoStatus;
+        unsigned int const known = status != kNoStatus;
+        missing |= known ^ 1;
+        word |= std::uint64_t((statusMask >> (status & 31)) & known) << i;
+      }
+      result[w] = word;
+    }
+    return missing == 0;
+  }
+
+} //end namespace lariov
@@ -0,0 +1,84 @@
+/**
+ * \file ChannelStatusSnapshot.h
+ *
+ * \ingroup Snapshot
+ *
+ * \brief Class def header for a class ChannelStatusSnapshot
+ */
+
+/** \addtogroup Snapshot
+
+    @{*/
+#ifndef IOVDATA_CHANNELSTATUSSNAPSHOT_H
+#define IOVDATA_CHANNELSTATUSSNAPSHOT_H
+
+#include "ChannelStatus.h"
+#include "DenseSnapshot.h"
+#include "larevt/CalibrationDBI/Interface/CalibrationDBIFwd.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace lariov {
+
+  /**
+     \class ChannelStatusSnapshot
+     Channel statuses of one interval of validity, with indexes answering set
+     queries without visiting every channel: a packed array of status codes,
+     and the sorted list and the bit mask of channels for each status.
+
+     The indexes are computed by BuildIndex(), which must be called again
+     after rows are added or replaced.
+  */
+  class ChannelStatusSnapshot : public DenseSnapshot<ChannelStatus> {
+
+  public:
+    using ChannelList_t = std::vector<DBChannelID_t>;
+    using ChannelBits_t = std::vector<std::uint64_t>;
+
+    /// Packed status of channels without a row
+    static constexpr std::uint8_t kNoStatus = 0xFF;
+
+    /// Computes the indexes from the current rows
+    void BuildIndex();
+
+    /// Status (a chStatus value) of each channel up to ChannelLimit(), or kNoStatus
+    const std::vector<std::uint8_t>& PackedStatus() const { return fPackedStatus; }
+
+    /// Sorted list of the channels with the specified status
+    const ChannelList_t& ChannelsWithStatus(chStatus status) const { return fByStatus[status]; }
+
+    /// Sorted list of the channels either dead or with low noise
+    const ChannelList_t& BadChannels() const { return fBad; }
+
+    /// One bit per channel up to ChannelLimit(), set for channels with the specified status
+    const ChannelBits_t& StatusBits(chStatus status) const { return fBitsByStatus[status]; }
+
+    /// One bit per channel up to ChannelLimit(), set for channels dead or with low noise
+    const ChannelBits_t& BadBits() const { return fBadBits; }
+
+    /// Returns the bit of a status in the statusMask argument of MatchStatus()
+    static constexpr unsigned int StatusMaskBit(chStatus status) { return 1U << status; }
+
+    /**
+       Sets bit i of result (ceil(n / 64) words) if channels[i] has one of the
+       statuses in statusMask (see StatusMaskBit()), and clears it otherwise.
+       Returns whether all the channels have a row; bits of channels with no
+       row are cleared.  The loop has no data-dependent branch.
+    */
+    bool MatchStatus(const DBChannelID_t* channels,
+                     size_t n,
+                     unsigned int statusMask,
+                     std::uint64_t* result) const;
+
+  private:
+    std::vector<std::uint8_t> fPackedStatus;
+    std::array<ChannelList_t, kUNKNOWN + 1> fByStatus;
+    std::array<ChannelBits_t, kUNKNOWN + 1> fBitsByStatus;
+    ChannelList_t fBad;
+    ChannelBits_t fBadBits;
+  };
+
+} //end namespace lariov
+#endif
+/** @} */ // end of doxygen group
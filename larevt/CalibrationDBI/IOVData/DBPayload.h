@@ -0,0 +1,54 @@
+/**
+ * \file DBPayload.h
+ *
+ * \ingroup IOVData
+ *
+ * \brief Class def header for a class DBPayload
+ */
+
+/** \addtogroup IOVData
+
+    @{*/
+#ifndef IOVDATA_DBPAYLOAD_H
+#define IOVDATA_DBPAYLOAD_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace lariov {
+
+  /**
+     \struct DBPayload
+     Data of one database folder for one interval of validity, as a data
+     product: a job reading them needs no access to the conditions database.
+
+     The values of the table are stored row by row, each in the vector of its
+     kind (see Kind_t): the n-th value of a kind is in the n-th element of the
+     vector of that kind.
+  */
+  struct DBPayload {
+
+    enum Kind_t : std::uint8_t { kInteger = 0, kReal = 1, kText = 2 };
+
+    std::string folder;
+    std::string tag;
+
+    unsigned long beginStamp = 0; ///< IOV begin time, as IOVTimeStamp
+    unsigned long beginSubStamp = 0;
+    unsigned long endStamp = 0; ///< IOV end time, as IOVTimeStamp
+    unsigned long endSubStamp = 0;
+
+    std::vector<std::string> columnNames;
+    std::vector<std::string> columnTypes;
+    std::vector<std::uint32_t> channels;
+
+    std::vector<std::uint8_t> kinds; ///< Kind of each value (nrows x ncols)
+    std::vector<long long> integers;
+    std::vector<double> reals;
+    std::vector<std::string> texts;
+  };
+} //end namespace lariov
+
+#endif
+/** @} */ // end of doxygen group
@@ -0,0 +1,159 @@
+/**
+ * \file DenseSnapshot.h
+ *
+ * \ingroup Snapshot
+ *
+ * \brief Class def header for a class DenseSnapshot
+ */
+
+/** \addtogroup Snapshot
+
+    @{*/
+#ifndef IOVDATA_DENSESNAPSHOT_H
+#define IOVDATA_DENSESNAPSHOT_H
+
+#include "ChData.h"
+#include "IOVDataError.h"
+#include "IOVTimeStamp.h"
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace lariov {
+
+  /**
+     \class DenseSnapshot
+     Variant of Snapshot for dense channel spaces.  Rows are stored by value in
+     an array indexed by channel number, and a bitmap records which channels
+     are present, so that HasChannel() and GetRow() are O(1).
+
+     T must derive from ChData and be trivially copyable (no virtual methods,
+     no owning members).  Memory usage is proportional to the largest channel
+     number, not to the number of rows: do not use it for sparse channel IDs.
+  */
+  template <class T>
+  class DenseSnapshot {
+
+    static_assert(std::is_base_of<ChData, T>::value, "DenseSnapshot rows must derive from ChData");
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "DenseSnapshot rows must be trivially copyable");
+
+  public:
+    using value_type = T;
+
+    /// Default constructor
+    DenseSnapshot() : fStart(0, 0), fEnd(0, 0), fNChannels(0) {}
+
+    void Clear();
+
+    const IOVTimeStamp& Start() const { return fStart; }
+    const IOVTimeStamp& End() const { return fEnd; }
+    void SetIoV(const IOVTimeStamp& start, const IOVTimeStamp& end);
+
+    bool IsValid(const IOVTimeStamp& ts) const { return (ts >= fStart && ts < fEnd); }
+
+    /// Number of channels with a row
+    size_t NChannels() const { return fNChannels; }
+
+    /// One past the largest channel that may have a row
+    size_t ChannelLimit() const { return fData.size(); }
+
+    bool HasChannel(unsigned int ch) const
+    {
+      return ch < fData.size() && ((fPresent[ch >> 6] >> (ch & 63)) & 1);
+    }
+
+    const T& GetRow(unsigned int ch) const
+    {
+      if (!HasChannel(ch)) {
+        std::string msg("Channel not found: ");
+        msg += std::to_string(ch);
+        throw IOVDataError(msg);
+      }
+      return fData[ch];
+    }
+
+    void AddOrReplaceRow(const T& data);
+
+    /// Replaces all rows; rows must be sorted by channel, with no duplicates (see SnapshotBuilder)
+    void SetSortedRows(std::vector<T>&& rows);
+
+    /// Preallocates storage for channels up to (not including) nChannels
+    void Reserve(size_t nChannels)
+    {
+      fData.reserve(nChannels);
+      fPresent.reserve((nChannels + 63) >> 6);
+    }
+
+  private:
+    IOVTimeStamp fStart;
+    IOVTimeStamp fEnd;
+    std::vector<T> fData;               // Indexed by channel.
+    std::vector<std::uint64_t> fPresent; // One bit per channel.
+    size_t fNChannels;
+  };
+
+  //=============================================
+  // Class implementation
+  //=============================================
+  template <class T>
+  void DenseSnapshot<T>::Clear()
+  {
+    fData.clear();
+    fPresent.clear();
+    fNChannels = 0;
+    fStart = fEnd = IOVTimeStamp::MaxTimeStamp();
+    fStart.SetStamp(fStart.Stamp() - 1, fStart.SubStamp());
+  }
+
+  template <class T>
+  void DenseSnapshot<T>::SetIoV(const IOVTimeStamp& start, const IOVTimeStamp& end)
+  {
+    if (start >= end) {
+      throw IOVDataError("Called DenseSnapshot::SetIoV with start timestamp >= end timestamp!");
+    }
+
+    fStart = start;
+    fEnd = end;
+  }
+
+  template <class T>
+  void DenseSnapshot<T>::AddOrReplaceRow(const T& data)
+  {
+    unsigned int const ch = data.Channel();
+    if (ch >= fData.size()) {
+      // Absent channels are filled with a copy of this row; their bit stays off.
+      fData.resize(size_t(ch) + 1, data);
+      fPresent.resize((size_t(ch) >> 6) + 1, 0);
+    }
+
+    std::uint64_t const bit = std::uint64_t(1) << (ch & 63);
+    if (!(fPresent[ch >> 6] & bit)) {
+      fPresent[ch >> 6] |= bit;
+      ++fNChannels;
+    }
+    fData[ch] = data;
+  }
+
+  template <class T>
+  void DenseSnapshot<T>::SetSortedRows(std::vector<T>&& rows)
+  {
+    fData.clear();
+    fPresent.clear();
+    fNChannels = rows.size();
+    if (rows.empty()) return;
+
+    size_t const limit = size_t(rows.back().Channel()) + 1;
+    fData.assign(limit, rows.front());
+    fPresent.assign((limit + 63) >> 6, 0);
+    for (T const& row : rows) {
+      unsigned int const ch = row.Channel();
+      fData[ch] = row;
+      fPresent[ch >> 6] |= std::uint64_t(1) << (ch & 63);
+    }
+  }
+
+} //end namespace lariov
+#endif
+/** @} */ // end of doxygen group
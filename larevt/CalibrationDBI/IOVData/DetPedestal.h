@@ -27,7 +27,7 @@ namespace lariov {
     DetPedestal(unsigned int ch) : ChData(ch) {}
 
     /// Default destructor
-    ~DetPedestal() {}
+    ~DetPedestal() = default;
 
     float PedMean() const { return fPedMean; }
     float PedRms() const { return fPedRms; }
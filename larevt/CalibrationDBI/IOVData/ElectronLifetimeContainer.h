@@ -24,7 +24,7 @@ namespace lariov {
     ElectronLifetimeContainer(unsigned int ch) : ChData(ch) {}
 
     /// Default destructor
-    ~ElectronLifetimeContainer() {}
+    ~ElectronLifetimeContainer() = default;
 
     float ExpOffset() const { return fExpOffset; }
     float TimeConstant() const { return fTimeConstant; }
@@ -0,0 +1,67 @@
+#include "ElectronLifetimeSnapshot.h"
+#include "IOVDataError.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+namespace lariov {
+
+  void ElectronLifetimeSnapshot::BuildAttenuationTable(unsigned int ch,
+                                                       float maxDriftTime,
+                                                       unsigned int nSteps)
+  {
+    float const lifetime = GetRow(ch).TimeConstant();
+    if (!(lifetime > 0.f)) {
+      throw IOVDataError("ElectronLifetimeSnapshot: non-positive electron lifetime " +
+                         std::to_string(lifetime));
+    }
+    if (!(maxDriftTime > 0.f) || nSteps == 0) {
+      throw IOVDataError("ElectronLifetimeSnapshot: empty attenuation table requested");
+    }
+
+    fLifetime = lifetime;
+    fMaxDriftTime = maxDriftTime;
+    fStepsPerTime = nSteps / maxDriftTime;
+
+    // Computed in double precision, so that interpolation is the only approximation.
+    fValue.resize(nSteps + 1);
+    for (unsigned int i = 0; i <= nSteps; ++i)
+      fValue[i] = float(std::exp(-double(i) * maxDriftTime / nSteps / lifetime));
+    fSlope.resize(nSteps);
+    for (unsigned int i = 0; i < nSteps; ++i)
+      fSlope[i] = fValue[i + 1] - fValue[i];
+  }
+
+  // Two passes: an interpolation with no branch, which the compiler can vectorize, then
+  // the exact value for the (rare) drift times out of the table.
+
+  void ElectronLifetimeSnapshot::Attenuation(const float* driftTimes,
+                                             size_t n,
+                                             float* attenuation) const
+  {
+    if (fValue.empty()) {
+      throw IOVDataError("ElectronLifetimeSnapshot: attenuation table was not built");
+    }
+
+    const float* value = fValue.data();
+    const float* slope = fSlope.data();
+    float const stepsPerTime = fStepsPerTime;
+    float const lastStep = float(fSlope.size() - 1);
+    float const maxPosition = float(fSlope.size());
+    for (size_t i = 0; i < n; ++i) {
+      float const position = std::min(std::max(0.f, driftTimes[i] * stepsPerTime), maxPosition);
+      float const step = std::min(float(int(position)), lastStep);
+      int const k = int(step);
+      attenuation[i] = value[k] + (position - step) * slope[k];
+    }
+
+    float const maxDriftTime = fMaxDriftTime;
+    float const rate = 1.f / fLifetime;
+    for (size_t i = 0; i < n; ++i) {
+      float const t = driftTimes[i];
+      if (!(t >= 0.f && t <= maxDriftTime)) attenuation[i] = std::exp(-t * rate);
+    }
+  }
+
+} //end namespace lariov
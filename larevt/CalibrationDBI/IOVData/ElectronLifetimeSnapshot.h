@@ -0,0 +1,67 @@
+/**
+ * \file ElectronLifetimeSnapshot.h
+ *
+ * \ingroup Snapshot
+ *
+ * \brief Class def header for a class ElectronLifetimeSnapshot
+ */
+
+/** \addtogroup Snapshot
+
+    @{*/
+#ifndef IOVDATA_ELECTRONLIFETIMESNAPSHOT_H
+#define IOVDATA_ELECTRONLIFETIMESNAPSHOT_H
+
+#include "ElectronLifetimeContainer.h"
+#include "Snapshot.h"
+#include <cstddef>
+#include <vector>
+
+namespace lariov {
+
+  /**
+     \class ElectronLifetimeSnapshot
+     Electron lifetime of one interval of validity, with a table of the
+     attenuation of the drifting charge, exp(-t / lifetime), as a function of
+     the drift time t.
+
+     The lifetime is the TimeConstant() of one row of the snapshot.  The table
+     covers drift times from 0 to a maximum with equal steps, and is linearly
+     interpolated; drift times out of its range are computed exactly.  It is
+     filled by BuildAttenuationTable(), which must be called again after rows
+     are added or replaced.
+  */
+  class ElectronLifetimeSnapshot : public Snapshot<ElectronLifetimeContainer> {
+
+  public:
+    /// Fills the table from the row of channel ch, up to maxDriftTime in nSteps steps
+    void BuildAttenuationTable(unsigned int ch, float maxDriftTime, unsigned int nSteps);
+
+    /// Lifetime the table was built with
+    float Lifetime() const { return fLifetime; }
+
+    /// Largest drift time in the table
+    float MaxDriftTime() const { return fMaxDriftTime; }
+
+    /// Fraction of the charge left after drifting for driftTime
+    float Attenuation(float driftTime) const
+    {
+      float attenuation;
+      Attenuation(&driftTime, 1, &attenuation);
+      return attenuation;
+    }
+
+    /// Sets attenuation[i] to Attenuation(driftTimes[i]), for i < n
+    void Attenuation(const float* driftTimes, size_t n, float* attenuation) const;
+
+  private:
+    float fLifetime = 0.f;
+    float fMaxDriftTime = 0.f;
+    float fStepsPerTime = 0.f;
+    std::vector<float> fValue; // At the start of each step, and at the end of the last one.
+    std::vector<float> fSlope; // Change of the value over each step.
+  };
+
+} //end namespace lariov
+#endif
+/** @} */ // end of doxygen group
@@ -17,15 +17,19 @@
 #include "CalibrationExtraInfo.h"
 #include "ChData.h"
 
+#include <memory>
+
 namespace lariov {
   /**
      \class ElectronicsCalib
+     The extra information is shared: rows built with the same pointer (see
+     SetExtraInfo()) refer to a single CalibrationExtraInfo object.
   */
   class ElectronicsCalib : public ChData {
 
   public:
     /// Constructor
-    ElectronicsCalib(unsigned int ch) : ChData(ch), fExtraInfo("ElectronicsCalib") {}
+    ElectronicsCalib(unsigned int ch) : ChData(ch), fExtraInfo(EmptyExtraInfo()) {}
 
     /// Default destructor
     ~ElectronicsCalib() {}
@@ -34,20 +38,35 @@ namespace lariov {
     float GainErr() const { return fGainErr; }
     float ShapingTime() const { return fShapingTime; }
     float ShapingTimeErr() const { return fShapingTimeErr; }
-    CalibrationExtraInfo const& ExtraInfo() const { return fExtraInfo; }
+    CalibrationExtraInfo const& ExtraInfo() const { return *fExtraInfo; }
+    std::shared_ptr<CalibrationExtraInfo const> const& ExtraInfoPtr() const { return fExtraInfo; }
 
     void SetGain(float v) { fGain = v; }
     void SetGainErr(float v) { fGainErr = v; }
     void SetShapingTime(float v) { fShapingTime = v; }
     void SetShapingTimeErr(float v) { fShapingTimeErr = v; }
-    void SetExtraInfo(CalibrationExtraInfo const& info) { fExtraInfo = info; }
+    void SetExtraInfo(CalibrationExtraInfo const& info)
+    {
+      fExtraInfo = std::make_shared<CalibrationExtraInfo const>(info);
+    }
+    void SetExtraInfo(std::shared_ptr<CalibrationExtraInfo const> info)
+    {
+      fExtraInfo = std::move(info);
+    }
+
+    /// Returns the extra information with no data, shared by default by all rows
+    static std::shared_ptr<CalibrationExtraInfo const> const& EmptyExtraInfo()
+    {
+      static auto const empty = std::make_shared<CalibrationExtraInfo const>("ElectronicsCalib");
+      return empty;
+    }
 
   private:
     float fGain;
     float fGainErr;
     float fShapingTime;
     float fShapingTimeErr;
-    CalibrationExtraInfo fExtraInfo;
+    std::shared_ptr<CalibrationExtraInfo const> fExtraInfo;
 
   }; // end class
 } // end namespace lariov
@@ -17,31 +17,50 @@
 #include "CalibrationExtraInfo.h"
 #include "ChData.h"
 
+#include <memory>
+
 namespace lariov {
   /**
      \class PmtGain
+     The extra information is shared: rows built with the same pointer (see
+     SetExtraInfo()) refer to a single CalibrationExtraInfo object.
   */
   class PmtGain : public ChData {
 
   public:
     /// Constructor
-    PmtGain(unsigned int ch) : ChData(ch), fExtraInfo("PmtGain") {}
+    PmtGain(unsigned int ch) : ChData(ch), fExtraInfo(EmptyExtraInfo()) {}
 
     /// Default destructor
     ~PmtGain() {}
 
     float Gain() const { return fGain; }
     float GainErr() const { return fGainErr; }
-    CalibrationExtraInfo const& ExtraInfo() const { return fExtraInfo; }
+    CalibrationExtraInfo const& ExtraInfo() const { return *fExtraInfo; }
+    std::shared_ptr<CalibrationExtraInfo const> const& ExtraInfoPtr() const { return fExtraInfo; }
 
     void SetGain(float v) { fGain = v; }
     void SetGainErr(float v) { fGainErr = v; }
-    void SetExtraInfo(CalibrationExtraInfo const& info) { fExtraInfo = info; }
+    void SetExtraInfo(CalibrationExtraInfo const& info)
+    {
+      fExtraInfo = std::make_shared<CalibrationExtraInfo const>(info);
+    }
+    void SetExtraInfo(std::shared_ptr<CalibrationExtraInfo const> info)
+    {
+      fExtraInfo = std::move(info);
+    }
+
+    /// Returns the extra information with no data, shared by default by all rows
+    static std::shared_ptr<CalibrationExtraInfo const> const& EmptyExtraInfo()
+    {
+      static auto const empty = std::make_shared<CalibrationExtraInfo const>("PmtGain");
+      return empty;
+    }
 
   private:
     float fGain;
     float fGainErr;
-    CalibrationExtraInfo fExtraInfo;
+    std::shared_ptr<CalibrationExtraInfo const> fExtraInfo;
 
   }; // end class
 } // end namespace lariov
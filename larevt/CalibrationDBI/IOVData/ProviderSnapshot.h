@@ -0,0 +1,133 @@
+/**
+ * \file ProviderSnapshot.h
+ *
+ * \ingroup Snapshot
+ *
+ * \brief Class def header for a class ProviderSnapshot
+ */
+
+/** \addtogroup Snapshot
+
+    @{*/
+#ifndef IOVDATA_PROVIDERSNAPSHOT_H
+#define IOVDATA_PROVIDERSNAPSHOT_H
+
+#include "DenseSnapshot.h"
+#include "IOVTimeStamp.h"
+#include "Snapshot.h"
+#include "UniformSnapshot.h"
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace lariov {
+
+  /**
+     \class ProviderSnapshot
+     Data of a provider for one interval of validity: either one row per
+     channel, in a snapshot of type S (Snapshot or DenseSnapshot), or a few
+     values shared by all the channels, in a UniformSnapshot.
+
+     Uniform data are kept as they are, so that they take constant memory
+     whatever the number of channels.  GetRow() returns the row by value,
+     with Channel() set to the requested channel in both cases.
+  */
+  template <class S>
+  class ProviderSnapshot {
+
+  public:
+    using rows_type = S;
+    using value_type = typename S::value_type;
+    using uniform_type = UniformSnapshot<value_type>;
+
+    /// Snapshot of the rows of rows
+    explicit ProviderSnapshot(S rows) : fRows(std::move(rows)) {}
+
+    /// Snapshot of uniform data
+    explicit ProviderSnapshot(std::shared_ptr<uniform_type const> uniform)
+      : fUniform(std::move(uniform))
+    {}
+
+    const IOVTimeStamp& Start() const { return fUniform ? fUniform->Start() : fRows.Start(); }
+    const IOVTimeStamp& End() const { return fUniform ? fUniform->End() : fRows.End(); }
+
+    bool IsValid(const IOVTimeStamp& ts) const { return (ts >= Start() && ts < End()); }
+
+    /// Number of channels with data
+    size_t NChannels() const { return fUniform ? fUniform->NChannels() : fRows.NChannels(); }
+
+    /// One past the largest channel with data
+    size_t ChannelLimit() const { return fUniform ? fUniform->ChannelLimit() : Limit(fRows); }
+
+    bool HasChannel(unsigned int ch) const
+    {
+      return fUniform ? fUniform->HasChannel(ch) : fRows.HasChannel(ch);
+    }
+
+    /// Returns the row of channel ch; throws IOVDataError if there is none
+    value_type GetRow(unsigned int ch) const
+    {
+      return fUniform ? fUniform->GetRow(ch) : fRows.GetRow(ch);
+    }
+
+    /// Calls f(row) for the row of each channel, by increasing channel number
+    template <class F>
+    void ForEachRow(F&& f) const;
+
+    bool IsUniform() const { return fUniform != nullptr; }
+
+    /// The rows; empty if IsUniform()
+    const S& Rows() const { return fRows; }
+
+    /// The uniform data, or nullptr
+    const uniform_type* Uniform() const { return fUniform.get(); }
+
+  private:
+    template <class T>
+    static size_t Limit(const DenseSnapshot<T>& rows)
+    {
+      return rows.ChannelLimit();
+    }
+
+    template <class T>
+    static size_t Limit(const Snapshot<T>& rows)
+    {
+      return rows.Data().empty() ? 0 : size_t(rows.Data().back().Channel()) + 1;
+    }
+
+    template <class T, class F>
+    static void Visit(const DenseSnapshot<T>& rows, F& f)
+    {
+      for (unsigned int ch = 0; ch != rows.ChannelLimit(); ++ch)
+        if (rows.HasChannel(ch)) f(rows.GetRow(ch));
+    }
+
+    template <class T, class F>
+    static void Visit(const Snapshot<T>& rows, F& f)
+    {
+      for (auto const& row : rows.Data())
+        f(row);
+    }
+
+    S fRows;
+    std::shared_ptr<uniform_type const> fUniform;
+  };
+
+  //=============================================
+  // Class implementation
+  //=============================================
+  template <class S>
+  template <class F>
+  void ProviderSnapshot<S>::ForEachRow(F&& f) const
+  {
+    if (!fUniform) {
+      Visit(fRows, f);
+      return;
+    }
+    for (unsigned int ch = 0; ch != fUniform->ChannelLimit(); ++ch)
+      if (fUniform->HasChannel(ch)) f(fUniform->GetRow(ch));
+  }
+
+} //end namespace lariov
+#endif
+/** @} */ // end of doxygen group
@@ -31,6 +31,8 @@ namespace lariov {
   class Snapshot {
 
   public:
+    using value_type = T;
+
     /// Default constructor
     Snapshot() : fStart(0, 0), fEnd(0, 0) {}
 
@@ -93,6 +95,9 @@ namespace lariov {
       }
     }
 
+    /// Replaces all rows; rows must be sorted by channel, with no duplicates (see SnapshotBuilder)
+    void SetSortedRows(std::vector<T>&& rows) { fData = std::move(rows); }
+
   private:
     IOVTimeStamp fStart;
     IOVTimeStamp fEnd;
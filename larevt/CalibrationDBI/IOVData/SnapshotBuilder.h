@@ -0,0 +1,93 @@
+/**
+ * \file SnapshotBuilder.h
+ *
+ * \ingroup Snapshot
+ *
+ * \brief Class def header for a class SnapshotBuilder
+ */
+
+/** \addtogroup Snapshot
+
+    @{*/
+#ifndef IOVDATA_SNAPSHOTBUILDER_H
+#define IOVDATA_SNAPSHOTBUILDER_H
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace lariov {
+
+  /**
+     \class SnapshotBuilder
+     Collects the rows of a snapshot and hands them over in a single step.
+
+     Rows may be added in any order.  Fill() sorts them once by channel
+     (stable, so the input order of rows with the same channel is kept),
+     removes duplicated channels keeping the last row added, and moves the
+     result into the snapshot.  This replaces a sequence of
+     Snapshot::AddOrReplaceRow() calls, each of which costs a binary search
+     and, for out of order input, a full sort.
+
+     The snapshot type S must define `value_type` and provide
+     `void SetSortedRows(std::vector<value_type>&&)`.
+  */
+  template <class S>
+  class SnapshotBuilder {
+
+  public:
+    using snapshot_type = S;
+    using value_type = typename S::value_type;
+
+    /// Constructor; expectedRows is a hint used to preallocate storage
+    explicit SnapshotBuilder(std::size_t expectedRows = 0) { fRows.reserve(expectedRows); }
+
+    void Reserve(std::size_t nRows) { fRows.reserve(nRows); }
+
+    std::size_t Size() const { return fRows.size(); }
+
+    void Add(const value_type& row) { fRows.push_back(row); }
+    void Add(value_type&& row) { fRows.push_back(std::move(row)); }
+
+    /// Moves the collected rows into snapshot, replacing its content; the builder is left empty
+    void Fill(S& snapshot);
+
+  private:
+    std::vector<value_type> fRows;
+  };
+
+  //=============================================
+  // Class implementation
+  //=============================================
+  template <class S>
+  void SnapshotBuilder<S>::Fill(S& snapshot)
+  {
+    auto const byChannel = [](value_type const& a, value_type const& b) {
+      return a.Channel() < b.Channel();
+    };
+
+    // Database and file inputs are usually already ordered.
+    if (!std::is_sorted(fRows.begin(), fRows.end(), byChannel))
+      std::stable_sort(fRows.begin(), fRows.end(), byChannel);
+
+    // Collapse runs of the same channel onto their last row.
+    auto out = fRows.begin();
+    for (auto it = fRows.begin(); it != fRows.end(); ++it) {
+      if (out != fRows.begin() && std::prev(out)->Channel() == it->Channel())
+        *std::prev(out) = std::move(*it);
+      else {
+        if (out != it) *out = std::move(*it);
+        ++out;
+      }
+    }
+    fRows.erase(out, fRows.end());
+
+    snapshot.SetSortedRows(std::move(fRows));
+    fRows.clear();
+  }
+
+} //end namespace lariov
+#endif
+/** @} */ // end of doxygen group
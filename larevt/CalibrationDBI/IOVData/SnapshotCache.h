@@ -0,0 +1,218 @@
+/**
+ * \file SnapshotCache.h
+ *
+ * \ingroup IOVData
+ *
+ * \brief Class def header for a class SnapshotCache
+ */
+
+/** \addtogroup IOVData
+
+    @{*/
+#ifndef IOVDATA_SNAPSHOTCACHE_H
+#define IOVDATA_SNAPSHOTCACHE_H
+
+#include "IOVTimeStamp.h"
+#include "TimeStampDecoder.h"
+#include "larevt/CalibrationDBI/Interface/CalibrationDBIFwd.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace lariov {
+
+  /**
+     \class SnapshotCache
+     Cache of immutable, reference-counted snapshots keyed by their interval of
+     validity.
+
+     Lookups take no lock: the entries are an immutable table, replaced as a
+     whole by each insertion and published through an atomic pointer.  A
+     lookup compares the raw time stamp with the bounds of each snapshot,
+     computed once when the snapshot is added (see
+     TimeStampDecoder::FirstTimeStampFrom()), so that a lookup finding its
+     snapshot neither decodes the time stamp nor allocates memory.  Replaced
+     tables are freed by a later insertion once no lookup is running.
+
+     Only the construction of a missing snapshot is serialized, so that
+     concurrent events with different time stamps each resolve the snapshot
+     valid at their own time, and a snapshot handed out stays alive for as
+     long as the caller holds on to it.
+
+     The snapshot type S must provide `const IOVTimeStamp& Start() const` and
+     `const IOVTimeStamp& End() const`; it is valid from Start() included to
+     End() excluded.
+  */
+  template <class S>
+  class SnapshotCache {
+
+  public:
+    using snapshot_type = S;
+    using const_pointer = std::shared_ptr<S const>;
+
+    /// Default number of snapshots kept alive by the cache
+    static constexpr std::size_t kDEFAULT_MAX_ENTRIES = 4;
+
+    /// Constructor
+    explicit SnapshotCache(std::size_t maxEntries = kDEFAULT_MAX_ENTRIES)
+      : fMaxEntries(std::max<std::size_t>(maxEntries, 1))
+    {}
+
+    SnapshotCache(SnapshotCache const&) = delete;
+    SnapshotCache& operator=(SnapshotCache const&) = delete;
+
+    ~SnapshotCache() { delete fTable.load(); }
+
+    /// Returns the cached snapshot valid at ts, or nullptr if there is none
+    const_pointer Find(DBTimeStamp_t ts) const;
+
+    /**
+       Returns the snapshot valid at ts.  If no cached snapshot covers ts,
+       `build(ts)` is called to produce one; only one builder runs at a time.
+    */
+    template <class Builder>
+    const_pointer FindOrBuild(DBTimeStamp_t ts, Builder&& build);
+
+    /// Adds a snapshot to the cache, evicting the oldest one if the cache is full
+    void Insert(const_pointer snapshot);
+
+    /// Drops all cached snapshots (snapshots still held by callers stay alive)
+    void Clear();
+
+    std::size_t Size() const
+    {
+      ReadGuard guard(fReaders);
+      Table const* table = fTable.load();
+      return table ? table->size() : 0;
+    }
+
+  private:
+    /// A snapshot and the raw time stamps it is valid for
+    struct Entry {
+      DBTimeStamp_t begin; // First time stamp in the interval of validity.
+      DBTimeStamp_t end;   // First time stamp after it.
+      const_pointer snapshot;
+
+      bool Covers(DBTimeStamp_t ts) const { return ts >= begin && ts < end; }
+    };
+
+    using Table = std::vector<Entry>; // Most recently added first.
+
+    /// Counts a running lookup for its lifetime
+    class ReadGuard {
+    public:
+      explicit ReadGuard(std::atomic<unsigned int>& readers) : fCount(readers) { ++fCount; }
+      ~ReadGuard() { --fCount; }
+
+    private:
+      std::atomic<unsigned int>& fCount;
+    };
+
+    /// Makes a new table with snapshot in front; called with fBuildMutex held
+    void Add(const_pointer snapshot);
+
+    /// Replaces the table; called with fBuildMutex held
+    void Publish(Table* table);
+
+    std::atomic<Table const*> fTable{nullptr};
+    mutable std::atomic<unsigned int> fReaders{0};     // Lookups running.
+    mutable std::atomic<std::size_t> fLast{0};         // Entry found by the latest lookup.
+    std::vector<std::unique_ptr<Table const>> fRetired; // Replaced, maybe still read.
+    std::mutex fBuildMutex; // Serializes snapshot construction and table updates.
+    std::size_t fMaxEntries;
+  };
+
+  //=============================================
+  // Class implementation
+  //=============================================
+
+  // The reader count is raised before the table is loaded, and Publish() swaps the table
+  // before reading the count (all sequentially consistent): when Publish() sees no
+  // reader, none can still be using a replaced table.
+
+  template <class S>
+  typename SnapshotCache<S>::const_pointer SnapshotCache<S>::Find(DBTimeStamp_t ts) const
+  {
+    ReadGuard guard(fReaders);
+    Table const* table = fTable.load();
+    if (!table) return nullptr;
+
+    // The common case: same interval as the previous lookup.
+    std::size_t const last = fLast.load(std::memory_order_relaxed);
+    if (last < table->size() && (*table)[last].Covers(ts)) return (*table)[last].snapshot;
+
+    for (std::size_t i = 0; i != table->size(); ++i) {
+      if ((*table)[i].Covers(ts)) {
+        fLast.store(i, std::memory_order_relaxed);
+        return (*table)[i].snapshot;
+      }
+    }
+    return nullptr;
+  }
+
+  template <class S>
+  template <class Builder>
+  typename SnapshotCache<S>::const_pointer SnapshotCache<S>::FindOrBuild(DBTimeStamp_t ts,
+                                                                         Builder&& build)
+  {
+    if (auto snapshot = Find(ts)) return snapshot;
+
+    std::lock_guard<std::mutex> lock(fBuildMutex);
+
+    // Another thread may have built it while we were waiting.
+    if (auto snapshot = Find(ts)) return snapshot;
+
+    const_pointer snapshot = build(ts);
+    Add(snapshot);
+    return snapshot;
+  }
+
+  template <class S>
+  void SnapshotCache<S>::Insert(const_pointer snapshot)
+  {
+    std::lock_guard<std::mutex> lock(fBuildMutex);
+    Add(std::move(snapshot));
+  }
+
+  template <class S>
+  void SnapshotCache<S>::Clear()
+  {
+    std::lock_guard<std::mutex> lock(fBuildMutex);
+    Publish(nullptr);
+  }
+
+  // The bounds are computed once, here.  The evicted snapshot is released with the
+  // table that holds it, once no lookup can be reading that table.
+
+  template <class S>
+  void SnapshotCache<S>::Add(const_pointer snapshot)
+  {
+    auto table = std::make_unique<Table>();
+    table->reserve(fMaxEntries);
+    table->push_back({TimeStampDecoder::FirstTimeStampFrom(snapshot->Start()),
+                      TimeStampDecoder::FirstTimeStampFrom(snapshot->End()),
+                      std::move(snapshot)});
+    if (Table const* current = fTable.load()) {
+      for (std::size_t i = 0; i != current->size() && table->size() != fMaxEntries; ++i)
+        table->push_back((*current)[i]);
+    }
+    Publish(table.release());
+  }
+
+  template <class S>
+  void SnapshotCache<S>::Publish(Table* table)
+  {
+    Table const* old = fTable.exchange(table);
+    fLast.store(0, std::memory_order_relaxed);
+    if (old) fRetired.emplace_back(old);
+    if (fReaders.load() == 0) fRetired.clear();
+  }
+
+} //end namespace lariov
+#endif
+/** @} */ // end of doxygen group
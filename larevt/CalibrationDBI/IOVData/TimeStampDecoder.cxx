@@ -1,6 +1,8 @@
 #include "TimeStampDecoder.h"
 #include "IOVDataConstants.h"
 #include "IOVDataError.h"
+#include <algorithm>
+#include <limits>
 #include <string>
 
 namespace lariov {
@@ -33,4 +35,21 @@ namespace lariov {
       throw IOVDataError(msg);
     }
   }
+
+  // The inverse of the decoding above, which is monotonic: short time stamps all come
+  // before nanoseconds from epoch.
+  DBTimeStamp_t TimeStampDecoder::FirstTimeStampFrom(const IOVTimeStamp& ts)
+  {
+    DBTimeStamp_t const maxShort = 99999; // Fewer digits than kMAX_SUBSTAMP_LENGTH.
+    if (ts.Stamp() < maxShort || (ts.Stamp() == maxShort && ts.SubStamp() == 0)) {
+      DBTimeStamp_t const stamp = ts.Stamp() + (ts.SubStamp() > 0 ? 1 : 0);
+      return std::max<DBTimeStamp_t>(stamp, 1);
+    }
+
+    DBTimeStamp_t const firstNs = 1000000000000000000ULL; // The first 19-digit value.
+    DBTimeStamp_t const nsPerSecond = 1000000000ULL;
+    DBTimeStamp_t const nsPerSubStamp = nsPerSecond / (kMAX_SUBSTAMP_VALUE + 1);
+    if (ts.Stamp() >= 10 * nsPerSecond) return std::numeric_limits<DBTimeStamp_t>::max();
+    return std::max(firstNs, ts.Stamp() * nsPerSecond + ts.SubStamp() * nsPerSubStamp);
+  }
 } //end namespace lariov
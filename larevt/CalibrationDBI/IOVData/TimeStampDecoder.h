@@ -13,6 +13,10 @@ namespace lariov {
     virtual ~TimeStampDecoder();
 
     static IOVTimeStamp DecodeTimeStamp(DBTimeStamp_t ts);
+
+    /// Returns the smallest time stamp that DecodeTimeStamp() maps to ts or later,
+    /// or the largest DBTimeStamp_t value if there is none
+    static DBTimeStamp_t FirstTimeStampFrom(const IOVTimeStamp& ts);
   };
 }
 
@@ -0,0 +1,156 @@
+/**
+ * \file UniformSnapshot.h
+ *
+ * \ingroup Snapshot
+ *
+ * \brief Class def header for a class UniformSnapshot
+ */
+
+/** \addtogroup Snapshot
+
+    @{*/
+#ifndef IOVDATA_UNIFORMSNAPSHOT_H
+#define IOVDATA_UNIFORMSNAPSHOT_H
+
+#include "IOVDataError.h"
+#include "IOVTimeStamp.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace lariov {
+
+  /**
+     \class UniformSnapshot
+     Snapshot for data taking only a few distinct values, such as the default
+     calibrations, which depend at most on the signal type of the channel.
+
+     A handful of records are stored once.  Channels are resolved either to
+     the first record, for all channels below ChannelLimit() (see
+     SetAllChannels()), or through a table holding one byte per channel (see
+     SetChannelRecord()).
+
+     GetRow() returns a copy of the record, with Channel() set to the
+     requested channel.
+  */
+  template <class T>
+  class UniformSnapshot {
+
+  public:
+    using value_type = T;
+
+    /// Record index of channels with no data in the channel table
+    static constexpr std::uint8_t kNoRecord = 0xFF;
+
+    /// Default constructor
+    UniformSnapshot() : fStart(0, 0), fEnd(0, 0), fChannelLimit(0), fNChannels(0) {}
+
+    void Clear();
+
+    const IOVTimeStamp& Start() const { return fStart; }
+    const IOVTimeStamp& End() const { return fEnd; }
+    void SetIoV(const IOVTimeStamp& start, const IOVTimeStamp& end);
+
+    bool IsValid(const IOVTimeStamp& ts) const { return (ts >= fStart && ts < fEnd); }
+
+    size_t NChannels() const { return fNChannels; }
+    size_t ChannelLimit() const { return fChannelLimit; }
+
+    /// Adds a record and returns its index
+    std::uint8_t AddRecord(const T& record);
+
+    /// All channels below channelLimit use the first record; drops the channel table
+    void SetAllChannels(size_t channelLimit);
+
+    /// Channel ch uses the record with index record
+    void SetChannelRecord(unsigned int ch, std::uint8_t record);
+
+    bool HasChannel(unsigned int ch) const
+    {
+      return ch < fChannelLimit && (fRecordIndex.empty() || fRecordIndex[ch] != kNoRecord);
+    }
+
+    T GetRow(unsigned int ch) const
+    {
+      if (!HasChannel(ch)) {
+        std::string msg("Channel not found: ");
+        msg += std::to_string(ch);
+        throw IOVDataError(msg);
+      }
+      T row = fRecords[fRecordIndex.empty() ? 0 : fRecordIndex[ch]];
+      row.SetChannel(ch);
+      return row;
+    }
+
+  private:
+    IOVTimeStamp fStart;
+    IOVTimeStamp fEnd;
+    std::vector<T> fRecords;
+    std::vector<std::uint8_t> fRecordIndex; // Indexed by channel; empty if all use record 0.
+    size_t fChannelLimit;
+    size_t fNChannels;
+  };
+
+  //=============================================
+  // Class implementation
+  //=============================================
+  template <class T>
+  void UniformSnapshot<T>::Clear()
+  {
+    fRecords.clear();
+    fRecordIndex.clear();
+    fChannelLimit = fNChannels = 0;
+    fStart = fEnd = IOVTimeStamp::MaxTimeStamp();
+    fStart.SetStamp(fStart.Stamp() - 1, fStart.SubStamp());
+  }
+
+  template <class T>
+  void UniformSnapshot<T>::SetIoV(const IOVTimeStamp& start, const IOVTimeStamp& end)
+  {
+    if (start >= end) {
+      throw IOVDataError("Called UniformSnapshot::SetIoV with start timestamp >= end timestamp!");
+    }
+
+    fStart = start;
+    fEnd = end;
+  }
+
+  template <class T>
+  std::uint8_t UniformSnapshot<T>::AddRecord(const T& record)
+  {
+    if (fRecords.size() >= kNoRecord) {
+      throw IOVDataError("Called UniformSnapshot::AddRecord with too many records!");
+    }
+    fRecords.push_back(record);
+    return std::uint8_t(fRecords.size() - 1);
+  }
+
+  template <class T>
+  void UniformSnapshot<T>::SetAllChannels(size_t channelLimit)
+  {
+    if (fRecords.empty()) {
+      throw IOVDataError("Called UniformSnapshot::SetAllChannels with no record!");
+    }
+    fRecordIndex.clear();
+    fChannelLimit = fNChannels = channelLimit;
+  }
+
+  template <class T>
+  void UniformSnapshot<T>::SetChannelRecord(unsigned int ch, std::uint8_t record)
+  {
+    if (record >= fRecords.size()) {
+      throw IOVDataError("Called UniformSnapshot::SetChannelRecord with unknown record!");
+    }
+    if (fRecordIndex.empty()) {
+      // Switching from (or starting with) the uniform layout.
+      fRecordIndex.assign(fChannelLimit, 0);
+    }
+    if (ch >= fRecordIndex.size()) fRecordIndex.resize(size_t(ch) + 1, kNoRecord);
+    if (fRecordIndex[ch] == kNoRecord) ++fNChannels;
+    fRecordIndex[ch] = record;
+    fChannelLimit = fRecordIndex.size();
+  }
+
+} //end namespace lariov
+#endif
+/** @} */ // end of doxygen group
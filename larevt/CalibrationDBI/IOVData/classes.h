@@ -0,0 +1,4 @@
+#include "canvas/Persistency/Common/Wrapper.h"
+#include "larevt/CalibrationDBI/IOVData/DBPayload.h"
+
+#include <vector>
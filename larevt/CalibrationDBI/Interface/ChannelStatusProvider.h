@@ -16,12 +16,17 @@
 #define CHANNELSTATUSPROVIDER_H 1
 
 // C/C++ standard libraries
+#include <algorithm> // std::min()
+#include <cstddef>
+#include <cstdint>
 #include <limits> // std::numeric_limits<>
 #include <set>
+#include <stdexcept> // std::logic_error
 
 // LArSoft libraries
 #include "larcorealg/CoreUtils/UncopiableAndUnmovableClass.h"
 #include "larcoreobj/SimpleTypesAndConstants/RawTypes.h" // raw::ChannelID_t
+#include "larevt/CalibrationDBI/Interface/ChannelStatusViews.h"
 
 /// Filters for channels, events, etc
 namespace lariov {
@@ -52,6 +57,18 @@ namespace lariov {
     /// Type of set of channel IDs
     using ChannelSet_t = std::set<raw::ChannelID_t>;
 
+    /// Type of sorted list of channel IDs, viewed without copy
+    using ChannelSpan_t = ChannelIDSpan;
+
+    /// Type of mask of channel IDs, viewed without copy
+    using ChannelMask_t = ChannelBitMask;
+
+    /// Type of set of channel IDs as ranges, viewed without copy
+    using ChannelRanges_t = ChannelRangeSet;
+
+    /// Type of the words of the result masks of the batch queries
+    using ResultWord_t = std::uint64_t;
+
     /// Value or invalid status
     static constexpr Status_t InvalidStatus = std::numeric_limits<Status_t>::max();
 
@@ -100,6 +117,102 @@ namespace lariov {
     /// Returns a copy of set of noisy channel IDs for the current run
     virtual ChannelSet_t NoisyChannels() const = 0;
 
+    /// @name Bulk channel queries
+    /// Views of the channel lists for the current run, avoiding the copy of
+    /// the set queries above.  The default implementations are built from the
+    /// set queries, and providers should override them.
+    /// @{
+    /// Returns the sorted list of good channel IDs for the current run
+    virtual ChannelSpan_t GoodChannelSpan() const { return ToSpan(GoodChannels()); }
+
+    /// Returns the sorted list of bad channel IDs for the current run
+    virtual ChannelSpan_t BadChannelSpan() const { return ToSpan(BadChannels()); }
+
+    /// Returns the sorted list of noisy channel IDs for the current run
+    virtual ChannelSpan_t NoisyChannelSpan() const { return ToSpan(NoisyChannels()); }
+
+    /// Returns the good channel IDs for the current run, as ranges
+    virtual ChannelRanges_t GoodChannelRanges() const
+    {
+      auto const channels = GoodChannelSpan();
+      return ChannelRanges_t::FromChannels(channels.begin(), channels.end());
+    }
+
+    /**
+     * @brief Returns the sorted list of channels with the specified Status()
+     * @throw std::logic_error if the provider does not support this query
+     *
+     * Status() values have a meaning specific to each provider, so that there
+     * is no default implementation: providers supporting statuses override it.
+     */
+    virtual ChannelSpan_t ChannelsWithStatus(Status_t status) const
+    {
+      throw std::logic_error("ChannelsWithStatus() is not implemented by this provider");
+    }
+
+    /// Returns the mask of good channels for the current run
+    virtual ChannelMask_t GoodChannelMask() const { return ToMask(GoodChannelSpan()); }
+
+    /// Returns the mask of bad channels for the current run
+    virtual ChannelMask_t BadChannelMask() const { return ToMask(BadChannelSpan()); }
+
+    /// Returns the mask of noisy channels for the current run
+    virtual ChannelMask_t NoisyChannelMask() const { return ToMask(NoisyChannelSpan()); }
+    /// @}
+
+    /// @name Batch channel queries
+    /// Answer a single channel query for each of the n channels starting at
+    /// channels, in any order, writing bit i of result (bit i % 64 of word
+    /// i / 64) for channel number i; result must hold ResultWords(n) words,
+    /// and the bits past n in its last word are cleared.  The default
+    /// implementations call the single channel queries, and providers should
+    /// override them.
+    ///
+    /// A channel the provider has no status for gets a cleared bit in all the
+    /// batch queries, where the single channel queries may throw instead: a
+    /// cleared AreBad() bit is not a proof that the channel is known and
+    /// usable.  Code that must fail on such channels keeps calling IsBad().
+    /// @{
+    /// Sets the bits of the channels physical and connected to wire
+    virtual void ArePresent(raw::ChannelID_t const* channels,
+                            std::size_t n,
+                            ResultWord_t* result) const
+    {
+      FillResult(channels, n, result, [this](raw::ChannelID_t ch) { return IsPresent(ch); });
+    }
+
+    /// Sets the bits of the channels bad in the current run
+    virtual void AreBad(raw::ChannelID_t const* channels, std::size_t n, ResultWord_t* result) const
+    {
+      FillResult(channels, n, result, [this](raw::ChannelID_t ch) { return IsBad(ch); });
+    }
+
+    /// Sets the bits of the channels noisy in the current run
+    virtual void AreNoisy(raw::ChannelID_t const* channels,
+                          std::size_t n,
+                          ResultWord_t* result) const
+    {
+      FillResult(channels, n, result, [this](raw::ChannelID_t ch) { return IsNoisy(ch); });
+    }
+
+    /// Sets the bits of the channels physical and good
+    virtual void AreGood(raw::ChannelID_t const* channels,
+                         std::size_t n,
+                         ResultWord_t* result) const
+    {
+      FillResult(channels, n, result, [this](raw::ChannelID_t ch) { return IsGood(ch); });
+    }
+    /// @}
+
+    /// Number of words of the result of a batch query on n channels
+    static constexpr std::size_t ResultWords(std::size_t n) { return (n + 63) / 64; }
+
+    /// Returns bit i of the result of a batch query
+    static bool ResultBit(ResultWord_t const* result, std::size_t i)
+    {
+      return (result[i / 64] >> (i % 64)) & 1;
+    }
+
     /* TODO DELME
       /// Prepares the object to provide information about the specified time
       /// @return whether information is available for the specified time
@@ -109,6 +222,43 @@ namespace lariov {
     /// Returns whether the specified status is a valid one
     static bool IsValidStatus(Status_t status) { return status != InvalidStatus; }
 
+  protected:
+    /// Returns a span owning a copy of the channels
+    static ChannelSpan_t ToSpan(ChannelSet_t const& channels)
+    {
+      return ChannelSpan_t::Copy(channels.begin(), channels.end());
+    }
+
+    /// Returns a mask owning its bits, covering up to the last of the channels
+    static ChannelMask_t ToMask(ChannelSpan_t const& channels)
+    {
+      return ChannelMask_t::FromChannels(
+        channels.begin(), channels.end(), channels.empty() ? 0 : channels.end()[-1] + 1);
+    }
+
+    /// Writes the result of a batch query, evaluating pred on each channel
+    template <typename Pred>
+    static void FillResult(raw::ChannelID_t const* channels,
+                           std::size_t n,
+                           ResultWord_t* result,
+                           Pred pred)
+    {
+      for (std::size_t w = 0; w != ResultWords(n); ++w) {
+        std::size_t const first = w * 64;
+        std::size_t const last = std::min(n, first + 64);
+        ResultWord_t word = 0;
+        for (std::size_t i = first; i != last; ++i)
+          word |= ResultWord_t(pred(channels[i])) << (i - first);
+        result[w] = word;
+      }
+    }
+
+    /// Returns a set with the channels
+    static ChannelSet_t ToSet(ChannelSpan_t const& channels)
+    {
+      return ChannelSet_t(channels.begin(), channels.end());
+    }
+
   }; // class ChannelStatusProvider
 
 } // namespace lariov
@@ -0,0 +1,330 @@
+/**
+ * @file   ChannelStatusViews.h
+ * @brief  Non-owning views over channel lists, for ChannelStatusProvider
+ * @see    ChannelStatusProvider.h
+ *
+ * The views returned by the bulk queries of ChannelStatusProvider do not copy
+ * the channel lists of the provider.  A view may hold a shared reference to
+ * the data it looks at (for example, to the calibration snapshot it comes
+ * from), so that it stays valid even after the provider moves to a different
+ * interval of validity; views from providers with fixed data just point to it.
+ *
+ * Channel lists come as a sorted list (ChannelIDSpan), a bit mask indexed by
+ * channel ID (ChannelBitMask), or a list of ranges (ChannelRangeSet), whose
+ * size is proportional to the number of gaps rather than of channels.
+ */
+
+#ifndef CHANNELSTATUSVIEWS_H
+#define CHANNELSTATUSVIEWS_H 1
+
+// LArSoft libraries
+#include "larcoreobj/SimpleTypesAndConstants/RawTypes.h" // raw::ChannelID_t
+
+// C/C++ standard libraries
+#include <algorithm>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace lariov {
+
+  /// Sorted sequence of channel IDs, not owning its storage
+  class ChannelIDSpan {
+  public:
+    using value_type = raw::ChannelID_t;
+    using const_iterator = value_type const*;
+    using iterator = const_iterator;
+
+    /// An empty span
+    ChannelIDSpan() = default;
+
+    /// Span on [first, last); owner (if any) keeps the storage alive
+    ChannelIDSpan(const_iterator first, const_iterator last, std::shared_ptr<void const> owner = {})
+      : fBegin(first), fEnd(last), fOwner(std::move(owner))
+    {}
+
+    /// Returns a span owning the sorted channels
+    static ChannelIDSpan Adopt(std::vector<value_type>&& channels)
+    {
+      auto owner = std::make_shared<std::vector<value_type> const>(std::move(channels));
+      return ChannelIDSpan(owner->data(), owner->data() + owner->size(), owner);
+    }
+
+    /// Returns a span owning a copy of the sorted channels in [first, last)
+    template <typename Iter>
+    static ChannelIDSpan Copy(Iter first, Iter last)
+    {
+      return Adopt(std::vector<value_type>(first, last));
+    }
+
+    const_iterator begin() const { return fBegin; }
+    const_iterator end() const { return fEnd; }
+    std::size_t size() const { return fEnd - fBegin; }
+    bool empty() const { return fBegin == fEnd; }
+    value_type operator[](std::size_t i) const { return fBegin[i]; }
+
+    /// Returns whether the channel is in the span (binary search)
+    bool contains(raw::ChannelID_t channel) const
+    {
+      return std::binary_search(fBegin, fEnd, channel);
+    }
+
+  private:
+    const_iterator fBegin = nullptr;
+    const_iterator fEnd = nullptr;
+    std::shared_ptr<void const> fOwner;
+  }; // class ChannelIDSpan
+
+  /// One bit per channel, for the channels [ 0, size() ), not owning its storage
+  class ChannelBitMask {
+  public:
+    using word_t = std::uint64_t;
+    static constexpr std::size_t kWordBits = 64;
+
+    /// Iterates the IDs of the channels with their bit set, in increasing order
+    class const_iterator {
+    public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = raw::ChannelID_t;
+      using difference_type = std::ptrdiff_t;
+      using pointer = value_type const*;
+      using reference = value_type;
+
+      const_iterator() = default;
+      const_iterator(ChannelBitMask const* mask, std::size_t pos) : fMask(mask), fPos(pos)
+      {
+        seek();
+      }
+
+      value_type operator*() const { return value_type(fPos); }
+      const_iterator& operator++()
+      {
+        ++fPos;
+        seek();
+        return *this;
+      }
+      const_iterator operator++(int)
+      {
+        auto old = *this;
+        ++*this;
+        return old;
+      }
+      bool operator==(const_iterator const& other) const { return fPos == other.fPos; }
+      bool operator!=(const_iterator const& other) const { return fPos != other.fPos; }
+
+    private:
+      ChannelBitMask const* fMask = nullptr;
+      std::size_t fPos = 0;
+
+      /// Moves to the first set bit at or after fPos (or to the end)
+      void seek()
+      {
+        std::size_t const n = fMask->size();
+        while (fPos < n) {
+          word_t const bits = fMask->fWords[fPos / kWordBits] >> (fPos % kWordBits);
+          if (bits) {
+            for (word_t b = bits; !(b & 1); b >>= 1)
+              ++fPos;
+            break;
+          }
+          fPos = (fPos / kWordBits + 1) * kWordBits;
+        }
+        if (fPos > n) fPos = n;
+      }
+    }; // class const_iterator
+
+    /// An empty mask
+    ChannelBitMask() = default;
+
+    /// Mask on nChannels bits starting at words; owner (if any) keeps the storage alive
+    ChannelBitMask(word_t const* words,
+                   std::size_t nChannels,
+                   std::shared_ptr<void const> owner = {})
+      : fWords(words), fSize(nChannels), fOwner(std::move(owner))
+    {}
+
+    /// Returns a mask owning its bits (at least NWords(nChannels) words)
+    static ChannelBitMask Adopt(std::vector<word_t>&& words, std::size_t nChannels)
+    {
+      auto owner = std::make_shared<std::vector<word_t> const>(std::move(words));
+      return ChannelBitMask(owner->data(), nChannels, owner);
+    }
+
+    /// Returns a mask owning its bits, set for the channels in [first, last)
+    template <typename Iter>
+    static ChannelBitMask FromChannels(Iter first, Iter last, std::size_t nChannels)
+    {
+      std::vector<word_t> words(NWords(nChannels), 0);
+      for (; first != last; ++first) {
+        std::size_t const ch = *first;
+        if (ch < nChannels) words[ch / kWordBits] |= word_t(1) << (ch % kWordBits);
+      }
+      return Adopt(std::move(words), nChannels);
+    }
+
+    /// Number of words needed to hold the bits of nChannels channels
+    static constexpr std::size_t NWords(std::size_t nChannels)
+    {
+      return (nChannels + kWordBits - 1) / kWordBits;
+    }
+
+    /// Number of channels covered by the mask
+    std::size_t size() const { return fSize; }
+
+    /// Returns the bit of the channel (false if out of the range of the mask)
+    bool test(raw::ChannelID_t channel) const
+    {
+      return channel < fSize && ((fWords[channel / kWordBits] >> (channel % kWordBits)) & 1);
+    }
+
+    /// Number of channels with their bit set
+    std::size_t count() const
+    {
+      std::size_t n = 0;
+      std::size_t const full = fSize / kWordBits;
+      for (std::size_t i = 0; i < full; ++i)
+        n += std::bitset<kWordBits>(fWords[i]).count();
+      if (fSize % kWordBits) {
+        word_t const tail = (word_t(1) << (fSize % kWordBits)) - 1;
+        n += std::bitset<kWordBits>(fWords[full] & tail).count();
+      }
+      return n;
+    }
+
+    /// Raw words; bits past size() in the last word are unspecified
+    word_t const* words() const { return fWords; }
+    std::size_t nWords() const { return NWords(fSize); }
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, fSize); }
+
+  private:
+    word_t const* fWords = nullptr;
+    std::size_t fSize = 0;
+    std::shared_ptr<void const> fOwner;
+  }; // class ChannelBitMask
+
+  /// Sorted, disjoint ranges of channel IDs, not owning their storage
+  class ChannelRangeSet {
+  public:
+    /// Channels from first to last, last excluded
+    struct Range {
+      raw::ChannelID_t first;
+      raw::ChannelID_t last;
+    };
+
+    /// Iterates the IDs of all the channels in the ranges, in increasing order
+    class const_iterator {
+    public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = raw::ChannelID_t;
+      using difference_type = std::ptrdiff_t;
+      using pointer = value_type const*;
+      using reference = value_type;
+
+      const_iterator() = default;
+      explicit const_iterator(Range const* range)
+        : fRange(range), fChannel(range ? range->first : 0)
+      {}
+
+      value_type operator*() const { return fChannel; }
+      const_iterator& operator++()
+      {
+        if (++fChannel == fRange->last) {
+          ++fRange;
+          fChannel = fRange->first; // reads the sentinel past the last range
+        }
+        return *this;
+      }
+      const_iterator operator++(int)
+      {
+        auto old = *this;
+        ++*this;
+        return old;
+      }
+      bool operator==(const_iterator const& other) const
+      {
+        return fRange == other.fRange && fChannel == other.fChannel;
+      }
+      bool operator!=(const_iterator const& other) const { return !(*this == other); }
+
+    private:
+      Range const* fRange = nullptr;
+      value_type fChannel = 0;
+    }; // class const_iterator
+
+    /// An empty set
+    ChannelRangeSet() = default;
+
+    /// Returns a set owning the sorted, disjoint, non-empty ranges
+    static ChannelRangeSet Adopt(std::vector<Range>&& ranges)
+    {
+      std::size_t const nRanges = ranges.size();
+      std::size_t nChannels = 0;
+      for (Range const& range : ranges)
+        nChannels += range.last - range.first;
+      ranges.push_back(Range{0, 0}); // sentinel, for the end iterator
+      auto owner = std::make_shared<std::vector<Range> const>(std::move(ranges));
+      return ChannelRangeSet(owner->data(), nRanges, nChannels, owner);
+    }
+
+    /// Returns a set owning the ranges covering the sorted channels in [first, last)
+    template <typename Iter>
+    static ChannelRangeSet FromChannels(Iter first, Iter last)
+    {
+      std::vector<Range> ranges;
+      for (; first != last; ++first) {
+        raw::ChannelID_t const ch = *first;
+        if (ranges.empty() || ranges.back().last != ch)
+          ranges.push_back(Range{ch, ch + 1});
+        else
+          ++ranges.back().last;
+      }
+      return Adopt(std::move(ranges));
+    }
+
+    /// Number of channels in the set
+    std::size_t size() const { return fSize; }
+    bool empty() const { return fSize == 0; }
+
+    /// Returns whether the channel is in one of the ranges (binary search)
+    bool contains(raw::ChannelID_t channel) const
+    {
+      Range const* const end = fRanges + fNRanges;
+      auto it = std::upper_bound(
+        fRanges, end, channel, [](raw::ChannelID_t ch, Range const& r) { return ch < r.first; });
+      return it != fRanges && channel < (it - 1)->last;
+    }
+
+    /// The ranges, sorted and disjoint
+    Range const* beginRanges() const { return fRanges; }
+    Range const* endRanges() const { return fRanges + fNRanges; }
+    std::size_t nRanges() const { return fNRanges; }
+
+    const_iterator begin() const { return const_iterator(fNRanges ? fRanges : nullptr); }
+    const_iterator end() const
+    {
+      return fNRanges ? const_iterator(fRanges + fNRanges) : const_iterator();
+    }
+
+  private:
+    Range const* fRanges = nullptr;
+    std::size_t fNRanges = 0;
+    std::size_t fSize = 0;
+    std::shared_ptr<void const> fOwner;
+
+    ChannelRangeSet(Range const* ranges,
+                    std::size_t nRanges,
+                    std::size_t nChannels,
+                    std::shared_ptr<void const> owner)
+      : fRanges(ranges), fNRanges(nRanges), fSize(nChannels), fOwner(std::move(owner))
+    {}
+  }; // class ChannelRangeSet
+
+} // namespace lariov
+
+#endif // CHANNELSTATUSVIEWS_H
@@ -11,6 +11,9 @@
 
 #include "larcorealg/CoreUtils/UncopiableAndUnmovableClass.h"
 
+#include <cmath>
+#include <cstddef>
+
 namespace lariov {
 
   /**
@@ -28,6 +31,16 @@ namespace lariov {
     virtual float Purity() const = 0;
     virtual float LifetimeErr(float t) const = 0;
     virtual float PurityErr() const = 0;
+
+    /// Fraction of the drifting charge left after the drift time t
+    virtual float Attenuation(float t) const { return std::exp(-t / Lifetime(t)); }
+
+    /// Sets attenuation[i] to Attenuation(driftTimes[i]), for i < n
+    virtual void Attenuation(float const* driftTimes, std::size_t n, float* attenuation) const
+    {
+      for (std::size_t i = 0; i < n; ++i)
+        attenuation[i] = Attenuation(driftTimes[i]);
+    }
   };
 } //end namespace lariov
 
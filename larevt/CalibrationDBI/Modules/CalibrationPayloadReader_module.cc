@@ -0,0 +1,68 @@
+/**
+ * \file CalibrationPayloadReader_module.cc
+ *
+ * \ingroup WebDBI
+ *
+ * \brief Module loading the conditions data stored in the input
+ */
+
+#include "art/Framework/Core/EDProducer.h"
+#include "art/Framework/Core/ModuleMacros.h"
+#include "art/Framework/Principal/Handle.h"
+#include "art/Framework/Principal/Run.h"
+#include "canvas/Utilities/InputTag.h"
+#include "fhiclcpp/ParameterSet.h"
+#include "larevt/CalibrationDBI/IOVData/DBPayload.h"
+#include "larevt/CalibrationDBI/Providers/DBPayloadStore.h"
+#include "messagefacility/MessageLogger/MessageLogger.h"
+
+#include <vector>
+
+namespace lariov {
+
+  /**
+     \class CalibrationPayloadReader
+     Loads, at the start of each run, the conditions data written in the input
+     by CalibrationPayloadWriter, for the providers configured with
+     `UseEmbeddedPayloads: true` (see DBFolder).  It should be the first
+     module of the trigger paths, so that the data are available to the
+     other modules from their beginRun().
+
+     Configuration parameters:
+     - `PayloadTag` (default: "calibpayloads"): tag of the payload product
+     - `Verbose` (default: false): logs the number of payloads read
+  */
+  class CalibrationPayloadReader : public art::EDProducer {
+
+  public:
+    explicit CalibrationPayloadReader(fhicl::ParameterSet const& pset);
+
+    void produce(art::Event&) override {}
+    void beginRun(art::Run& run) override;
+
+  private:
+    art::InputTag fPayloadTag;
+    bool fVerbose;
+  };
+
+  CalibrationPayloadReader::CalibrationPayloadReader(fhicl::ParameterSet const& pset)
+    : EDProducer{pset}
+    , fPayloadTag(pset.get<art::InputTag>("PayloadTag", "calibpayloads"))
+    , fVerbose(pset.get<bool>("Verbose", false))
+  {
+    consumes<std::vector<DBPayload>, art::InRun>(fPayloadTag);
+  }
+
+  void CalibrationPayloadReader::beginRun(art::Run& run)
+  {
+    auto const& payloads = *run.getValidHandle<std::vector<DBPayload>>(fPayloadTag);
+    DBPayloadStore::Instance().Load(payloads);
+    if (fVerbose) {
+      mf::LogInfo("CalibrationPayloadReader")
+        << "Loaded " << payloads.size() << " conditions payloads from run " << run.run();
+    }
+  }
+
+} //end namespace lariov
+
+DEFINE_ART_MODULE(lariov::CalibrationPayloadReader)
@@ -0,0 +1,68 @@
+/**
+ * \file CalibrationPayloadWriter_module.cc
+ *
+ * \ingroup WebDBI
+ *
+ * \brief Module storing the conditions data used by the job in the output
+ */
+
+#include "art/Framework/Core/EDProducer.h"
+#include "art/Framework/Core/ModuleMacros.h"
+#include "art/Framework/Principal/Run.h"
+#include "fhiclcpp/ParameterSet.h"
+#include "larevt/CalibrationDBI/IOVData/DBPayload.h"
+#include "larevt/CalibrationDBI/Providers/DBPayloadStore.h"
+#include "messagefacility/MessageLogger/MessageLogger.h"
+
+#include <memory>
+#include <vector>
+
+namespace lariov {
+
+  /**
+     \class CalibrationPayloadWriter
+     Writes, at the end of each run, the data of all the database folders
+     used in that run as a run data product, so that later jobs can read
+     them back with CalibrationPayloadReader instead of querying the
+     database.  Each interval of validity is written once per run, whichever
+     provider fetched it, and again in each later run that starts while a
+     folder or a cached snapshot still holds it, since such a run may use it
+     without fetching it again.
+
+     Configuration parameters:
+     - `Verbose` (default: false): logs the number of payloads written
+  */
+  class CalibrationPayloadWriter : public art::EDProducer {
+
+  public:
+    explicit CalibrationPayloadWriter(fhicl::ParameterSet const& pset);
+
+    void produce(art::Event&) override {}
+    void endRun(art::Run& run) override;
+
+  private:
+    bool fVerbose;
+  };
+
+  CalibrationPayloadWriter::CalibrationPayloadWriter(fhicl::ParameterSet const& pset)
+    : EDProducer{pset}, fVerbose(pset.get<bool>("Verbose", false))
+  {
+    produces<std::vector<DBPayload>, art::InRun>();
+
+    DBPayloadStore::Instance().SetRecording(true);
+  }
+
+  void CalibrationPayloadWriter::endRun(art::Run& run)
+  {
+    auto payloads =
+      std::make_unique<std::vector<DBPayload>>(DBPayloadStore::Instance().TakeRecordedPayloads());
+    if (fVerbose) {
+      mf::LogInfo("CalibrationPayloadWriter")
+        << "Writing " << payloads->size() << " conditions payloads in run " << run.run();
+    }
+    run.put(std::move(payloads), art::fullRun());
+  }
+
+} //end namespace lariov
+
+DEFINE_ART_MODULE(lariov::CalibrationPayloadWriter)
@@ -0,0 +1,292 @@
+#include "CalibrationFileReader.h"
+
+#include "cetlib_except/exception.h"
+#include "tbb/parallel_for.h"
+#include "tbb/task_arena.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+  using lariov::DBChannelID_t;
+
+  // Read-only memory mapping of a whole file.
+
+  class MappedFile {
+  public:
+    explicit MappedFile(const std::string& fileName)
+    {
+      int fd = ::open(fileName.c_str(), O_RDONLY);
+      if (fd < 0) {
+        throw cet::exception("CalibrationFileReader") << "File " << fileName << " is not found.";
+      }
+      struct stat st;
+      if (::fstat(fd, &st) == 0) fSize = st.st_size;
+      if (fSize > 0) {
+        void* addr = ::mmap(nullptr, fSize, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+        if (addr == MAP_FAILED) {
+          ::close(fd);
+          throw cet::exception("CalibrationFileReader") << "Cannot map file " << fileName;
+        }
+        ::madvise(addr, fSize, MADV_SEQUENTIAL);
+        fData = static_cast<const char*>(addr);
+      }
+      ::close(fd);
+    }
+
+    ~MappedFile()
+    {
+      if (fData) ::munmap(const_cast<char*>(fData), fSize);
+    }
+
+    MappedFile(MappedFile const&) = delete;
+    MappedFile& operator=(MappedFile const&) = delete;
+
+    const char* begin() const { return fData; }
+    const char* end() const { return fData + fSize; }
+    size_t size() const { return fSize; }
+
+  private:
+    const char* fData = nullptr;
+    size_t fSize = 0;
+  };
+
+  // Where each field of a line goes: kIgnore, kChannel or the value column index.
+
+  constexpr int kIgnore = -2;
+  constexpr int kChannel = -1;
+
+  struct Table {
+    std::vector<DBChannelID_t> channels;
+    std::vector<float> values;
+  };
+
+  bool IsBlank(char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+
+  // Returns the end of [b, e) without trailing blanks; b is advanced past leading blanks.
+
+  const char* Trim(const char*& b, const char* e)
+  {
+    while (b != e && IsBlank(*b))
+      ++b;
+    while (e != b && IsBlank(*(e - 1)))
+      --e;
+    return e;
+  }
+
+  // As Trim(), also dropping a comment.
+
+  const char* TrimLine(const char*& b, const char* e)
+  {
+    if (auto hash = static_cast<const char*>(std::memchr(b, '#', e - b))) e = hash;
+    return Trim(b, e);
+  }
+
+  const char* NextLine(const char* b, const char* e)
+  {
+    auto eol = static_cast<const char*>(std::memchr(b, '\n', e - b));
+    return eol ? eol + 1 : e;
+  }
+
+  [[noreturn]] void ParseError(const std::string& fileName, const char* b, const char* e)
+  {
+    throw cet::exception("CalibrationFileReader")
+      << "Cannot parse line '" << std::string(b, e) << "' in file " << fileName;
+  }
+
+  // std::from_chars() does not accept the explicit '+' sign that strtod() does.
+
+  const char* SkipPlus(const char* b, const char* e)
+  {
+    return (e - b > 1 && *b == '+' && *(b + 1) != '-' && *(b + 1) != '+') ? b + 1 : b;
+  }
+
+  bool ParseChannel(const char* b, const char* e, DBChannelID_t& ch)
+  {
+    b = SkipPlus(b, e);
+    auto res = std::from_chars(b, e, ch);
+    return res.ec == std::errc() && res.ptr == e;
+  }
+
+  bool ParseValue(const char* b, const char* e, float& value)
+  {
+#if defined(__cpp_lib_to_chars)
+    b = SkipPlus(b, e);
+    auto res = std::from_chars(b, e, value);
+    return res.ec == std::errc() && res.ptr == e;
+#else
+    // No floating point std::from_chars before GCC 11: parse a terminated copy.
+    char buf[64];
+    size_t const len = e - b;
+    if (len == 0 || len >= sizeof(buf)) return false;
+    std::memcpy(buf, b, len);
+    buf[len] = '\0';
+    char* stop = nullptr;
+    value = std::strtof(buf, &stop);
+    return stop == buf + len;
+#endif
+  }
+
+  void ParseRange(const char* b,
+                  const char* e,
+                  const std::vector<int>& targets,
+                  size_t nColumns,
+                  const std::string& fileName,
+                  Table& out)
+  {
+    // Rough guess of 8 bytes per field, to limit reallocations.
+    size_t const guess = (e - b) / (8 * (nColumns + 1)) + 1;
+    out.channels.reserve(guess);
+    out.values.reserve(guess * nColumns);
+
+    DBChannelID_t channel = 0;
+    std::vector<float> values(nColumns);
+    for (const char* line = b; line != e;) {
+      const char* next = NextLine(line, e);
+      const char* first = line;
+      const char* last = TrimLine(first, next);
+      line = next;
+      if (first == last) continue;
+
+      size_t found = 0;
+      size_t field = 0;
+      for (const char* fb = first; fb <= last; ++field) {
+        auto comma = static_cast<const char*>(std::memchr(fb, ',', last - fb));
+        const char* fe = comma ? comma : last;
+        const char* vb = fb;
+        const char* ve = Trim(vb, fe);
+        int const target = field < targets.size() ? targets[field] : kIgnore;
+        if (target == kChannel) {
+          if (!ParseChannel(vb, ve, channel)) ParseError(fileName, first, last);
+          ++found;
+        }
+        else if (target >= 0) {
+          if (!ParseValue(vb, ve, values[target])) ParseError(fileName, first, last);
+          ++found;
+        }
+        fb = fe + 1;
+      }
+      if (found != nColumns + 1) ParseError(fileName, first, last);
+
+      out.channels.push_back(channel);
+      out.values.insert(out.values.end(), values.begin(), values.end());
+    }
+  }
+
+} // namespace
+
+namespace lariov {
+
+  CalibrationFileReader::CalibrationFileReader(const std::string& fileName,
+                                               std::vector<std::string> columns,
+                                               unsigned int nChunks)
+    : fFileName(fileName), fColumns(std::move(columns))
+  {
+    MappedFile const file(fFileName);
+    const char* begin = file.begin();
+    const char* const end = file.end();
+    if (begin == end) return;
+
+    // Default column order, possibly overridden by a header.
+    std::vector<int> targets{kChannel};
+    for (size_t i = 0; i != fColumns.size(); ++i)
+      targets.push_back(int(i));
+
+    for (const char* line = begin; line != end;) {
+      const char* next = NextLine(line, end);
+      const char* first = line;
+      const char* last = TrimLine(first, next);
+      if (first == last) {
+        line = begin = next;
+        continue;
+      }
+      if ((*first >= '0' && *first <= '9') || *first == '+' || *first == '-') break;
+
+      // Header line.
+      targets.clear();
+      std::vector<bool> seen(fColumns.size() + 1, false);
+      for (const char* fb = first; fb <= last;) {
+        auto comma = static_cast<const char*>(std::memchr(fb, ',', last - fb));
+        const char* fe = comma ? comma : last;
+        const char* vb = fb;
+        const char* ve = Trim(vb, fe);
+        std::string const name(vb, ve);
+        int target = kIgnore;
+        if (name == "channel")
+          target = kChannel;
+        else {
+          auto it = std::find(fColumns.begin(), fColumns.end(), name);
+          if (it != fColumns.end()) target = int(it - fColumns.begin());
+        }
+        if (target != kIgnore) {
+          if (seen[target + 1]) {
+            throw cet::exception("CalibrationFileReader")
+              << "Column '" << name << "' appears twice in the header of file " << fFileName;
+          }
+          seen[target + 1] = true;
+        }
+        targets.push_back(target);
+        fb = fe + 1;
+      }
+      for (size_t i = 0; i != seen.size(); ++i) {
+        if (!seen[i]) {
+          throw cet::exception("CalibrationFileReader")
+            << "Column '" << (i ? fColumns[i - 1] : std::string("channel"))
+            << "' is missing from the header of file " << fFileName;
+        }
+      }
+      begin = next;
+      break;
+    }
+
+    // Split the remaining text in chunks ending at line boundaries.
+    size_t const size = end - begin;
+    if (nChunks == 0) {
+      constexpr size_t kMinChunkSize = 1 << 20;
+      unsigned int const nThreads = tbb::this_task_arena::max_concurrency();
+      nChunks = std::max(1u, std::min(nThreads, unsigned(size / kMinChunkSize)));
+    }
+    std::vector<const char*> bounds{begin};
+    for (unsigned int i = 1; i < nChunks; ++i) {
+      const char* cut = std::max(bounds.back(), begin + size * i / nChunks);
+      if (cut != begin) cut = NextLine(cut - 1, end);
+      if (cut != bounds.back()) bounds.push_back(cut);
+    }
+    bounds.push_back(end);
+
+    if (bounds.size() == 2) {
+      Table table;
+      ParseRange(begin, end, targets, fColumns.size(), fFileName, table);
+      fChannels = std::move(table.channels);
+      fValues = std::move(table.values);
+      return;
+    }
+
+    // TBB tasks, run by the threads of the job (parsing errors are rethrown here).
+    std::vector<Table> tables(bounds.size() - 1);
+    tbb::parallel_for(size_t(0), tables.size(), [&](size_t i) {
+      ParseRange(bounds[i], bounds[i + 1], targets, fColumns.size(), fFileName, tables[i]);
+    });
+
+    size_t nRows = 0;
+    for (auto const& table : tables)
+      nRows += table.channels.size();
+
+    fChannels.reserve(nRows);
+    fValues.reserve(nRows * fColumns.size());
+    for (auto const& table : tables) {
+      fChannels.insert(fChannels.end(), table.channels.begin(), table.channels.end());
+      fValues.insert(fValues.end(), table.values.begin(), table.values.end());
+    }
+  }
+
+} //end namespace lariov
@@ -0,0 +1,73 @@
+/**
+ * \file CalibrationFileReader.h
+ *
+ * \ingroup WebDBI
+ *
+ * \brief Class def header for a class CalibrationFileReader
+ */
+
+/** \addtogroup WebDBI
+
+    @{*/
+#ifndef WEBDBI_CALIBRATIONFILEREADER_H
+#define WEBDBI_CALIBRATIONFILEREADER_H
+
+#include "larevt/CalibrationDBI/Interface/CalibrationDBIFwd.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace lariov {
+
+  /**
+     \class CalibrationFileReader
+     Reads the comma separated calibration tables used by the providers when
+     configured with `UseFile: true`.
+
+     Each line holds a channel number followed by the values of that channel.
+     Blank lines are skipped, and everything following a `#` is a comment.
+     The column order is the one passed to the constructor, unless the first
+     line of the file that is not a comment is a header naming the columns,
+     e.g. `channel, rms, mean`; in that case columns are matched by name,
+     columns with unknown names are ignored and the named columns may come in
+     any order.  The channel column is always called `channel`.
+
+     The file is memory mapped and parsed in place without creating strings;
+     large files are split at line boundaries and the pieces are parsed as
+     TBB tasks, within the thread limit of the job.  Values may carry an
+     explicit '+' sign.  Rows are returned in file order.
+  */
+  class CalibrationFileReader {
+
+  public:
+    /**
+       Reads fileName (a full path).  columns lists the names of the value
+       columns, in their order when the file has no header.  nChunks is the
+       number of pieces parsed in parallel; 0 picks one based on the file
+       size and on the number of threads available.
+    */
+    CalibrationFileReader(const std::string& fileName,
+                          std::vector<std::string> columns,
+                          unsigned int nChunks = 0);
+
+    const std::string& FileName() const { return fFileName; }
+
+    size_t NRows() const { return fChannels.size(); }
+    size_t NColumns() const { return fColumns.size(); }
+
+    DBChannelID_t Channel(size_t row) const { return fChannels[row]; }
+
+    /// Value in the given row of the column with index column in the constructor list
+    float Value(size_t row, size_t column) const { return fValues[row * fColumns.size() + column]; }
+
+  private:
+    std::string fFileName;
+    std::vector<std::string> fColumns;
+    std::vector<DBChannelID_t> fChannels;
+    std::vector<float> fValues; // Row-major, NColumns() per row.
+  };
+
+} //end namespace lariov
+#endif
+/** @} */ // end of doxygen group
@@ -0,0 +1,135 @@
+#include "ChannelCalibrationBundleProvider.h"
+#include "DBPayloadStore.h"
+
+// art/LArSoft libraries
+#include "cetlib_except/exception.h"
+
+#include <algorithm>
+#include <tuple>
+
+namespace {
+
+  template <class Provider, class Interface>
+  Provider const& AsDatabaseProvider(Interface const& provider, const char* name)
+  {
+    auto const* concrete = dynamic_cast<Provider const*>(&provider);
+    if (!concrete) {
+      throw cet::exception("ChannelCalibrationBundleProvider")
+        << "The " << name << " provider does not read the conditions database.\n";
+    }
+    return *concrete;
+  }
+
+  /// Restricts iov to the interval of validity of the data of provider
+  template <class Provider, class SnapshotPtr>
+  void Intersect(lariov::DatabaseRetrievalAlg::IOVRange_t& iov,
+                 Provider const& provider,
+                 SnapshotPtr const& data)
+  {
+    if (!provider.UsesDatabase()) return;
+    iov.first = std::max(iov.first, data->Start());
+    iov.second = std::min(iov.second, data->End());
+  }
+
+} // namespace
+
+namespace lariov {
+
+  //constructors
+  ChannelCalibrationBundleProvider::ChannelCalibrationBundleProvider(
+    DetPedestalRetrievalAlg const& pedestals,
+    SIOVElectronicsCalibProvider const& electronics,
+    SIOVChannelStatusProvider const& status)
+    : fPedestals(pedestals)
+    , fElectronics(electronics)
+    , fStatus(status)
+    , fBundles(kMAX_ENTRIES)
+  {}
+
+  ChannelCalibrationBundleProvider::ChannelCalibrationBundleProvider(
+    DetPedestalProvider const& pedestals,
+    ElectronicsCalibProvider const& electronics,
+    ChannelStatusProvider const& status)
+    : ChannelCalibrationBundleProvider(
+        AsDatabaseProvider<DetPedestalRetrievalAlg>(pedestals, "pedestal"),
+        AsDatabaseProvider<SIOVElectronicsCalibProvider>(electronics, "electronics calibration"),
+        AsDatabaseProvider<SIOVChannelStatusProvider>(status, "channel status"))
+  {}
+
+  ChannelCalibrationBundleProvider::BundlePtr_t ChannelCalibrationBundleProvider::BundleFor(
+    DBTimeStamp_t ts) const
+  {
+    return fBundles.FindOrBuild(ts, [this](DBTimeStamp_t t) { return Build(t); });
+  }
+
+  // Called by the bundle cache, one call at a time.
+
+  ChannelCalibrationBundleProvider::BundlePtr_t ChannelCalibrationBundleProvider::Build(
+    DBTimeStamp_t ts) const
+  {
+    auto const pedestalData = fPedestals.SnapshotFor(ts);
+    auto const electronicsData = fElectronics.SnapshotFor(ts);
+    auto const statusData = fStatus.SnapshotFor(ts);
+
+    DatabaseRetrievalAlg::IOVRange_t iov = DatabaseRetrievalAlg::AllTimes();
+    Intersect(iov, fPedestals, pedestalData);
+    Intersect(iov, fElectronics, electronicsData);
+    Intersect(iov, fStatus, statusData);
+
+    auto const& pedestals = *pedestalData;
+    auto const& electronics = *electronicsData;
+
+    std::size_t limit = std::max(pedestals.ChannelLimit(), electronics.ChannelLimit());
+    if (statusData) limit = std::max(limit, statusData->ChannelLimit());
+
+    auto bundle = std::make_shared<Bundle_t>();
+    bundle->SetIoV(iov.first, iov.second);
+    bundle->Reset(limit);
+
+    pedestals.ForEachRow([&bundle](DetPedestal const& pd) {
+      auto& record = bundle->MutableRecord(pd.Channel());
+      record.pedMean = pd.PedMean();
+      record.pedRms = pd.PedRms();
+      record.sources |= Bundle_t::kPedestal;
+    });
+
+    electronics.ForEachRow([&bundle](ElectronicsCalib const& calib) {
+      auto& record = bundle->MutableRecord(calib.Channel());
+      record.gain = calib.Gain();
+      record.shapingTime = calib.ShapingTime();
+      record.sources |= Bundle_t::kElectronics;
+    });
+
+    // The default channel status source has no snapshot.
+    if (statusData) {
+      auto const& packed = statusData->PackedStatus();
+      for (unsigned int ch = 0; ch != packed.size(); ++ch) {
+        if (packed[ch] == ChannelStatusSnapshot::kNoStatus) continue;
+        auto& record = bundle->MutableRecord(ch);
+        record.status = packed[ch];
+        record.sources |= Bundle_t::kStatus;
+      }
+    }
+    else {
+      std::uint8_t const status = fStatus.DefaultStatus().Status();
+      for (unsigned int ch = 0; ch != limit; ++ch) {
+        auto& record = bundle->MutableRecord(ch);
+        if (record.sources == 0) continue;
+        record.status = status;
+        record.sources |= Bundle_t::kStatus;
+      }
+    }
+
+    // While the payloads are recorded, the bundle keeps the snapshots it was built from,
+    // which keep their data recorded for as long as the bundle is cached.
+    if (!DBPayloadStore::Instance().Recording()) return bundle;
+    auto const holder =
+      std::make_shared<std::tuple<BundlePtr_t,
+                                  decltype(pedestalData),
+                                  decltype(electronicsData),
+                                  decltype(statusData)>>(
+        std::move(bundle), pedestalData, electronicsData, statusData);
+    return BundlePtr_t(holder, std::get<0>(*holder).get());
+  }
+
+} //end namespace lariov
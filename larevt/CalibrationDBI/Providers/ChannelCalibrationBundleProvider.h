@@ -0,0 +1,77 @@
+/**
+ * \file ChannelCalibrationBundleProvider.h
+ *
+ * \ingroup WebDBI
+ *
+ * \brief Class def header for a class ChannelCalibrationBundleProvider
+ */
+
+/** \addtogroup WebDBI
+
+    @{*/
+#ifndef CHANNELCALIBRATIONBUNDLEPROVIDER_H
+#define CHANNELCALIBRATIONBUNDLEPROVIDER_H
+
+#include "DetPedestalRetrievalAlg.h"
+#include "SIOVChannelStatusProvider.h"
+#include "SIOVElectronicsCalibProvider.h"
+#include "larevt/CalibrationDBI/IOVData/ChannelCalibrationBundle.h"
+#include "larevt/CalibrationDBI/IOVData/SnapshotCache.h"
+#include "larevt/CalibrationDBI/Interface/CalibrationDBIFwd.h"
+
+#include <cstddef>
+#include <memory>
+
+namespace lariov {
+
+  /**
+   * @brief Joins pedestals, electronics calibrations and channel statuses
+   *
+   * BundleFor() returns a ChannelCalibrationBundle with the data of the three
+   * providers valid at the specified time.  The bundle is valid in the
+   * intersection of the intervals of validity of the three snapshots, and is
+   * built once for that interval; a few bundles are kept in a SnapshotCache,
+   * so that concurrent events from different intervals are served without
+   * rebuilding, and a lookup does not go through the providers.
+   *
+   * The status is the one of the snapshot: channels flagged as noisy during
+   * an event (see SIOVChannelStatusProvider::AddNoisyChannel()) are not in the
+   * bundle.
+   */
+  class ChannelCalibrationBundleProvider {
+
+  public:
+    using Bundle_t = ChannelCalibrationBundle;
+    using BundlePtr_t = std::shared_ptr<Bundle_t const>;
+
+    /// Number of bundles kept alive
+    static constexpr std::size_t kMAX_ENTRIES = 4;
+
+    /// Constructor; the providers must outlive this object
+    ChannelCalibrationBundleProvider(DetPedestalRetrievalAlg const& pedestals,
+                                     SIOVElectronicsCalibProvider const& electronics,
+                                     SIOVChannelStatusProvider const& status);
+
+    /// Constructor from the service providers; throws cet::exception if they are
+    /// not the database implementations
+    ChannelCalibrationBundleProvider(DetPedestalProvider const& pedestals,
+                                     ElectronicsCalibProvider const& electronics,
+                                     ChannelStatusProvider const& status);
+
+    /// Returns the bundle valid at the specified time
+    BundlePtr_t BundleFor(DBTimeStamp_t ts) const;
+
+  private:
+    /// Joins the snapshots of the three providers valid at ts into a bundle
+    BundlePtr_t Build(DBTimeStamp_t ts) const;
+
+    DetPedestalRetrievalAlg const& fPedestals;
+    SIOVElectronicsCalibProvider const& fElectronics;
+    SIOVChannelStatusProvider const& fStatus;
+
+    mutable SnapshotCache<Bundle_t> fBundles; // One per intersection of IOVs.
+  };
+} //end namespace lariov
+
+#endif
+/** @} */ // end of doxygen group
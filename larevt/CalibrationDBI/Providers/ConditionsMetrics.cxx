@@ -0,0 +1,183 @@
+#include "ConditionsMetrics.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <utility>
+
+namespace {
+
+  std::size_t BinOf(std::uint64_t value)
+  {
+    std::size_t bin = 0;
+    while (value) {
+      ++bin;
+      value >>= 1;
+    }
+    return bin;
+  }
+
+  double HitRate(std::uint64_t calls, std::uint64_t misses)
+  {
+    return (calls && misses <= calls) ? double(calls - misses) / calls : 0.;
+  }
+
+  // Folder names are database table names; escape anyway.
+  void WriteJSONString(std::ostream& out, std::string const& s)
+  {
+    out << '"';
+    for (char const c : s) {
+      if (c == '"' || c == '\\')
+        out << '\\' << c;
+      else if (static_cast<unsigned char>(c) < 0x20)
+        out << ' ';
+      else
+        out << c;
+    }
+    out << '"';
+  }
+
+  void WriteJSON(std::ostream& out, lariov::MetricsHistogram const& h)
+  {
+    out << "{\"count\": " << h.Count() << ", \"sum\": " << h.Sum() << ", \"min\": " << h.Min()
+        << ", \"max\": " << h.Max() << ", \"mean\": " << h.Mean()
+        << ", \"p50\": " << h.Quantile(0.5) << ", \"p90\": " << h.Quantile(0.9)
+        << ", \"p99\": " << h.Quantile(0.99) << ", \"bins\": [";
+    const char* sep = "";
+    for (std::size_t bin = 0; bin != lariov::MetricsHistogram::kNBINS; ++bin) {
+      if (!h.BinCount(bin)) continue;
+      out << sep << '[' << lariov::MetricsHistogram::BinUpperEdge(bin) << ", " << h.BinCount(bin)
+          << ']';
+      sep = ", ";
+    }
+    out << "]}";
+  }
+
+} // namespace
+
+namespace lariov {
+
+  std::atomic<bool> ConditionsMetrics::sEnabled{false};
+
+  //----------------------------------------------------------------------------
+  void MetricsHistogram::Fill(std::uint64_t value)
+  {
+    fBins[BinOf(value)].fetch_add(1, std::memory_order_relaxed);
+    fCount.fetch_add(1, std::memory_order_relaxed);
+    fSum.fetch_add(value, std::memory_order_relaxed);
+
+    std::uint64_t min = fMin.load(std::memory_order_relaxed);
+    while (value < min && !fMin.compare_exchange_weak(min, value, std::memory_order_relaxed)) {}
+    std::uint64_t max = fMax.load(std::memory_order_relaxed);
+    while (value > max && !fMax.compare_exchange_weak(max, value, std::memory_order_relaxed)) {}
+  }
+
+  std::uint64_t MetricsHistogram::Quantile(double q) const
+  {
+    std::uint64_t const count = Count();
+    if (count == 0) return 0;
+
+    std::uint64_t const rank = static_cast<std::uint64_t>(q * count + 0.5);
+    std::uint64_t seen = 0;
+    for (std::size_t bin = 0; bin != kNBINS; ++bin) {
+      seen += BinCount(bin);
+      if (seen >= rank && seen > 0) return std::min(BinUpperEdge(bin), Max());
+    }
+    return Max();
+  }
+
+  //----------------------------------------------------------------------------
+  ConditionsMetrics& ConditionsMetrics::Instance()
+  {
+    static ConditionsMetrics instance;
+    return instance;
+  }
+
+  FolderMetrics& ConditionsMetrics::Folder(std::string const& name)
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    auto& metrics = fFolders[name];
+    if (!metrics) metrics = std::make_unique<FolderMetrics>();
+    return *metrics;
+  }
+
+  // Times are printed in milliseconds, sizes in kilobytes.
+
+  void ConditionsMetrics::WriteSummary(std::ostream& out) const
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+
+    out << std::left << std::setw(24) << "folder" << std::right << std::setw(9) << "updates"
+        << std::setw(7) << "IOVs" << std::setw(11) << "fetch ms" << std::setw(11) << "max ms"
+        << std::setw(11) << "parse ms" << std::setw(10) << "kB" << std::setw(8) << "rows"
+        << std::setw(11) << "rebuild ms" << std::setw(11) << "lookups" << std::setw(8) << "hits"
+        << std::setw(11) << "row calls" << '\n';
+
+    out << std::fixed << std::setprecision(2);
+    for (auto const& [name, m] : fFolders) {
+      MetricsHistogram const& fetch = m->FetchTime();
+      out << std::left << std::setw(24) << name << std::right << std::setw(9) << m->updateCalls
+          << std::setw(7) << m->iovSwitches << std::setw(11) << fetch.Mean() / 1000.
+          << std::setw(11) << fetch.Max() / 1000. << std::setw(11) << m->parseTime.Mean() / 1000.
+          << std::setw(10) << m->payloadBytes.Mean() / 1024. << std::setw(8) << m->rows.Max()
+          << std::setw(11) << m->rebuildTime.Mean() / 1000. << std::setw(11)
+          << m->snapshotLookups << std::setw(7) << std::setprecision(0)
+          << 100. * HitRate(m->snapshotLookups, m->rebuildTime.Count()) << '%'
+          << std::setprecision(2) << std::setw(11) << m->namedDataCalls << '\n';
+    }
+
+    for (auto const& [name, m] : fFolders) {
+      if (!m->shadowTime.Count() && !m->shadowDropped) continue;
+      MetricsHistogram const& fetch = m->FetchTime();
+      out << name << " shadow: " << m->shadowComparisons << " compared, " << m->shadowMismatches
+          << " mismatched, " << m->shadowErrors << " failed, " << m->shadowDropped
+          << " dropped; " << m->shadowTime.Mean() / 1000. << " ms per query vs. "
+          << fetch.Mean() / 1000. << " ms, slower " << m->shadowSlower << " times\n";
+    }
+  }
+
+  void ConditionsMetrics::WriteJSON(std::ostream& out) const
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+
+    out << "{\n  \"time_unit\": \"us\",\n  \"folders\": {";
+    const char* sep = "\n";
+    for (auto const& [name, m] : fFolders) {
+      out << sep << "    ";
+      WriteJSONString(out, name);
+      out << ": {\n      \"calls\": {\"UpdateData\": " << m->updateCalls
+          << ", \"GetNamedChannelData\": " << m->namedDataCalls
+          << ", \"SnapshotFor\": " << m->snapshotLookups << "},\n"
+          << "      \"iov_switches\": " << m->iovSwitches << ",\n"
+          << "      \"shared_fetches\": " << m->sharedFetches << ",\n"
+          << "      \"shadow\": {\"compared\": " << m->shadowComparisons
+          << ", \"mismatched\": " << m->shadowMismatches << ", \"failed\": " << m->shadowErrors
+          << ", \"dropped\": " << m->shadowDropped << ", \"slower\": " << m->shadowSlower
+          << "},\n"
+          << "      \"folder_hit_rate\": " << HitRate(m->updateCalls, m->iovSwitches) << ",\n"
+          << "      \"snapshot_hit_rate\": "
+          << HitRate(m->snapshotLookups, m->rebuildTime.Count()) << ",\n";
+
+      std::pair<const char*, MetricsHistogram const*> const histograms[] = {
+        {"http_time", &m->httpTime},
+        {"sqlite_time", &m->sqliteTime},
+        {"bundle_time", &m->bundleTime},
+        {"parse_time", &m->parseTime},
+        {"transfer_bytes", &m->transferBytes},
+        {"payload_bytes", &m->payloadBytes},
+        {"rows", &m->rows},
+        {"columns", &m->columns},
+        {"rebuild_time", &m->rebuildTime},
+        {"shadow_time", &m->shadowTime}};
+      const char* hsep = "";
+      for (auto const& [key, h] : histograms) {
+        out << hsep << "      \"" << key << "\": ";
+        ::WriteJSON(out, *h);
+        hsep = ",\n";
+      }
+      out << "\n    }";
+      sep = ",\n";
+    }
+    out << "\n  }\n}\n";
+  }
+
+} //end namespace lariov
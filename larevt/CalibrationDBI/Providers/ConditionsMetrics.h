@@ -0,0 +1,177 @@
+/**
+ * \file ConditionsMetrics.h
+ *
+ * \ingroup WebDBI
+ *
+ * \brief Class def header for the conditions access metrics
+ */
+
+/** \addtogroup WebDBI
+
+    @{*/
+#ifndef CONDITIONSMETRICS_H
+#define CONDITIONSMETRICS_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+
+namespace lariov {
+
+  /**
+     \class MetricsHistogram
+     Thread-safe histogram of non-negative integer samples, with logarithmic
+     bins: bin 0 counts the zeros, bin i the samples in [2^(i-1), 2^i).
+  */
+  class MetricsHistogram {
+
+  public:
+    static constexpr std::size_t kNBINS = 65;
+
+    void Fill(std::uint64_t value);
+
+    std::uint64_t Count() const { return fCount.load(std::memory_order_relaxed); }
+    std::uint64_t Sum() const { return fSum.load(std::memory_order_relaxed); }
+    std::uint64_t Min() const { return Count() ? fMin.load(std::memory_order_relaxed) : 0; }
+    std::uint64_t Max() const { return fMax.load(std::memory_order_relaxed); }
+    double Mean() const { return Count() ? double(Sum()) / Count() : 0.; }
+
+    std::uint64_t BinCount(std::size_t bin) const
+    {
+      return fBins[bin].load(std::memory_order_relaxed);
+    }
+
+    /// Largest value counted in the bin
+    static std::uint64_t BinUpperEdge(std::size_t bin)
+    {
+      return bin == 0 ? 0 : (bin == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << bin) - 1);
+    }
+
+    /// Upper edge of the bin holding the q-th quantile (0 < q <= 1), capped at Max()
+    std::uint64_t Quantile(double q) const;
+
+  private:
+    std::array<std::atomic<std::uint64_t>, kNBINS> fBins{};
+    std::atomic<std::uint64_t> fCount{0};
+    std::atomic<std::uint64_t> fSum{0};
+    std::atomic<std::uint64_t> fMin{~std::uint64_t(0)};
+    std::atomic<std::uint64_t> fMax{0};
+  };
+
+  /**
+     \struct FolderMetrics
+     Access metrics of one database folder: the DBFolder fetching its data and
+     the provider building snapshots from them.  Times are in microseconds.
+  */
+  struct FolderMetrics {
+    MetricsHistogram httpTime;      ///< Query of the conditions web server
+    MetricsHistogram sqliteTime;    ///< Query of the SQLite file, decoding included
+    MetricsHistogram bundleTime;    ///< Lookup in the prestaged bundle, decoding included
+    MetricsHistogram parseTime;     ///< Decoding of the web server response
+    MetricsHistogram transferBytes; ///< Size of the server response, maybe compressed
+    MetricsHistogram payloadBytes;  ///< Size of the decoded values
+    MetricsHistogram rows;
+    MetricsHistogram columns;
+    MetricsHistogram rebuildTime; ///< Provider snapshot construction
+    MetricsHistogram shadowTime;  ///< Query of the shadow server (see DBFolder)
+
+    std::atomic<std::uint64_t> updateCalls{0};     ///< DBFolder::UpdateData()
+    std::atomic<std::uint64_t> iovSwitches{0};     ///< Updates loading a new IOV
+    std::atomic<std::uint64_t> sharedFetches{0};   ///< IOVs fetched by another folder
+    std::atomic<std::uint64_t> namedDataCalls{0};  ///< DBFolder::GetNamedChannelData()
+    std::atomic<std::uint64_t> snapshotLookups{0}; ///< Provider SnapshotFor()
+
+    std::atomic<std::uint64_t> shadowComparisons{0}; ///< Updates compared with the shadow
+    std::atomic<std::uint64_t> shadowMismatches{0};  ///< Comparisons finding differences
+    std::atomic<std::uint64_t> shadowErrors{0};      ///< Failed shadow queries
+    std::atomic<std::uint64_t> shadowDropped{0};     ///< Comparisons skipped, queue full
+    std::atomic<std::uint64_t> shadowSlower{0};      ///< Shadow queries slower than primary
+
+    /// Fetch time histogram of the source the folder reads from
+    MetricsHistogram const& FetchTime() const
+    {
+      return httpTime.Count() ? httpTime : (sqliteTime.Count() ? sqliteTime : bundleTime);
+    }
+
+    static void Count(std::atomic<std::uint64_t>& counter)
+    {
+      counter.fetch_add(1, std::memory_order_relaxed);
+    }
+  };
+
+  /**
+     \class ConditionsMetrics
+     Process-wide collection of the FolderMetrics, one per folder name.
+
+     Recording is disabled unless Enable() is called (see
+     ConditionsMetricsService), so that jobs not asking for the metrics pay
+     only a flag check.  Records are never removed, and references to them
+     stay valid for the whole job.
+  */
+  class ConditionsMetrics {
+
+  public:
+    static ConditionsMetrics& Instance();
+
+    static bool Enabled() { return sEnabled.load(std::memory_order_relaxed); }
+    static void Enable(bool enable = true) { sEnabled.store(enable); }
+
+    /// Returns the metrics of the folder, creating them if needed
+    FolderMetrics& Folder(std::string const& name);
+
+    /// Writes a table with one line per folder
+    void WriteSummary(std::ostream& out) const;
+
+    /// Writes all the metrics as a JSON object
+    void WriteJSON(std::ostream& out) const;
+
+  private:
+    ConditionsMetrics() = default;
+
+    static std::atomic<bool> sEnabled;
+
+    std::map<std::string, std::unique_ptr<FolderMetrics>> fFolders;
+    mutable std::mutex fMutex; // Guards fFolders, not the records.
+  };
+
+  /**
+     \class MetricsTimer
+     Fills a histogram with the microseconds elapsed from construction to
+     destruction, if the metrics are enabled.
+  */
+  class MetricsTimer {
+
+  public:
+    using clock_t = std::chrono::steady_clock;
+
+    explicit MetricsTimer(MetricsHistogram& histogram)
+      : fHistogram(ConditionsMetrics::Enabled() ? &histogram : nullptr)
+    {
+      if (fHistogram) fStart = clock_t::now();
+    }
+
+    ~MetricsTimer()
+    {
+      if (!fHistogram) return;
+      auto const elapsed = clock_t::now() - fStart;
+      fHistogram->Fill(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+    }
+
+    MetricsTimer(MetricsTimer const&) = delete;
+    MetricsTimer& operator=(MetricsTimer const&) = delete;
+
+  private:
+    MetricsHistogram* fHistogram;
+    clock_t::time_point fStart;
+  };
+} //end namespace lariov
+
+#endif
+/** @} */ // end of doxygen group
@@ -0,0 +1,292 @@
+#include "ConditionsTrace.h"
+
+// art/LArSoft libraries
+#include "cetlib_except/exception.h"
+
+#include <limits>
+
+namespace lariov {
+
+  std::atomic<bool> ConditionsTrace::sEnabled{false};
+
+  namespace {
+
+    // The buffer is written out when it grows beyond this size.
+    constexpr std::size_t kBUFFER_SIZE = 1 << 20;
+
+    constexpr char const* kSOURCE_NAMES[ConditionsTrace::kNSources] = {"DBFolder",
+                                                                       "DetPedestal",
+                                                                       "ChannelStatus",
+                                                                       "ElectronLifetime",
+                                                                       "ElectronicsCalib",
+                                                                       "PmtGain"};
+
+    constexpr char const* kACCESSOR_NAMES[ConditionsTrace::kNAccessors] = {
+      "UpdateData",   "GetNamedChannelData", "SelectTimeStamp",      "PedMean",
+      "PedRms",       "PedMeanErr",          "PedRmsErr",            "IsPresent",
+      "IsBad",        "IsNoisy",             "IsGood",               "Status",
+      "GoodChannels", "BadChannels",         "NoisyChannels",        "ChannelsWithStatus",
+      "ArePresent",   "AreBad",              "AreNoisy",             "AreGood",
+      "Lifetime",     "Purity",              "LifetimeErr",          "PurityErr",
+      "Attenuation",  "Attenuation (batch)", "ElectronicsGain",      "ElectronicsGainErr",
+      "ShapingTime",  "ShapingTimeErr",      "ElectronicsExtraInfo", "PmtGain",
+      "PmtGainErr",   "PmtExtraInfo"};
+
+  } // anonymous namespace
+
+  char const* ConditionsTrace::SourceName(Source_t source)
+  {
+    return source < kNSources ? kSOURCE_NAMES[source] : "unknown";
+  }
+
+  char const* ConditionsTrace::AccessorName(Accessor_t accessor)
+  {
+    return accessor < kNAccessors ? kACCESSOR_NAMES[accessor] : "unknown";
+  }
+
+  ConditionsTrace& ConditionsTrace::Instance()
+  {
+    static ConditionsTrace trace;
+    return trace;
+  }
+
+  //----------------------------------------------------------------------------
+  void ConditionsTrace::Start(std::string const& path)
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    if (fOut.is_open()) {
+      Flush();
+      fOut.close();
+    }
+    fOut.open(path, std::ios::binary | std::ios::trunc);
+    if (!fOut) throw cet::exception("ConditionsTrace") << "Cannot write the trace to " << path;
+
+    fPath = path;
+    fBuffer.assign(kMagic, sizeof(kMagic));
+    fBuffer.push_back(char(kVersion));
+    fSourceWritten.assign(fSources.size(), false);
+    fColumnIDs.clear();
+    fTime = std::numeric_limits<DBTimeStamp_t>::max(); // Write the first time stamp.
+    fNCalls = 0;
+    sEnabled.store(true);
+  }
+
+  std::uint64_t ConditionsTrace::Stop()
+  {
+    sEnabled.store(false);
+    std::lock_guard<std::mutex> lock(fMutex);
+    if (!fOut.is_open()) return 0;
+    Flush();
+    fOut.close();
+    if (!fOut)
+      throw cet::exception("ConditionsTrace") << "Failed to write the trace to " << fPath;
+    return fNCalls;
+  }
+
+  //----------------------------------------------------------------------------
+  std::uint32_t ConditionsTrace::SourceID(Source_t source,
+                                          std::string const& folder,
+                                          std::string const& tag)
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    auto const [it, added] = fSourceIDs.emplace(SourceKey_t{source, folder, tag}, fSources.size());
+    if (added) {
+      fSources.push_back(it->first);
+      fSourceWritten.push_back(false);
+    }
+    return it->second;
+  }
+
+  //----------------------------------------------------------------------------
+  void ConditionsTrace::Record(std::uint32_t source,
+                               Accessor_t accessor,
+                               DBTimeStamp_t ts,
+                               std::uint32_t value,
+                               std::string const* column)
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    if (!fOut.is_open()) return; // Stopped since the caller checked.
+
+    std::uint32_t columnID = 0;
+    if (column) {
+      auto const [it, added] = fColumnIDs.emplace(*column, fColumnIDs.size());
+      if (added) {
+        fBuffer.push_back(char(kDefineColumn));
+        WriteNumber(it->second);
+        WriteString(*column);
+      }
+      columnID = it->second;
+    }
+
+    WriteHeader(source, accessor, ts);
+    WriteNumber(value);
+    if (column) WriteNumber(columnID);
+    if (fBuffer.size() > kBUFFER_SIZE) Flush();
+  }
+
+  void ConditionsTrace::Record(std::uint32_t source,
+                               Accessor_t accessor,
+                               DBTimeStamp_t ts,
+                               std::uint32_t const* values,
+                               std::size_t n)
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    if (!fOut.is_open()) return;
+
+    WriteHeader(source, accessor, ts);
+    WriteNumber(n);
+    for (std::size_t i = 0; i != n; ++i)
+      WriteNumber(values[i]);
+    if (fBuffer.size() > kBUFFER_SIZE) Flush();
+  }
+
+  //----------------------------------------------------------------------------
+  // Called with the lock held.
+
+  void ConditionsTrace::WriteHeader(std::uint32_t source, Accessor_t accessor, DBTimeStamp_t ts)
+  {
+    if (!fSourceWritten[source]) {
+      auto const& [type, folder, tag] = fSources[source];
+      fBuffer.push_back(char(kDefineSource));
+      WriteNumber(source);
+      fBuffer.push_back(char(type));
+      WriteString(folder);
+      WriteString(tag);
+      fSourceWritten[source] = true;
+    }
+    if (ts != fTime) {
+      fBuffer.push_back(char(kTime));
+      WriteNumber(ts);
+      fTime = ts;
+    }
+    fBuffer.push_back(char(kCall + accessor));
+    WriteNumber(source);
+    ++fNCalls;
+  }
+
+  void ConditionsTrace::WriteNumber(std::uint64_t value)
+  {
+    while (value >= 0x80) {
+      fBuffer.push_back(char(value | 0x80));
+      value >>= 7;
+    }
+    fBuffer.push_back(char(value));
+  }
+
+  void ConditionsTrace::WriteString(std::string const& text)
+  {
+    WriteNumber(text.size());
+    fBuffer += text;
+  }
+
+  void ConditionsTrace::Flush()
+  {
+    fOut.write(fBuffer.data(), fBuffer.size());
+    fBuffer.clear();
+  }
+
+  //----------------------------------------------------------------------------
+  ConditionsTrace::Reader::Reader(std::string const& path)
+    : fPath(path), fIn(path, std::ios::binary)
+  {
+    fIn.seekg(0, std::ios::end);
+    fSize = fIn ? std::uint64_t(fIn.tellg()) : 0;
+    fIn.seekg(0);
+
+    char header[sizeof(kMagic) + 1];
+    if (!fIn.read(header, sizeof(header)) ||
+        std::string(header, sizeof(kMagic)) != std::string(kMagic, sizeof(kMagic))) {
+      throw cet::exception("ConditionsTrace") << path << " is not a conditions trace";
+    }
+    if (std::uint8_t(header[sizeof(kMagic)]) != kVersion) {
+      throw cet::exception("ConditionsTrace")
+        << path << " has trace format version " << int(std::uint8_t(header[sizeof(kMagic)]))
+        << ", expected " << int(kVersion);
+    }
+  }
+
+  bool ConditionsTrace::Reader::Next(Call& call)
+  {
+    while (true) {
+      int const type = fIn.get();
+      if (type == std::char_traits<char>::eof()) return false;
+
+      if (type == kDefineSource) {
+        std::uint64_t const id = ReadNumber();
+        int const source = fIn.get();
+        if (id != fSources.size() || source < 0 || source >= kNSources)
+          throw cet::exception("ConditionsTrace") << "Bad source definition in " << fPath;
+        std::string folder = ReadString();
+        fSources.push_back({Source_t(source), std::move(folder), ReadString()});
+      }
+      else if (type == kDefineColumn) {
+        if (ReadNumber() != fColumns.size())
+          throw cet::exception("ConditionsTrace") << "Bad column definition in " << fPath;
+        fColumns.push_back(ReadString());
+      }
+      else if (type == kTime)
+        fTime = ReadNumber();
+      else if (type >= kCall && type < kCall + kNAccessors) {
+        call.accessor = Accessor_t(type - kCall);
+        call.time = fTime;
+        std::uint64_t const source = ReadNumber();
+        if (source >= fSources.size())
+          throw cet::exception("ConditionsTrace") << "Call to an undefined source in " << fPath;
+        call.source = source;
+        call.value = ReadNumber();
+        call.values.clear();
+        call.column.clear();
+        if (call.accessor == kNamedData) {
+          std::uint64_t const column = ReadNumber();
+          if (column >= fColumns.size())
+            throw cet::exception("ConditionsTrace") << "Undefined column in " << fPath;
+          call.column = fColumns[column];
+        }
+        if (IsBatch(call.accessor)) {
+          // Each value takes at least a byte.
+          if (call.value > Remaining())
+            throw cet::exception("ConditionsTrace") << "Truncated trace " << fPath;
+          call.values.resize(call.value);
+          for (auto& value : call.values)
+            value = ReadNumber();
+        }
+        return true;
+      }
+      else
+        throw cet::exception("ConditionsTrace") << "Bad record type " << type << " in " << fPath;
+    }
+  }
+
+  std::uint64_t ConditionsTrace::Reader::ReadNumber()
+  {
+    std::uint64_t value = 0;
+    for (unsigned int shift = 0; shift < 64; shift += 7) {
+      int const byte = fIn.get();
+      if (byte == std::char_traits<char>::eof())
+        throw cet::exception("ConditionsTrace") << "Truncated trace " << fPath;
+      value |= std::uint64_t(byte & 0x7F) << shift;
+      if (!(byte & 0x80)) return value;
+    }
+    throw cet::exception("ConditionsTrace") << "Bad number in trace " << fPath;
+  }
+
+  // The length is checked before allocating, as a corrupted one may be huge.
+
+  std::string ConditionsTrace::Reader::ReadString()
+  {
+    std::uint64_t const length = ReadNumber();
+    if (length > Remaining())
+      throw cet::exception("ConditionsTrace") << "Truncated trace " << fPath;
+    std::string text(length, '\0');
+    if (!fIn.read(text.data(), text.size()))
+      throw cet::exception("ConditionsTrace") << "Truncated trace " << fPath;
+    return text;
+  }
+
+  std::uint64_t ConditionsTrace::Reader::Remaining()
+  {
+    auto const pos = fIn.tellg();
+    return (pos < 0 || std::uint64_t(pos) > fSize) ? 0 : fSize - std::uint64_t(pos);
+  }
+
+} //end namespace lariov
@@ -0,0 +1,232 @@
+/**
+ * \file ConditionsTrace.h
+ *
+ * \ingroup WebDBI
+ *
+ * \brief Class def header for the conditions access trace
+ */
+
+/** \addtogroup WebDBI
+
+    @{*/
+#ifndef CONDITIONSTRACE_H
+#define CONDITIONSTRACE_H
+
+#include "larevt/CalibrationDBI/Interface/CalibrationDBIFwd.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace lariov {
+
+  /**
+     \class ConditionsTrace
+     Process-wide recorder of the calls to the conditions providers and to the
+     DBFolder objects used on their own, for replaying the same workload
+     later (see replay_conditions_trace).
+
+     Each call is recorded with the event time stamp it applies to, the
+     source (provider type, folder and tag), the accessor and its argument:
+     the channel, a status, or the bits of a drift time.  Calls taking a list
+     of channels or times record the whole list.
+
+     Recording is disabled unless Start() is called (see
+     ConditionsMetricsService), so that other jobs pay only a flag check.
+     While recording, calls from all threads are serialized on one lock.
+
+     The trace file starts with the 8 characters "LARIOVTR" and a version
+     byte, followed by records made of a type byte and unsigned LEB128
+     integers: definitions of the sources and of the column names the first
+     time they are used, a time record when the time stamp changes, and one
+     record per call.
+  */
+  class ConditionsTrace {
+
+  public:
+    /// Type of the object called
+    enum Source_t : std::uint8_t {
+      kFolder, ///< DBFolder used on its own
+      kDetPedestal,
+      kChannelStatus,
+      kElectronLifetime,
+      kElectronicsCalib,
+      kPmtGain,
+      kNSources
+    };
+
+    /// Method called; the argument recorded is the channel unless noted
+    enum Accessor_t : std::uint8_t {
+      kUpdateData,         ///< DBFolder::UpdateData(); no argument
+      kNamedData,          ///< DBFolder::GetNamedChannelData(), with the column name
+      kSelectTime,         ///< SelectTimeStamp(), Update(), UpdateTimeStamp(); no argument
+      kPedMean,
+      kPedRms,
+      kPedMeanErr,
+      kPedRmsErr,
+      kIsPresent,
+      kIsBad,
+      kIsNoisy,
+      kIsGood,
+      kStatus,
+      kGoodChannels,       ///< Channel set, span or mask; no argument
+      kBadChannels,        ///< Channel set, span or mask; no argument
+      kNoisyChannels,      ///< Channel set, span or mask; no argument
+      kChannelsWithStatus, ///< Argument: the status
+      kArePresent,         ///< List of channels
+      kAreBad,             ///< List of channels
+      kAreNoisy,           ///< List of channels
+      kAreGood,            ///< List of channels
+      kLifetime,           ///< Argument: bits of the drift time
+      kPurity,             ///< No argument
+      kLifetimeErr,        ///< Argument: bits of the drift time
+      kPurityErr,          ///< No argument
+      kAttenuation,        ///< Argument: bits of the drift time
+      kAttenuationBatch,   ///< List of the bits of the drift times
+      kElectronicsGain,
+      kElectronicsGainErr,
+      kShapingTime,
+      kShapingTimeErr,
+      kElectronicsExtraInfo,
+      kPmtGainValue,
+      kPmtGainErr,
+      kPmtExtraInfo,
+      kNAccessors
+    };
+
+    /// Whether the accessor takes a list of values
+    static bool IsBatch(Accessor_t accessor)
+    {
+      return (accessor >= kArePresent && accessor <= kAreGood) || accessor == kAttenuationBatch;
+    }
+
+    /// Drift times are recorded by their bit pattern
+    static std::uint32_t FloatBits(float value)
+    {
+      std::uint32_t bits;
+      std::memcpy(&bits, &value, sizeof(bits));
+      return bits;
+    }
+    static float BitsFloat(std::uint32_t bits)
+    {
+      float value;
+      std::memcpy(&value, &bits, sizeof(value));
+      return value;
+    }
+
+    static char const* SourceName(Source_t source);
+    static char const* AccessorName(Accessor_t accessor);
+
+    static constexpr char kMagic[8] = {'L', 'A', 'R', 'I', 'O', 'V', 'T', 'R'};
+    static constexpr std::uint8_t kVersion = 1;
+
+    /// Record types in the file; calls are kCall + accessor
+    enum RecordType_t : std::uint8_t { kDefineSource = 0, kDefineColumn, kTime, kCall = 0x10 };
+
+    static ConditionsTrace& Instance();
+
+    static bool Enabled() { return sEnabled.load(std::memory_order_relaxed); }
+
+    /// Starts recording into a new file; throws cet::exception on failure
+    void Start(std::string const& path);
+
+    /// Stops recording and closes the file; returns the number of calls recorded
+    std::uint64_t Stop();
+
+    /// Returns the identifier of a source, for Record()
+    std::uint32_t SourceID(Source_t source, std::string const& folder, std::string const& tag);
+
+    /// Records a call with one argument
+    void Record(std::uint32_t source,
+                Accessor_t accessor,
+                DBTimeStamp_t ts,
+                std::uint32_t value,
+                std::string const* column = nullptr);
+
+    /// Records a call taking a list of values
+    void Record(std::uint32_t source,
+                Accessor_t accessor,
+                DBTimeStamp_t ts,
+                std::uint32_t const* values,
+                std::size_t n);
+
+    /**
+       \class ConditionsTrace::Reader
+       Reads back a trace file, one call at a time.
+    */
+    class Reader {
+
+    public:
+      struct Source {
+        Source_t type;
+        std::string folder;
+        std::string tag;
+      };
+
+      struct Call {
+        std::uint32_t source;
+        Accessor_t accessor;
+        DBTimeStamp_t time;
+        std::uint32_t value;               ///< Argument; for lists, their size
+        std::vector<std::uint32_t> values; ///< Arguments of the calls taking a list
+        std::string column;                ///< Column of kNamedData calls
+      };
+
+      /// Opens the trace; throws cet::exception if it is not one
+      explicit Reader(std::string const& path);
+
+      /// Reads the next call; returns false at the end of the trace
+      bool Next(Call& call);
+
+      /// Sources defined so far, by identifier
+      std::vector<Source> const& Sources() const { return fSources; }
+
+    private:
+      std::uint64_t ReadNumber();
+      std::string ReadString();
+
+      /// Bytes left to read in the file
+      std::uint64_t Remaining();
+
+      std::string fPath;
+      std::ifstream fIn;
+      std::uint64_t fSize = 0; // Of the file.
+      DBTimeStamp_t fTime = 0;
+      std::vector<Source> fSources;
+      std::vector<std::string> fColumns;
+    };
+
+  private:
+    ConditionsTrace() = default;
+
+    void WriteNumber(std::uint64_t value);
+    void WriteString(std::string const& text);
+    void WriteHeader(std::uint32_t source, Accessor_t accessor, DBTimeStamp_t ts);
+    void Flush();
+
+    static std::atomic<bool> sEnabled;
+
+    using SourceKey_t = std::tuple<Source_t, std::string, std::string>;
+    std::map<SourceKey_t, std::uint32_t> fSourceIDs;
+    std::vector<SourceKey_t> fSources;
+    std::vector<bool> fSourceWritten;                // Defined in the current file.
+    std::map<std::string, std::uint32_t> fColumnIDs; // Defined in the current file.
+
+    std::ofstream fOut;
+    std::string fPath;
+    std::string fBuffer;
+    DBTimeStamp_t fTime = 0;
+    std::uint64_t fNCalls = 0;
+    std::mutex fMutex;
+  };
+} //end namespace lariov
+
+#endif
+/** @} */ // end of doxygen group
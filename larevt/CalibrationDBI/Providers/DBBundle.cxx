@@ -0,0 +1,370 @@
+#include "DBBundle.h"
+
+#include "cetlib_except/exception.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <string_view>
+#include <variant>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+  constexpr char kMAGIC[8] = {'L', 'A', 'R', 'I', 'O', 'V', 'B', 'N'};
+  constexpr std::uint64_t kVERSION = 1;
+
+  // The byte order marker, read back as another value on a host of different endianness.
+  constexpr std::uint64_t kBYTE_ORDER = 0x0102030405060708ULL;
+
+  enum Kind_t : std::uint8_t { kInteger = 0, kReal = 1, kText = 2 };
+
+  struct Header {
+    char magic[8];
+    std::uint64_t version;
+    std::uint64_t byteOrder;
+    std::uint64_t nEntries;
+    std::uint64_t indexOffset;
+    std::uint64_t stringsOffset;
+    std::uint64_t stringsSize;
+    std::uint64_t fileSize;
+  };
+
+  std::size_t Align(std::size_t offset) { return (offset + 7) & ~std::size_t(7); }
+
+  // Appends the encoding of payload values to a buffer.
+
+  template <typename T>
+  void Put(std::string& buffer, T value)
+  {
+    buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+  }
+
+  void PutString(std::string& buffer, const std::string& s)
+  {
+    Put<std::uint32_t>(buffer, s.size());
+    buffer.append(s);
+  }
+
+  std::string EncodePayload(const lariov::DBDataset& data)
+  {
+    std::string buffer;
+    Put<std::uint32_t>(buffer, data.nrows());
+    Put<std::uint32_t>(buffer, data.ncols());
+    for (auto const& name : data.colNames())
+      PutString(buffer, name);
+    for (auto const& type : data.colTypes())
+      PutString(buffer, type);
+    for (auto const channel : data.channels())
+      Put<std::uint32_t>(buffer, channel);
+    for (auto const& value : data.data()) {
+      if (auto const* integer = std::get_if<long>(&value)) {
+        Put<std::uint8_t>(buffer, kInteger);
+        Put<std::int64_t>(buffer, *integer);
+      }
+      else if (auto const* real = std::get_if<double>(&value)) {
+        Put<std::uint8_t>(buffer, kReal);
+        Put<double>(buffer, *real);
+      }
+      else {
+        auto const& text = std::get<std::unique_ptr<std::string>>(value);
+        Put<std::uint8_t>(buffer, kText);
+        PutString(buffer, text ? *text : std::string());
+      }
+    }
+    return buffer;
+  }
+
+  // Reads payload values, checking that they lie within the payload.
+
+  class Cursor {
+  public:
+    Cursor(const char* begin, std::size_t size, const std::string& path)
+      : fPos(begin), fEnd(begin + size), fPath(path)
+    {}
+
+    template <typename T>
+    T Get()
+    {
+      T value;
+      std::memcpy(&value, Take(sizeof(T)), sizeof(T));
+      return value;
+    }
+
+    std::string GetString()
+    {
+      auto const length = Get<std::uint32_t>();
+      return std::string(Take(length), length);
+    }
+
+    const char* Take(std::size_t n)
+    {
+      if (n > std::size_t(fEnd - fPos)) {
+        throw cet::exception("DBBundle") << "Truncated payload in bundle " << fPath << ".\n";
+      }
+      const char* p = fPos;
+      fPos += n;
+      return p;
+    }
+
+  private:
+    const char* fPos;
+    const char* fEnd;
+    const std::string& fPath;
+  };
+
+  std::mutex& OpenMutex()
+  {
+    static std::mutex m;
+    return m;
+  }
+
+} // anonymous namespace
+
+namespace lariov {
+
+  struct DBBundle::IndexEntry {
+    std::uint64_t folderOffset; // In the string table.
+    std::uint64_t folderLength;
+    std::uint64_t tagOffset;
+    std::uint64_t tagLength;
+    std::uint64_t beginStamp;
+    std::uint64_t beginSubStamp;
+    std::uint64_t endStamp;
+    std::uint64_t endSubStamp;
+    std::uint64_t payloadOffset; // From the start of the file.
+    std::uint64_t payloadSize;
+  };
+
+  DBBundle::DBBundle(const std::string& path)
+    : fPath(path)
+    , fBase(nullptr)
+    , fSize(0)
+    , fIndex(nullptr)
+    , fNEntries(0)
+    , fStrings(nullptr)
+    , fStringsSize(0)
+  {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) throw cet::exception("DBBundle") << "Failed to open bundle " << path << ".\n";
+    struct stat st;
+    if (fstat(fd, &st) != 0 || std::size_t(st.st_size) < sizeof(Header)) {
+      close(fd);
+      throw cet::exception("DBBundle") << "File " << path << " is not a conditions bundle.\n";
+    }
+    fSize = st.st_size;
+    void* base = mmap(nullptr, fSize, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+      throw cet::exception("DBBundle") << "Failed to map bundle " << path << ".\n";
+    }
+    fBase = static_cast<const char*>(base);
+
+    Header header;
+    std::memcpy(&header, fBase, sizeof(header));
+    std::string error;
+    if (std::memcmp(header.magic, kMAGIC, sizeof(kMAGIC)) != 0)
+      error = "is not a conditions bundle";
+    else if (header.byteOrder != kBYTE_ORDER)
+      error = "was written on a host of different byte order";
+    else if (header.version != kVERSION)
+      error = "has unsupported version " + std::to_string(header.version);
+    else if (header.fileSize != fSize || header.indexOffset % 8 != 0 ||
+             header.indexOffset > fSize ||
+             header.nEntries > (fSize - header.indexOffset) / sizeof(IndexEntry) ||
+             header.stringsOffset > fSize || header.stringsSize > fSize - header.stringsOffset)
+      error = "is truncated or corrupted";
+    if (!error.empty()) {
+      munmap(const_cast<char*>(fBase), fSize);
+      throw cet::exception("DBBundle") << "Bundle " << path << ' ' << error << ".\n";
+    }
+
+    fIndex = reinterpret_cast<const IndexEntry*>(fBase + header.indexOffset);
+    fNEntries = header.nEntries;
+    fStrings = fBase + header.stringsOffset;
+    fStringsSize = header.stringsSize;
+
+    for (std::size_t i = 0; i < fNEntries; ++i) {
+      auto const& entry = fIndex[i];
+      if (entry.folderOffset > fStringsSize ||
+          entry.folderLength > fStringsSize - entry.folderOffset ||
+          entry.tagOffset > fStringsSize || entry.tagLength > fStringsSize - entry.tagOffset ||
+          entry.payloadOffset > fSize || entry.payloadSize > fSize - entry.payloadOffset) {
+        munmap(const_cast<char*>(fBase), fSize);
+        throw cet::exception("DBBundle") << "Bundle " << path << " is truncated or corrupted.\n";
+      }
+    }
+  }
+
+  DBBundle::~DBBundle()
+  {
+    if (fBase) munmap(const_cast<char*>(fBase), fSize);
+  }
+
+  std::shared_ptr<DBBundle const> DBBundle::Open(const std::string& path)
+  {
+    // Bundles stay mapped while a folder uses them.
+    static std::map<std::string, std::weak_ptr<DBBundle const>> bundles;
+
+    std::lock_guard<std::mutex> lock(OpenMutex());
+    auto& weak = bundles[path];
+    auto bundle = weak.lock();
+    if (!bundle) {
+      bundle = std::make_shared<DBBundle const>(path);
+      weak = bundle;
+    }
+    return bundle;
+  }
+
+  DBBundle::DatasetPtr_t DBBundle::Find(const std::string& folder,
+                                        const std::string& tag,
+                                        const IOVTimeStamp& ts) const
+  {
+    auto const key = [this](const IndexEntry& entry) {
+      return std::make_tuple(std::string_view(fStrings + entry.folderOffset, entry.folderLength),
+                             std::string_view(fStrings + entry.tagOffset, entry.tagLength),
+                             entry.beginStamp,
+                             entry.beginSubStamp);
+    };
+    // Time stamps are compared as (stamp, substamp), as IOVTimeStamp does.
+    std::uint64_t const stamp = ts.Stamp();
+    std::uint64_t const substamp = ts.SubStamp();
+    auto const target =
+      std::make_tuple(std::string_view(folder), std::string_view(tag), stamp, substamp);
+
+    // The last entry of the folder and tag beginning at or before ts.
+    const IndexEntry* end = fIndex + fNEntries;
+    const IndexEntry* it = std::upper_bound(
+      fIndex, end, target, [&key](auto const& t, const IndexEntry& e) { return t < key(e); });
+    if (it == fIndex) return nullptr;
+    --it;
+    if (std::get<0>(key(*it)) != folder || std::get<1>(key(*it)) != tag) return nullptr;
+    if (std::make_pair(stamp, substamp) >= std::make_pair(it->endStamp, it->endSubStamp))
+      return nullptr;
+    return Decode(*it);
+  }
+
+  DBBundle::DatasetPtr_t DBBundle::Decode(const IndexEntry& entry) const
+  {
+    Cursor cursor(fBase + entry.payloadOffset, entry.payloadSize, fPath);
+    std::size_t const nrows = cursor.Get<std::uint32_t>();
+    std::size_t const ncols = cursor.Get<std::uint32_t>();
+
+    // Bounds against corrupted sizes: each channel takes 4 bytes, each column
+    // at least 8 (the lengths of its name and type), and each value at least 1.
+    if (nrows > entry.payloadSize / 4 || ncols > entry.payloadSize / 8 ||
+        nrows * ncols > entry.payloadSize) {
+      throw cet::exception("DBBundle") << "Corrupted payload in bundle " << fPath << ".\n";
+    }
+
+    std::vector<std::string> names(ncols), types(ncols);
+    for (auto& name : names)
+      name = cursor.GetString();
+    for (auto& type : types)
+      type = cursor.GetString();
+    std::vector<DBChannelID_t> channels(nrows);
+    for (auto& channel : channels)
+      channel = cursor.Get<std::uint32_t>();
+
+    std::vector<DBDataset::value_type> values;
+    values.reserve(nrows * ncols);
+    for (std::size_t i = 0; i < nrows * ncols; ++i) {
+      switch (cursor.Get<std::uint8_t>()) {
+      case kInteger: values.emplace_back(static_cast<long>(cursor.Get<std::int64_t>())); break;
+      case kReal: values.emplace_back(cursor.Get<double>()); break;
+      case kText: values.emplace_back(std::make_unique<std::string>(cursor.GetString())); break;
+      default:
+        throw cet::exception("DBBundle") << "Corrupted payload in bundle " << fPath << ".\n";
+      }
+    }
+
+    return std::make_shared<DBDataset const>(IOVTimeStamp(entry.beginStamp, entry.beginSubStamp),
+                                             IOVTimeStamp(entry.endStamp, entry.endSubStamp),
+                                             std::move(names),
+                                             std::move(types),
+                                             std::move(channels),
+                                             std::move(values));
+  }
+
+  //----------------------------------------------------------------------------
+  bool DBBundle::Writer::Add(const std::string& folder,
+                             const std::string& tag,
+                             const DBDataset& data)
+  {
+    Key_t key(folder, tag, data.beginTime());
+    if (fEntries.count(key)) return false;
+
+    std::string payload = EncodePayload(data);
+    auto const [it, inserted] = fPayloadIndex.emplace(std::move(payload), fPayloads.size());
+    if (inserted) fPayloads.push_back(it->first);
+    fEntries.emplace(std::move(key), Entry{data.endTime(), it->second});
+    return true;
+  }
+
+  void DBBundle::Writer::Write(const std::string& path) const
+  {
+    std::string file(sizeof(Header), '\0');
+
+    std::vector<std::uint64_t> payloadOffsets;
+    payloadOffsets.reserve(fPayloads.size());
+    for (auto const& payload : fPayloads) {
+      payloadOffsets.push_back(file.size());
+      file.append(payload);
+      file.resize(Align(file.size()), '\0');
+    }
+
+    // Each folder and tag name is stored once.
+    std::uint64_t const stringsOffset = file.size();
+    std::map<std::string, std::uint64_t> strings;
+    auto const stringOffset = [&](const std::string& s) {
+      auto const [it, inserted] = strings.emplace(s, file.size() - stringsOffset);
+      if (inserted) file.append(s);
+      return it->second;
+    };
+    std::vector<IndexEntry> index;
+    index.reserve(fEntries.size());
+    for (auto const& [key, entry] : fEntries) {
+      auto const& [folder, tag, begin] = key;
+      IndexEntry e;
+      e.folderOffset = stringOffset(folder);
+      e.folderLength = folder.size();
+      e.tagOffset = stringOffset(tag);
+      e.tagLength = tag.size();
+      e.beginStamp = begin.Stamp();
+      e.beginSubStamp = begin.SubStamp();
+      e.endStamp = entry.end.Stamp();
+      e.endSubStamp = entry.end.SubStamp();
+      e.payloadOffset = payloadOffsets[entry.payload];
+      e.payloadSize = fPayloads[entry.payload].size();
+      index.push_back(e);
+    }
+    std::uint64_t const stringsSize = file.size() - stringsOffset;
+    file.resize(Align(file.size()), '\0');
+
+    // fEntries is ordered like the index lookups need.
+    std::uint64_t const indexOffset = file.size();
+    file.append(reinterpret_cast<const char*>(index.data()), index.size() * sizeof(IndexEntry));
+
+    Header header;
+    std::memcpy(header.magic, kMAGIC, sizeof(kMAGIC));
+    header.version = kVERSION;
+    header.byteOrder = kBYTE_ORDER;
+    header.nEntries = index.size();
+    header.indexOffset = indexOffset;
+    header.stringsOffset = stringsOffset;
+    header.stringsSize = stringsSize;
+    header.fileSize = file.size();
+    std::memcpy(file.data(), &header, sizeof(header));
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(file.data(), file.size());
+    out.close();
+    if (!out) throw cet::exception("DBBundle") << "Failed to write bundle " << path << ".\n";
+  }
+
+} //end namespace lariov
@@ -0,0 +1,116 @@
+/**
+ * \file DBBundle.h
+ *
+ * \ingroup WebDBI
+ *
+ * \brief Class def header for a class DBBundle
+ */
+
+/** \addtogroup WebDBI
+
+    @{*/
+#ifndef DBBUNDLE_H
+#define DBBUNDLE_H
+
+#include "larevt/CalibrationDBI/IOVData/IOVTimeStamp.h"
+#include "larevt/CalibrationDBI/Providers/DBDataset.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+namespace lariov {
+
+  /**
+     \class DBBundle
+     Read-only view of a bundle file, holding the data of several database
+     folders and tags for the intervals of validity needed by a set of runs
+     (see the prestage_conditions executable).  DBFolder objects configured
+     with a bundle take their data from it and never access the database.
+
+     The file is mapped in memory, and each lookup decodes only the payload
+     of the interval found.  Layout, in host byte order:
+     - header: magic string, version, number of entries, offsets of the
+       sections;
+     - payloads, each 8-byte aligned: the table of one interval (column names
+       and types, channels, values), stored once however many intervals share
+       the same content;
+     - string table: the folder and tag names;
+     - index: fixed-size entries sorted by folder, tag and begin time, each
+       with the interval of validity and the location of its payload.
+  */
+  class DBBundle {
+
+  public:
+    using DatasetPtr_t = std::shared_ptr<DBDataset const>;
+
+    /// Maps the bundle file; throws cet::exception if it is not a valid bundle
+    explicit DBBundle(const std::string& path);
+    ~DBBundle();
+
+    DBBundle(const DBBundle&) = delete;
+    DBBundle& operator=(const DBBundle&) = delete;
+
+    /// Returns the bundle mapped from path, shared by all its users
+    static std::shared_ptr<DBBundle const> Open(const std::string& path);
+
+    const std::string& Path() const { return fPath; }
+    std::size_t NEntries() const { return fNEntries; }
+
+    /// Returns the data of the folder valid at ts, or nullptr if there is none
+    DatasetPtr_t Find(const std::string& folder,
+                      const std::string& tag,
+                      const IOVTimeStamp& ts) const;
+
+    /**
+       \class DBBundle::Writer
+       Collects the data of folders, then writes them as a bundle file.
+       Payloads with identical content are stored once.
+    */
+    class Writer {
+
+    public:
+      /// Adds the interval of data; returns false if it was already added
+      bool Add(const std::string& folder, const std::string& tag, const DBDataset& data);
+
+      std::size_t NEntries() const { return fEntries.size(); }
+      std::size_t NPayloads() const { return fPayloads.size(); }
+
+      /// Writes the bundle; throws cet::exception on failure
+      void Write(const std::string& path) const;
+
+    private:
+      struct Entry {
+        IOVTimeStamp end;
+        std::size_t payload; // Index in fPayloads.
+      };
+      using Key_t = std::tuple<std::string, std::string, IOVTimeStamp>;
+
+      std::map<Key_t, Entry> fEntries;
+      std::vector<std::string> fPayloads;
+      std::unordered_map<std::string, std::size_t> fPayloadIndex;
+    };
+
+  private:
+    struct IndexEntry;
+
+    /// Decodes the payload of an entry
+    DatasetPtr_t Decode(const IndexEntry& entry) const;
+
+    std::string fPath;
+    const char* fBase;
+    std::size_t fSize;
+    const IndexEntry* fIndex;
+    std::size_t fNEntries;
+    const char* fStrings;
+    std::size_t fStringsSize;
+  };
+} //end namespace lariov
+
+#endif
+/** @} */ // end of doxygen group
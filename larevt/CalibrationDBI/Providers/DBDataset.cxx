@@ -95,63 +95,17 @@ lariov::DBDataset::DBDataset(void* dataset, bool release) : fBeginTime(0, 0), fE
       getStringValue(tup, col, buf, kBUFFER_SIZE, &err);
 
       // Convert string value to DBDataset::value_type (std::variant).
+      // The first column holds the channel numbers.
 
-      if (fColTypes[col] == "integer" || fColTypes[col] == "bigint") {
-        long value = strtol(buf, 0, 10);
-        fData.push_back(value_type(value));
-        //mf::LogInfo("DBDataset") << "DBDataset: row=" << row << ", column=" << col << ", value=" << fData.back()
-        //	<< "\n";
-        if (col == 0) {
-          fChannels.push_back(value);
-          //mf::LogInfo("DBDataset") << "DBDataset: channel=" << fChannels.back() << "\n";
-        }
-      }
-      else if (fColTypes[col] == "real") {
-        double value = strtod(buf, 0);
-        fData.push_back(value_type(value));
-        //mf::LogInfo("DBDataset") << "DBDataset: row=" << row << ", column=" << col << ", value=" << fData.back()
-        //	<< "\n";
-        if (col == 0) {
-          mf::LogError("DBDataset") << "First column has wrong type real."
-                                    << "\n";
-          throw cet::exception("DBDataset") << "First column has wrong type real.";
-        }
-      }
-      else if (fColTypes[col] == "text") {
-        fData.emplace_back(std::make_unique<std::string>(buf));
-        //mf::LogInfo("DBDataset") << "DBDataset: row=" << row << ", column=" << col << ", value=" << fData.back()
-        //	<< "\n";
-        if (col == 0) {
-          mf::LogError("DBDataset") << "First column has wrong type text."
+      fData.push_back(ParseValue(fColTypes[col], buf));
+      if (col == 0) {
+        if (fColTypes[col] != "integer" && fColTypes[col] != "bigint") {
+          mf::LogError("DBDataset") << "First column has wrong type " << fColTypes[col] << "."
                                     << "\n";
-          throw cet::exception("DBDataset") << "First column has wrong type text.";
+          throw cet::exception("DBDataset") << "First column has wrong type " << fColTypes[col]
+                                            << ".";
         }
-      }
-      else if (fColTypes[col] == "boolean") {
-        long value = 0;
-        std::string s = std::string(buf);
-        if (s == "true" || s == "True" || s == "TRUE" || s == "1")
-          value = 1;
-        else if (s == "false" || s == "False" || s == "FALSE" || s == "0")
-          value = 0;
-        else {
-          mf::LogError("DBDataset") << "Unknown string representation of boolean " << s << "\n";
-          throw cet::exception("DBDataset")
-            << "Unknown string representation of boolean " << s << "\n";
-        }
-        fData.push_back(value_type(value));
-        //mf::LogInfo("DBDataset") << "DBDataset: row=" << row << ", column=" << col << ", value=" << fData.back()
-        //	<< "\n";
-        if (col == 0) {
-          mf::LogError("DBDataset") << "First column has wrong type boolean."
-                                    << "\n";
-          throw cet::exception("DBDataset") << "First column has wrong type boolean.";
-        }
-      }
-      else {
-        mf::LogError("DBDataset") << "Unknown datatype = " << fColTypes[col] << "\n";
-        throw cet::exception("DBDataset")
-          << "Unknown datatype = " << fColTypes[col] << ": " << buf << "\n";
+        fChannels.push_back(std::get<long>(fData.back()));
       }
     }
     releaseTuple(tup);
@@ -179,6 +133,25 @@ lariov::DBDataset::DBDataset(const IOVTimeStamp& begin_time,        // IOV begin
   , fData(std::move(data))
 {}
 
+// Convert the text of a value of the given column type.
+
+lariov::DBDataset::value_type lariov::DBDataset::ParseValue(const std::string& type,
+                                                           const char* text)
+{
+  if (type == "integer" || type == "bigint") return value_type(strtol(text, 0, 10));
+  if (type == "real") return value_type(strtod(text, 0));
+  if (type == "text") return value_type(std::make_unique<std::string>(text));
+  if (type == "boolean") {
+    std::string s = std::string(text);
+    if (s == "true" || s == "True" || s == "TRUE" || s == "1") return value_type(1L);
+    if (s == "false" || s == "False" || s == "FALSE" || s == "0") return value_type(0L);
+    mf::LogError("DBDataset") << "Unknown string representation of boolean " << s << "\n";
+    throw cet::exception("DBDataset") << "Unknown string representation of boolean " << s << "\n";
+  }
+  mf::LogError("DBDataset") << "Unknown datatype = " << type << "\n";
+  throw cet::exception("DBDataset") << "Unknown datatype = " << type << ": " << text << "\n";
+}
+
 // Get row number by channel number.
 // Return -1 if not found.
 
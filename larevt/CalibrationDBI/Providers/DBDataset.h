@@ -110,6 +110,11 @@ namespace lariov {
               std::vector<DBChannelID_t>&& channels, // Channels.
               std::vector<value_type>&& data);       // Calibration data (length nchan*ncol).
 
+    // Convert the text of a value of the given column type ("integer",
+    // "bigint", "real", "text" or "boolean").
+
+    static value_type ParseValue(const std::string& type, const char* text);
+
     // Simple accessors.
 
     const IOVTimeStamp& beginTime() const { return fBeginTime; }
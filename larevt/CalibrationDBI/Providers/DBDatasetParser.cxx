@@ -0,0 +1,124 @@
+#include "DBDatasetParser.h"
+#include "WebDBIConstants.h"
+
+#include "cetlib_except/exception.h"
+
+namespace lariov {
+
+  void DBDatasetParser::Reset()
+  {
+    fRow = 0;
+    fInQuotes = false;
+    fQuoteSeen = false;
+    fField.clear();
+    fFields.clear();
+    fBeginTime = IOVTimeStamp(0, 0);
+    fEndTime = IOVTimeStamp(0, 0);
+    fColNames.clear();
+    fColTypes.clear();
+    fChannels.clear();
+    fData.clear();
+  }
+
+  void DBDatasetParser::Feed(const char* data, std::size_t size)
+  {
+    for (const char* c = data; c != data + size; ++c) {
+      if (fInQuotes) {
+        if (fQuoteSeen) {
+          fQuoteSeen = false;
+          if (*c == '"') {
+            fField += '"';
+            continue;
+          }
+          fInQuotes = false; // The quote closed the field; c is parsed below.
+        }
+        else {
+          if (*c == '"')
+            fQuoteSeen = true;
+          else
+            fField += *c;
+          continue;
+        }
+      }
+      switch (*c) {
+      case '"':
+        if (fField.empty())
+          fInQuotes = true;
+        else
+          fField += *c;
+        break;
+      case ',': EndField(); break;
+      case '\n': EndRow(); break;
+      case '\r': break;
+      default: fField += *c;
+      }
+    }
+  }
+
+  DBDataset DBDatasetParser::Finish()
+  {
+    if (fInQuotes && !fQuoteSeen)
+      throw cet::exception("DBDatasetParser") << "Unterminated quoted field.\n";
+    fInQuotes = fQuoteSeen = false;
+    EndRow(); // The last line may have no end of line.
+    if (fRow < kNUMBER_HEADER_ROWS) {
+      throw cet::exception("DBDatasetParser")
+        << "Incomplete response: " << fRow << " header lines out of " << kNUMBER_HEADER_ROWS
+        << ".\n";
+    }
+
+    DBDataset data(fBeginTime,
+                   fEndTime,
+                   std::move(fColNames),
+                   std::move(fColTypes),
+                   std::move(fChannels),
+                   std::move(fData));
+    Reset();
+    return data;
+  }
+
+  void DBDatasetParser::EndField()
+  {
+    fFields.push_back(std::move(fField));
+    fField.clear();
+  }
+
+  void DBDatasetParser::EndRow()
+  {
+    if (fField.empty() && fFields.empty()) return; // Blank line.
+    EndField();
+
+    switch (fRow) {
+    case 0: fBeginTime = IOVTimeStamp::GetFromString(fFields[0]); break;
+    case 1:
+      fEndTime =
+        fFields[0] == "-" ? IOVTimeStamp::MaxTimeStamp() : IOVTimeStamp::GetFromString(fFields[0]);
+      break;
+    case 2: fColNames = std::move(fFields); break;
+    case 3:
+      fColTypes = std::move(fFields);
+      if (fColTypes.size() != fColNames.size()) {
+        throw cet::exception("DBDatasetParser")
+          << fColNames.size() << " column names but " << fColTypes.size() << " column types.\n";
+      }
+      break;
+    default:
+      if (fFields.size() != fColNames.size()) {
+        throw cet::exception("DBDatasetParser")
+          << "Row " << fRow - kNUMBER_HEADER_ROWS << " has " << fFields.size()
+          << " values for " << fColNames.size() << " columns.\n";
+      }
+      // The first column holds the channel numbers.
+      if (fColTypes[0] != "integer" && fColTypes[0] != "bigint") {
+        throw cet::exception("DBDatasetParser")
+          << "First column has wrong type " << fColTypes[0] << ".\n";
+      }
+      for (std::size_t col = 0; col < fFields.size(); ++col)
+        fData.push_back(DBDataset::ParseValue(fColTypes[col], fFields[col].c_str()));
+      fChannels.push_back(std::get<long>(fData[fData.size() - fFields.size()]));
+    }
+    fFields.clear();
+    ++fRow;
+  }
+
+} //end namespace lariov
@@ -0,0 +1,67 @@
+/**
+ * \file DBDatasetParser.h
+ *
+ * \ingroup WebDBI
+ *
+ * \brief Class def header for a class DBDatasetParser
+ */
+
+/** \addtogroup WebDBI
+
+    @{*/
+#ifndef DBDATASETPARSER_H
+#define DBDATASETPARSER_H
+
+#include "larevt/CalibrationDBI/Providers/DBDataset.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace lariov {
+
+  /**
+     \class DBDatasetParser
+     Builds a DBDataset from the body of a conditions web server response, fed
+     in chunks of any size as they arrive, so that a response is decoded while
+     it is transferred.
+
+     The body is the same comma-separated table libwda reads: the IOV begin
+     and end times, the column names and types, then one line per channel.
+     Fields may be enclosed in double quotes, with quotes doubled inside.
+  */
+  class DBDatasetParser {
+
+  public:
+    DBDatasetParser() { Reset(); }
+
+    /// Parses the next chunk of the body; throws cet::exception on bad data
+    void Feed(const char* data, std::size_t size);
+
+    /// Returns the dataset after the whole body was fed
+    DBDataset Finish();
+
+    /// Discards what was parsed, to parse another body
+    void Reset();
+
+  private:
+    void EndField();
+    void EndRow();
+
+    std::size_t fRow; // Index of the row being parsed.
+    bool fInQuotes;
+    bool fQuoteSeen; // In quotes, a quote either closing them or doubled.
+    std::string fField;
+    std::vector<std::string> fFields;
+
+    IOVTimeStamp fBeginTime{0, 0};
+    IOVTimeStamp fEndTime{0, 0};
+    std::vector<std::string> fColNames;
+    std::vector<std::string> fColTypes;
+    std::vector<DBChannelID_t> fChannels;
+    std::vector<DBDataset::value_type> fData;
+  };
+} //end namespace lariov
+
+#endif
+/** @} */ // end of doxygen group
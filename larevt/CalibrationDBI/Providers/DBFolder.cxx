@@ -1,4 +1,7 @@
 #include "DBFolder.h"
+#include "DBDatasetParser.h"
+#include "DBHttpClient.h"
+#include "DBPayloadStore.h"
 #include "WebDBIConstants.h"
 #include "WebError.h"
 #include "larevt/CalibrationDBI/IOVData/TimeStampDecoder.h"
@@ -8,9 +11,131 @@
 #include "messagefacility/MessageLogger/MessageLogger.h"
 #include "sqlite3.h"
 #include "wda.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
 #include <cstring>
+#include <deque>
+#include <functional>
+#include <future>
+#include <map>
+#include <mutex>
 #include <sstream>
 #include <stdlib.h>
+#include <thread>
+
+namespace {
+
+  // Fetch of the data of a folder, shared by all the DBFolder objects reading it.
+  struct Flight {
+    std::shared_ptr<lariov::DBDataset const> data;                        // Latest IOV.
+    std::shared_future<std::shared_ptr<lariov::DBDataset const>> pending; // Fetch in flight.
+  };
+
+  struct FlightTable {
+    std::mutex mutex;
+    std::map<std::string, Flight> folders;
+  };
+
+  FlightTable& Flights()
+  {
+    static FlightTable flights;
+    return flights;
+  }
+
+  bool Covers(const lariov::DBDataset& data, const lariov::IOVTimeStamp& ts)
+  {
+    return ts >= data.beginTime() && ts < data.endTime();
+  }
+
+  // Runs the shadow comparisons one after the other, on a thread of its own.
+  // A job fetches the shadow data and returns the completion reporting the
+  // outcome.  Completions run under the lock, and only until Stop(): once it
+  // returns, nothing is logged any more.  The thread is never joined, since a
+  // running query may take up to kSHADOW_TIMEOUT; it shares the state with
+  // the worker, and is detached at the end of the program.
+  class ShadowWorker {
+
+  public:
+    using Completion_t = std::function<void()>;
+    using Job_t = std::function<Completion_t()>;
+
+    static constexpr std::size_t kMAX_QUEUED = 16;
+
+    ~ShadowWorker()
+    {
+      Stop();
+      if (fThread.joinable()) fThread.detach();
+    }
+
+    // Returns false, dropping the job, if too many are waiting or after Stop().
+    bool Submit(Job_t job)
+    {
+      std::lock_guard<std::mutex> lock(fState->mutex);
+      if (fState->stop || fState->jobs.size() >= kMAX_QUEUED) return false;
+      if (!fThread.joinable()) fThread = std::thread(&ShadowWorker::Run, fState);
+      fState->jobs.push_back(std::move(job));
+      fState->wakeUp.notify_one();
+      return true;
+    }
+
+    // Drops the waiting jobs; waits only for a completion being reported.
+    void Stop()
+    {
+      {
+        std::lock_guard<std::mutex> lock(fState->mutex);
+        fState->stop = true;
+        fState->jobs.clear();
+      }
+      fState->wakeUp.notify_all();
+    }
+
+  private:
+    struct State {
+      std::mutex mutex;
+      std::condition_variable wakeUp;
+      std::deque<Job_t> jobs;
+      bool stop = false;
+    };
+
+    static void Run(std::shared_ptr<State> state)
+    {
+      std::unique_lock<std::mutex> lock(state->mutex);
+      while (true) {
+        state->wakeUp.wait(lock, [&state] { return state->stop || !state->jobs.empty(); });
+        if (state->stop) return;
+        auto job = std::move(state->jobs.front());
+        state->jobs.pop_front();
+        lock.unlock();
+        Completion_t complete = job();
+        lock.lock();
+        if (!state->stop && complete) complete();
+      }
+    }
+
+    std::shared_ptr<State> fState = std::make_shared<State>();
+    std::thread fThread;
+  };
+
+  ShadowWorker& Shadows()
+  {
+    static ShadowWorker shadows;
+    return shadows;
+  }
+
+  // Shorter than the one of the primary fetch, so that a stuck query holds up the next
+  // comparisons for less time.
+  constexpr int kSHADOW_TIMEOUT = 30;
+
+  constexpr std::size_t kMAX_REPORT_LENGTH = 1000;
+
+  long MicrosecondsSince(std::chrono::steady_clock::time_point start)
+  {
+    auto const elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+  }
+
+} // namespace
 
 namespace lariov {
 
@@ -21,7 +146,11 @@ namespace lariov {
                      const std::string& url2,
                      const std::string& tag,
                      bool usesqlite,
-                     bool testmode)
+                     bool testmode,
+                     double shadowfraction,
+                     bool useembedded,
+                     const std::string& bundlefile,
+                     bool uselibwda)
   {
     fFolderName = name;
     fURL = url;
@@ -29,18 +158,38 @@ namespace lariov {
     fTag = tag;
     fUseSQLite = usesqlite;
     fTestMode = testmode;
-    if (fURL[fURL.length() - 1] == '/') { fURL = fURL.substr(0, fURL.length() - 1); }
+    fUseEmbedded = useembedded;
+    fUseLibwda = uselibwda;
+    if (!fURL.empty() && fURL.back() == '/') { fURL = fURL.substr(0, fURL.length() - 1); }
 
     fCachedRowNumber = -1;
     fCachedChannel = 0;
 
     fMaximumTimeout = 4 * 60; //4 minutes
+    fCache = std::make_shared<DBDataset const>();
+    fMetrics = &ConditionsMetrics::Instance().Folder(fFolderName);
+    fTraced = true;
+    fTraceSource = kNoTraceSource;
+    fTraceTime = 0;
 
     // If UsqSQLite is true, hunt for sqlite database file.
     // It is an error if this file can't be found.
 
     //mf::LogInfo("DBFolder") << "DBFolder: Folder name = " << fFolderName << "\n";
-    if (fUseSQLite) {
+    // A bundle file is searched for like the sqlite files, unless given with its path.
+    if (bundlefile != "" && !fUseEmbedded) {
+      std::string bundlepath = bundlefile;
+      if (bundlefile.find('/') == std::string::npos) {
+        cet::search_path sp("FW_SEARCH_PATH");
+        bundlepath = sp.find_file(bundlefile); // Throws exception if not found.
+      }
+      fBundle = DBBundle::Open(bundlepath);
+      mf::LogInfo("DBFolder") << "DBFolder will read the data of " << fFolderName
+                              << " from bundle " << bundlepath << "\n";
+      fTestMode = false;
+    }
+
+    if (fUseSQLite && !fUseEmbedded && !fBundle) {
       std::string dbname = fFolderName + ".db";
       cet::search_path sp("FW_SEARCH_PATH");
       fSQLitePath = sp.find_file(dbname); // Throws exception if not found.
@@ -49,6 +198,26 @@ namespace lariov {
     //else
     //  mf::LogInfo("DBFolder") << "DBFolder: database url = " << fURL << "\n";
 
+    // Shadow mode compares with the second url or, when reading sqlite, with the server.
+
+    fShadowURL = fURL2 != "" ? fURL2 : (fSQLitePath != "" ? fURL : "");
+    while (fShadowURL != "" && fShadowURL.back() == '/')
+      fShadowURL.pop_back();
+    fShadowFraction = std::min(std::max(shadowfraction, 0.), 1.);
+    fShadowCredit = 0.;
+    if (fTestMode || fUseEmbedded || fBundle || fShadowURL == "") fShadowFraction = 0.;
+    if (fShadowFraction > 0.) {
+      mf::LogInfo("DBFolder") << "DBFolder shadow mode, will compare " << fShadowFraction * 100.
+                              << "% of the updates of " << fFolderName << " with " << fShadowURL
+                              << "\n";
+    }
+
+    if (fUseEmbedded) {
+      mf::LogInfo("DBFolder") << "DBFolder will read the data of " << fFolderName
+                              << " embedded in the input files\n";
+      fTestMode = false;
+    }
+
     if (fTestMode && fURL2 != "") {
       mf::LogInfo log("DBFolder");
       log << "\nDBFolder test mode, will compare the following urls data."
@@ -78,6 +247,9 @@ namespace lariov {
 
     int err = 0;
 
+    if (ConditionsMetrics::Enabled()) FolderMetrics::Count(fMetrics->namedDataCalls);
+    if (fTraced && ConditionsTrace::Enabled()) Trace(ConditionsTrace::kNamedData, channel, &name);
+
     // Make sure cached row is valid.
 
     GetRow(channel);
@@ -99,6 +271,9 @@ namespace lariov {
 
     int err = 0;
 
+    if (ConditionsMetrics::Enabled()) FolderMetrics::Count(fMetrics->namedDataCalls);
+    if (fTraced && ConditionsTrace::Enabled()) Trace(ConditionsTrace::kNamedData, channel, &name);
+
     // Make sure cached row is valid.
 
     GetRow(channel);
@@ -121,6 +296,9 @@ namespace lariov {
 
     int err = 0;
 
+    if (ConditionsMetrics::Enabled()) FolderMetrics::Count(fMetrics->namedDataCalls);
+    if (fTraced && ConditionsTrace::Enabled()) Trace(ConditionsTrace::kNamedData, channel, &name);
+
     // Make sure cached row is valid.
 
     GetRow(channel);
@@ -145,6 +323,9 @@ namespace lariov {
 
     int err = 0;
 
+    if (ConditionsMetrics::Enabled()) FolderMetrics::Count(fMetrics->namedDataCalls);
+    if (fTraced && ConditionsTrace::Enabled()) Trace(ConditionsTrace::kNamedData, channel, &name);
+
     // Make sure cached row is valid.
 
     GetRow(channel);
@@ -212,7 +393,7 @@ namespace lariov {
   int DBFolder::GetChannelList(std::vector<DBChannelID_t>& channels) const
   {
 
-    channels = fCache.channels();
+    channels = fCache->channels();
     return 0;
   }
 
@@ -228,7 +409,7 @@ namespace lariov {
 
       // Update cached row number (binary serach).
 
-      int row = fCache.getRowNumber(channel);
+      int row = fCache->getRowNumber(channel);
 
       //  Throw an exception if we didn't find a matching role.
 
@@ -241,7 +422,7 @@ namespace lariov {
 
       fCachedRowNumber = row;
       fCachedChannel = channel;
-      fCachedRow = fCache.getRow(row);
+      fCachedRow = fCache->getRow(row);
     }
   }
 
@@ -249,7 +430,7 @@ namespace lariov {
 
   size_t DBFolder::GetColumn(const std::string& name) const
   {
-    int col = fCache.getColNumber(name);
+    int col = fCache->getColNumber(name);
 
     // See if we found a matching column.
 
@@ -263,10 +444,51 @@ namespace lariov {
     return col;
   }
 
+  // Size of the decoded values, which is close to the one of the payload.
+
+  void DBFolder::RecordPayload(const DBDataset& data) const
+  {
+    size_t bytes = 0;
+    for (auto const& value : data.data()) {
+      auto const* str = std::get_if<std::unique_ptr<std::string>>(&value);
+      bytes += (str && *str) ? (*str)->size() : sizeof(double);
+    }
+    fMetrics->payloadBytes.Fill(bytes);
+    fMetrics->rows.Fill(data.nrows());
+    fMetrics->columns.Fill(data.ncols());
+  }
+
+  // The data stay recorded in the following recording periods for as long as this folder,
+  // or a snapshot built from them, holds the handle (see CacheUse()).
+
+  void DBFolder::RecordCache()
+  {
+    DBPayloadStore& store = DBPayloadStore::Instance();
+    if (store.Recording()) fCacheUse = store.Use(fFolderName, fTag, fCache);
+  }
+
+  // The source is registered at the first call recorded, as tracing may start
+  // after the folder is constructed.
+
+  void DBFolder::Trace(ConditionsTrace::Accessor_t accessor,
+                       DBChannelID_t channel,
+                       const std::string* column)
+  {
+    auto& trace = ConditionsTrace::Instance();
+    if (fTraceSource == kNoTraceSource)
+      fTraceSource = trace.SourceID(ConditionsTrace::kFolder, fFolderName, fTag);
+    trace.Record(fTraceSource, accessor, fTraceTime, channel, column);
+  }
+
   //returns true if an Update is performed, false if not
   bool DBFolder::UpdateData(DBTimeStamp_t raw_time)
   {
 
+    bool const metrics = ConditionsMetrics::Enabled();
+    if (metrics) FolderMetrics::Count(fMetrics->updateCalls);
+    fTraceTime = raw_time;
+    if (fTraced && ConditionsTrace::Enabled()) Trace(ConditionsTrace::kUpdateData, 0);
+
     //convert to IOVTimeStamp
     IOVTimeStamp ts = TimeStampDecoder::DecodeTimeStamp(raw_time);
 
@@ -274,10 +496,142 @@ namespace lariov {
     if (IsValid(ts)) return false;
 
     //release cached data.
-    fCache = DBDataset();
+    fCache = std::make_shared<DBDataset const>();
     fCachedRow = DBDataset::DBRow();
     fCachedRowNumber = -1;
     fCachedChannel = 0;
+    fCacheUse.reset();
+
+    //sample the updates compared in shadow mode
+    bool shadow = false;
+    if (fShadowFraction > 0.) {
+      fShadowCredit += fShadowFraction;
+      shadow = fShadowCredit >= 1.;
+      if (shadow) fShadowCredit -= 1.;
+    }
+    auto const start = std::chrono::steady_clock::now();
+
+    //get new dataset, or the one another caller is fetching for the same IOV
+    //(test mode always fetches its own data)
+    if (fUseEmbedded)
+      fCache = EmbeddedData(ts);
+    else if (fTestMode)
+      fCache = FetchData(raw_time, ts);
+    else
+      fCache = SharedData(raw_time, ts);
+    RecordCache();
+    if (metrics) FolderMetrics::Count(fMetrics->iovSwitches);
+    if (shadow) ScheduleShadow(fCache, ts, MicrosecondsSince(start));
+    //DumpDataset(*fCache);
+
+    // If test mode is selected, get comparison data.
+
+    if (fTestMode) {
+      if (fSQLitePath != "") {
+        DBDataset compare1;
+        mf::LogInfo("DBFolder") << "Accessing comparison data from sqlite database " << fSQLitePath
+                                << "\n";
+        GetSQLiteData(raw_time / 1000000000, compare1);
+        CompareDataset(*fCache, compare1);
+      }
+      if (fURL2 != "") {
+        mf::LogInfo("DBFolder") << "Accessing comparison data from second database url."
+                                << "\n";
+        std::stringstream fullurl2;
+        fullurl2 << fURL2 << "/data?f=" << fFolderName << "&t=" << ts.DBStamp();
+        if (fTag.length() > 0) fullurl2 << "&tag=" << fTag;
+        mf::LogInfo("DBFolder") << "Full url = " << fullurl2.str() << "\n";
+        DBDataset compare2 = Download(fullurl2.str(), fMaximumTimeout, fUseLibwda);
+        CompareDataset(*fCache, compare2);
+      }
+    }
+    return true;
+  }
+
+  // Coalesces the fetches of the folders reading the same data.
+  // The first caller needing an IOV fetches it; callers arriving meanwhile wait for
+  // its result and use it if it covers their time, and later callers reuse it
+  // until a time out of it is requested.
+
+  DBFolder::DatasetPtr_t DBFolder::SharedData(DBTimeStamp_t raw_time, const IOVTimeStamp& ts)
+  {
+    std::string const source =
+      fBundle ? fBundle->Path() : (fSQLitePath != "" ? fSQLitePath : fURL);
+    std::string const key = source + '|' + fFolderName + '|' + fTag;
+
+    std::unique_lock<std::mutex> lock(Flights().mutex);
+    Flight& flight = Flights().folders[key];
+    while (true) {
+      if (flight.data && Covers(*flight.data, ts)) {
+        if (ConditionsMetrics::Enabled()) FolderMetrics::Count(fMetrics->sharedFetches);
+        return flight.data;
+      }
+      if (!flight.pending.valid()) break;
+
+      // Wait for the fetch in flight, then check whether it covers ts.
+      auto pending = flight.pending;
+      lock.unlock();
+      pending.wait();
+      lock.lock();
+    }
+
+    std::promise<DatasetPtr_t> promise;
+    flight.pending = promise.get_future().share();
+    lock.unlock();
+
+    DatasetPtr_t data;
+    try {
+      data = FetchData(raw_time, ts);
+    }
+    catch (...) {
+      lock.lock();
+      flight.pending = {};
+      lock.unlock();
+      promise.set_exception(std::current_exception());
+      throw;
+    }
+
+    lock.lock();
+    flight.data = data;
+    flight.pending = {};
+    lock.unlock();
+    promise.set_value(data);
+    return data;
+  }
+
+  // Takes the data valid at ts from the payloads read from the input files.
+
+  DBFolder::DatasetPtr_t DBFolder::EmbeddedData(const IOVTimeStamp& ts) const
+  {
+    auto data = DBPayloadStore::Instance().Find(fFolderName, fTag, ts);
+    if (!data) {
+      throw cet::exception("DBFolder")
+        << "No embedded payload of folder " << fFolderName << " (tag \"" << fTag
+        << "\") is valid at " << ts.DBStamp()
+        << "; was the input written with CalibrationPayloadWriter?\n";
+    }
+    if (ConditionsMetrics::Enabled()) RecordPayload(*data);
+    return data;
+  }
+
+  // Fetches the data valid at ts from the bundle, the SQLite file or the web server.
+
+  DBFolder::DatasetPtr_t DBFolder::FetchData(DBTimeStamp_t raw_time, const IOVTimeStamp& ts) const
+  {
+    if (fBundle) {
+      DatasetPtr_t data;
+      {
+        MetricsTimer timer(fMetrics->bundleTime);
+        data = fBundle->Find(fFolderName, fTag, ts);
+      }
+      if (!data) {
+        throw cet::exception("DBFolder")
+          << "No data of folder " << fFolderName << " (tag \"" << fTag << "\") valid at "
+          << ts.DBStamp() << " in bundle " << fBundle->Path() << "\n";
+      }
+      if (ConditionsMetrics::Enabled()) RecordPayload(*data);
+      return data;
+    }
 
     //get full url string
     std::stringstream fullurl;
@@ -289,8 +643,11 @@ namespace lariov {
     //log << "t=" << raw_time/1000000000 << "\n";
     //log << "Full url = " << fullurl.str() << "\n";
 
-    //get new dataset
-    if (fSQLitePath != "" && !fTestMode) { GetSQLiteData(raw_time / 1000000000, fCache); }
+    auto fetched = std::make_shared<DBDataset>();
+    if (fSQLitePath != "" && !fTestMode) {
+      MetricsTimer timer(fMetrics->sqliteTime);
+      GetSQLiteData(raw_time / 1000000000, *fetched);
+    }
     else {
       if (fTestMode) {
         mf::LogInfo log("DBFolder");
@@ -298,50 +655,98 @@ namespace lariov {
             << "\n";
         log << "Folder = " << fFolderName << "\n";
       }
+      *fetched = Download(fullurl.str(), fMaximumTimeout, fUseLibwda, fMetrics);
+    }
+    if (ConditionsMetrics::Enabled()) RecordPayload(*fetched);
+    return fetched;
+  }
+
+  // Queries the web server, through the pooled client or libwda.
+  // The metrics, if given, get the query time and the decoding time apart.
+
+  DBDataset DBFolder::Download(const std::string& url,
+                               int timeout,
+                               bool uselibwda,
+                               FolderMetrics* metrics)
+  {
+    bool const record = metrics && ConditionsMetrics::Enabled();
+    auto const start = std::chrono::steady_clock::now();
+
+    if (uselibwda) {
       int err = 0;
-      Dataset data = getDataWithTimeout(fullurl.str().c_str(), NULL, fMaximumTimeout, &err);
+      Dataset data = getDataWithTimeout(url.c_str(), NULL, timeout, &err);
+      if (record) metrics->httpTime.Fill(MicrosecondsSince(start));
       int status = getHTTPstatus(data);
       if (status != 200) {
-        std::string msg = "HTTP error from " + fullurl.str() +
-                          ": status: " + std::to_string(status) + ": " +
-                          std::string(getHTTPmessage(data));
+        std::string msg = "HTTP error from " + url + ": status: " + std::to_string(status) +
+                          ": " + std::string(getHTTPmessage(data));
+        releaseDataset(data);
         throw WebError(msg);
       }
-      fCache = DBDataset(data, true);
+      auto const parseStart = std::chrono::steady_clock::now();
+      DBDataset dataset(data, true);
+      if (record) metrics->parseTime.Fill(MicrosecondsSince(parseStart));
+      return dataset;
     }
-    //DumpDataset(fCache);
 
-    // If test mode is selected, get comparison data.
+    DBDatasetParser parser;
+    auto const response = DBHttpClient::Instance().Get(url, timeout, parser);
+    if (record) {
+      metrics->httpTime.Fill(std::max(MicrosecondsSince(start) - response.parseTime, 0L));
+      metrics->parseTime.Fill(response.parseTime);
+      metrics->transferBytes.Fill(response.transferBytes);
+    }
+    if (response.status != 200) {
+      throw WebError("HTTP error from " + url + ": status: " + std::to_string(response.status) +
+                     ": " + response.message);
+    }
+    return parser.Finish();
+  }
 
-    if (fTestMode) {
-      if (fSQLitePath != "") {
-        DBDataset compare1;
-        mf::LogInfo("DBFolder") << "Accessing comparison data from sqlite database " << fSQLitePath
-                                << "\n";
-        GetSQLiteData(raw_time / 1000000000, compare1);
-        CompareDataset(fCache, compare1);
+  // The comparison runs off the event loop, and its outcome goes to the metrics only.
+
+  void DBFolder::ScheduleShadow(DatasetPtr_t data, const IOVTimeStamp& ts, long fetchTime) const
+  {
+    std::stringstream url;
+    url << fShadowURL << "/data?f=" << fFolderName << "&t=" << ts.DBStamp();
+    if (fTag.length() > 0) url << "&tag=" << fTag;
+
+    FolderMetrics* metrics = fMetrics;
+    auto compare = [url = url.str(), data = std::move(data), folder = fFolderName, metrics,
+                    fetchTime, uselibwda = fUseLibwda]() -> ShadowWorker::Completion_t {
+      try {
+        auto const start = std::chrono::steady_clock::now();
+        auto shadowData =
+          std::make_shared<DBDataset>(Download(url, kSHADOW_TIMEOUT, uselibwda));
+        long const shadowTime = MicrosecondsSince(start);
+        return [data, shadowData, folder, metrics, fetchTime, shadowTime] {
+          metrics->shadowTime.Fill(shadowTime);
+          if (shadowTime > fetchTime) FolderMetrics::Count(metrics->shadowSlower);
+
+          std::ostringstream report;
+          FolderMetrics::Count(metrics->shadowComparisons);
+          if (!MatchDatasets(*data, *shadowData, &report)) {
+            FolderMetrics::Count(metrics->shadowMismatches);
+            mf::LogWarning("DBFolder") << "Shadow comparison of folder " << folder << " failed.\n"
+                                       << report.str().substr(0, kMAX_REPORT_LENGTH);
+          }
+        };
       }
-      if (fURL2 != "") {
-        mf::LogInfo("DBFolder") << "Accessing comparison data from second database url."
-                                << "\n";
-        std::stringstream fullurl2;
-        fullurl2 << fURL2 << "/data?f=" << fFolderName << "&t=" << ts.DBStamp();
-        if (fTag.length() > 0) fullurl2 << "&tag=" << fTag;
-        mf::LogInfo("DBFolder") << "Full url = " << fullurl2.str() << "\n";
-        int err = 0;
-        Dataset data = getDataWithTimeout(fullurl2.str().c_str(), NULL, fMaximumTimeout, &err);
-        int status = getHTTPstatus(data);
-        if (status != 200) {
-          std::string msg = "HTTP error from " + fullurl2.str() +
-                            ": status: " + std::to_string(status) + ": " +
-                            std::string(getHTTPmessage(data));
-          throw WebError(msg);
-        }
-        DBDataset compare2(data, true);
-        CompareDataset(fCache, compare2);
+      catch (std::exception const& e) {
+        return [folder, metrics, what = std::string(e.what())] {
+          FolderMetrics::Count(metrics->shadowErrors);
+          mf::LogWarning("DBFolder") << "Shadow comparison of folder " << folder
+                                     << " not done: " << what;
+        };
       }
-    }
-    return true;
+    };
+
+    if (!Shadows().Submit(std::move(compare))) FolderMetrics::Count(fMetrics->shadowDropped);
+  }
+
+  void DBFolder::StopShadowComparisons()
+  {
+    Shadows().Stop();
   }
 
   // Query data from sqlite database.
@@ -770,28 +1175,60 @@ namespace lariov {
 
   bool DBFolder::CompareDataset(const DBDataset& data1, const DBDataset& data2) const
   {
-    bool compare_ok = true;
     mf::LogInfo("DBFolder") << "\nComparing datasets."
                             << "\n";
 
+    std::ostringstream report;
+    bool compare_ok = MatchDatasets(data1, data2, &report);
+    if (!report.str().empty()) mf::LogWarning("DBFolder") << report.str();
+
+    if (compare_ok) {
+      mf::LogInfo("DBFolder") << "Comparison OK.\n"
+                              << "\n";
+    }
+    else {
+      mf::LogError("DBFolder") << "Comparison fail."
+                               << "\n";
+      throw cet::exception("DBFolder") << "Comparison fail.";
+    }
+    return compare_ok;
+  }
+
+  // Mismatches are described in report, if not null.
+
+  bool DBFolder::MatchDatasets(const DBDataset& data1,
+                               const DBDataset& data2,
+                               std::ostream* report)
+  {
+    bool compare_ok = true;
+
     size_t nrows1 = data1.nrows();
     size_t nrows2 = data2.nrows();
     //mf::LogInfo log("DBFolder");
     //log << "Dataset 1 contains " << nrows1 << " rows." << "\n";
     //log << "Dataset 2 contains " << nrows2 << " rows." << "\n";
-    if (nrows1 != nrows2) compare_ok = false;
+    if (nrows1 != nrows2) {
+      if (report) *report << "Rows mismatch " << nrows1 << " vs. " << nrows2 << "\n";
+      compare_ok = false;
+    }
 
     // Compare begin time.
 
     std::string begin1 = data1.beginTime().DBStamp();
     std::string begin2 = data2.beginTime().DBStamp();
-    if (begin1 != begin2) compare_ok = false;
+    if (begin1 != begin2) {
+      if (report) *report << "Begin time mismatch " << begin1 << " vs. " << begin2 << "\n";
+      compare_ok = false;
+    }
 
     // Compare end time.
 
-    std::string end1 = data1.beginTime().DBStamp();
-    std::string end2 = data2.beginTime().DBStamp();
-    if (end1 != end2) compare_ok = false;
+    std::string end1 = data1.endTime().DBStamp();
+    std::string end2 = data2.endTime().DBStamp();
+    if (end1 != end2) {
+      if (report) *report << "End time mismatch " << end1 << " vs. " << end2 << "\n";
+      compare_ok = false;
+    }
 
     // Compare column names.
 
@@ -800,15 +1237,14 @@ namespace lariov {
     const std::vector<std::string>& names1 = data1.colNames();
     const std::vector<std::string>& names2 = data2.colNames();
     if (ncols1 != ncols2 || ncols1 != names1.size() || ncols2 != names2.size()) {
-      mf::LogWarning("DBFolder") << "Columns names size mismatch " << ncols1 << " vs. " << ncols2
-                                 << " vs. " << names1.size() << " vs. " << names2.size() << "\n";
+      if (report) *report << "Columns names size mismatch " << ncols1 << " vs. " << ncols2
+                          << " vs. " << names1.size() << " vs. " << names2.size() << "\n";
       compare_ok = false;
     }
     if (compare_ok) {
       for (size_t c = 0; c < ncols1; ++c) {
         if (names1[c] != names2[c]) {
-          mf::LogWarning("DBFolder")
-            << "Name mismatch " << names1[c] << " vs. " << names2[c] << "\n";
+          if (report) *report << "Name mismatch " << names1[c] << " vs. " << names2[c] << "\n";
           compare_ok = false;
         }
       }
@@ -819,8 +1255,8 @@ namespace lariov {
     const std::vector<std::string>& types1 = data1.colTypes();
     const std::vector<std::string>& types2 = data2.colTypes();
     if (ncols1 != ncols2 || ncols1 != types1.size() || ncols2 != types2.size()) {
-      mf::LogWarning("DBFolder") << "Column types ize mismatch " << ncols1 << " vs. " << ncols2
-                                 << " vs. " << types1.size() << " vs. " << types2.size() << "\n";
+      if (report) *report << "Column types ize mismatch " << ncols1 << " vs. " << ncols2
+                          << " vs. " << types1.size() << " vs. " << types2.size() << "\n";
       compare_ok = false;
     }
     if (compare_ok) {
@@ -834,7 +1270,7 @@ namespace lariov {
         if (type1 == "bigint" || type1 == "boolean") type1 = "integer";
         if (type2 == "bigint" || type2 == "boolean") type2 = "integer";
         if (type1 != type2) {
-          mf::LogWarning("DBFolder") << "Type mismatch " << type1 << " vs. " << type2 << "\n";
+          if (report) *report << "Type mismatch " << type1 << " vs. " << type2 << "\n";
           compare_ok = false;
         }
       }
@@ -845,15 +1281,15 @@ namespace lariov {
     const std::vector<DBChannelID_t>& channels1 = data1.channels();
     const std::vector<DBChannelID_t>& channels2 = data2.channels();
     if (nrows1 != nrows2 || nrows1 != channels1.size() || nrows2 != channels2.size()) {
-      mf::LogWarning("DBFolder") << "Channels size mismatch " << nrows1 << " vs. " << nrows2
-                                 << " vs. " << channels1.size() << " vs. " << channels2.size()
-                                 << "\n";
+      if (report) *report << "Channels size mismatch " << nrows1 << " vs. " << nrows2
+                          << " vs. " << channels1.size() << " vs. " << channels2.size()
+                          << "\n";
       compare_ok = false;
     }
     if (compare_ok) {
       for (size_t r = 0; r < nrows1; ++r) {
         if (channels1[r] != channels2[r]) {
-          mf::LogWarning("DBFolder")
+          if (report) *report
             << "Channel mismatch " << channels1[r] << " vs. " << channels2[r] << "\n";
           compare_ok = false;
         }
@@ -863,8 +1299,8 @@ namespace lariov {
     // Compare number of values.
 
     if (data1.data().size() != data2.data().size()) {
-      mf::LogWarning("DBFolder") << "Values size mismatch " << data1.data().size() << " vs. "
-                                 << data2.data().size() << "\n";
+      if (report) *report << "Values size mismatch " << data1.data().size() << " vs. "
+                          << data2.data().size() << "\n";
       compare_ok = false;
     }
 
@@ -886,8 +1322,7 @@ namespace lariov {
             //log << names1[col] << " 1 = " << value1 << "\n";
             //log << names2[col] << " 2 = " << value2 << "\n";
             if (value1 != value2) {
-              mf::LogWarning("DBFolder")
-                << "Value mismatch " << value1 << " vs. " << value2 << "\n";
+              if (report) *report << "Value mismatch " << value1 << " vs. " << value2 << "\n";
               compare_ok = false;
             }
           }
@@ -898,17 +1333,15 @@ namespace lariov {
             //log << names1[col] << " 1 = " << value1 << "\n";
             //log << names2[col] << " 2 = " << value2 << "\n";
             if (value1 != value2) {
-              mf::LogWarning("DBFolder")
-                << "Value mismatch " << value1 << " vs. " << value2 << "\n";
+              if (report) *report << "Value mismatch " << value1 << " vs. " << value2 << "\n";
               compare_ok = false;
             }
           }
           else if (types1[col] == "text") {
-            std::string value1 = dbrow2.getStringData(col);
+            std::string value1 = dbrow1.getStringData(col);
             std::string value2 = dbrow2.getStringData(col);
             if (value1 != value2) {
-              mf::LogWarning("DBFolder")
-                << "Value mismatch " << value1 << " vs. " << value2 << "\n";
+              if (report) *report << "Value mismatch " << value1 << " vs. " << value2 << "\n";
               compare_ok = false;
             }
           }
@@ -920,15 +1353,6 @@ namespace lariov {
       }
     }
 
-    if (compare_ok) {
-      mf::LogInfo("DBFolder") << "Comparison OK.\n"
-                              << "\n";
-    }
-    else {
-      mf::LogError("DBFolder") << "Comparison fail."
-                               << "\n";
-      throw cet::exception("DBFolder") << "Comparison fail.";
-    }
     return compare_ok;
   }
 
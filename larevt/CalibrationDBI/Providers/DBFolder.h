@@ -3,7 +3,12 @@
 
 #include "larevt/CalibrationDBI/IOVData/IOVTimeStamp.h"
 #include "larevt/CalibrationDBI/Interface/CalibrationDBIFwd.h"
+#include "larevt/CalibrationDBI/Providers/ConditionsMetrics.h"
+#include "larevt/CalibrationDBI/Providers/ConditionsTrace.h"
+#include "larevt/CalibrationDBI/Providers/DBBundle.h"
 #include "larevt/CalibrationDBI/Providers/DBDataset.h"
+#include <iosfwd>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -20,7 +25,11 @@ namespace lariov {
              const std::string& url2,
              const std::string& tag = "",
              bool useqlite = false,
-             bool testmode = false);
+             bool testmode = false,
+             double shadowfraction = 0.,
+             bool useembedded = false,
+             const std::string& bundlefile = "",
+             bool uselibwda = true);
     virtual ~DBFolder();
 
     int GetNamedChannelData(DBChannelID_t channel, const std::string& name, bool& data);
@@ -33,8 +42,22 @@ namespace lariov {
     const std::string& FolderName() const { return fFolderName; }
     const std::string& Tag() const { return fTag; }
 
-    const IOVTimeStamp& CachedStart() const { return fCache.beginTime(); }
-    const IOVTimeStamp& CachedEnd() const { return fCache.endTime(); }
+    const IOVTimeStamp& CachedStart() const { return fCache->beginTime(); }
+    const IOVTimeStamp& CachedEnd() const { return fCache->endTime(); }
+
+    /// Data of the current interval of validity, valid until the next UpdateData()
+    const DBDataset& CachedData() const { return *fCache; }
+
+    /// Handle keeping CachedData() recorded while held, or nullptr when not
+    /// recording (see DBPayloadStore::Use())
+    const std::shared_ptr<void const>& CacheUse() const { return fCacheUse; }
+
+    /// Access metrics of this folder (see ConditionsMetrics)
+    FolderMetrics& Metrics() const { return *fMetrics; }
+
+    /// Whether calls are recorded in the conditions trace (see ConditionsTrace);
+    /// providers disable it for their folder and record their own calls
+    void SetTraced(bool traced) { fTraced = traced; }
 
     bool UpdateData(DBTimeStamp_t raw_time);
 
@@ -46,13 +69,54 @@ namespace lariov {
 
     bool CompareDataset(const DBDataset& data1, const DBDataset& data2) const;
 
+    /// Returns whether the datasets hold the same data, describing the differences in report
+    static bool MatchDatasets(const DBDataset& data1,
+                              const DBDataset& data2,
+                              std::ostream* report = nullptr);
+
+    /// Stops the shadow comparisons of all the folders: queued ones are dropped,
+    /// and running ones report nothing.  To be called at the end of the job, while
+    /// the message logger is still available.
+    static void StopShadowComparisons();
+
   private:
+    using DatasetPtr_t = std::shared_ptr<DBDataset const>;
+
+    /// Returns the data valid at ts, waiting for or reusing the fetch of another folder
+    DatasetPtr_t SharedData(DBTimeStamp_t raw_time, const IOVTimeStamp& ts);
+
+    /// Returns the embedded data valid at ts (see DBPayloadStore)
+    DatasetPtr_t EmbeddedData(const IOVTimeStamp& ts) const;
+
+    /// Fetches the data valid at ts
+    DatasetPtr_t FetchData(DBTimeStamp_t raw_time, const IOVTimeStamp& ts) const;
+
+    /// Queries the web server at url, throwing WebError on failure
+    static DBDataset Download(const std::string& url,
+                              int timeout,
+                              bool uselibwda,
+                              FolderMetrics* metrics = nullptr);
+
+    /// Queues the comparison of data with the ones of the shadow source
+    void ScheduleShadow(DatasetPtr_t data, const IOVTimeStamp& ts, long fetchTime) const;
+
     void GetRow(DBChannelID_t channel);
     size_t GetColumn(const std::string& name) const;
 
+    /// Fills the size metrics of a newly loaded dataset
+    void RecordPayload(const DBDataset& data) const;
+
+    /// Records the cached data in DBPayloadStore, if it is recording
+    void RecordCache();
+
+    /// Records a call in the conditions trace
+    void Trace(ConditionsTrace::Accessor_t accessor,
+               DBChannelID_t channel,
+               const std::string* column = nullptr);
+
     bool IsValid(const IOVTimeStamp& time) const
     {
-      if (time >= fCache.beginTime() && time < fCache.endTime())
+      if (time >= fCache->beginTime() && time < fCache->endTime())
         return true;
       else
         return false;
@@ -66,10 +130,26 @@ namespace lariov {
     bool fTestMode;
     std::string fSQLitePath;
     int fMaximumTimeout;
+    std::string fShadowURL;  // Server the data are compared with (shadow mode).
+    double fShadowFraction;  // Fraction of the updates compared (shadow mode).
+    double fShadowCredit;    // Accumulates fShadowFraction until an update is sampled.
+    bool fUseEmbedded;       // Reads the payloads embedded in the input (see DBPayloadStore).
+    std::shared_ptr<DBBundle const> fBundle; // Prestaged data, replacing the database.
+    bool fUseLibwda;         // Queries the server with libwda, else with DBHttpClient.
+    FolderMetrics* fMetrics; // Shared by the folders with the same name.
+
+    std::shared_ptr<void const> fCacheUse; // Keeps the cache recorded (see DBPayloadStore).
+
+    // Conditions trace.
+
+    static constexpr std::uint32_t kNoTraceSource = ~std::uint32_t(0);
+    bool fTraced;               // Records the calls, when tracing is enabled.
+    std::uint32_t fTraceSource; // Identifier in the trace, or kNoTraceSource if none yet.
+    DBTimeStamp_t fTraceTime;   // Time stamp of the latest UpdateData().
 
     // Database cache.
 
-    DBDataset fCache;
+    DatasetPtr_t fCache; // Possibly shared with other folders (see SharedData()).
 
     // Database row cache.
 
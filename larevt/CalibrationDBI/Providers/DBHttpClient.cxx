@@ -0,0 +1,179 @@
+#include "DBHttpClient.h"
+#include "DBDatasetParser.h"
+
+#include <curl/curl.h>
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <thread>
+
+namespace {
+
+  using ShareMutexes_t = std::array<std::mutex, 8>;
+
+  void LockShare(CURL*, curl_lock_data data, curl_lock_access, void* mutexes)
+  {
+    auto& m = *static_cast<ShareMutexes_t*>(mutexes);
+    m[data % m.size()].lock();
+  }
+
+  void UnlockShare(CURL*, curl_lock_data data, void* mutexes)
+  {
+    auto& m = *static_cast<ShareMutexes_t*>(mutexes);
+    m[data % m.size()].unlock();
+  }
+
+  // Largest part of an error response kept in the message.
+  constexpr std::size_t kMAX_MESSAGE_LENGTH = 1024;
+
+  // Longest delay between retries, in seconds.
+  constexpr int kMAX_RETRY_DELAY = 30;
+
+  // State of one transfer, shared with the write callback.
+  struct Transfer {
+    CURL* handle = nullptr;
+    lariov::DBDatasetParser* parser = nullptr;
+    long status = 0;
+    std::string errorBody;
+    long parseTime = 0;
+    std::exception_ptr error;
+  };
+
+  // Sends the body of successful responses to the parser, keeps the start of the others.
+  std::size_t Write(char* data, std::size_t size, std::size_t n, void* userdata)
+  {
+    auto& transfer = *static_cast<Transfer*>(userdata);
+    std::size_t const bytes = size * n;
+    if (transfer.status == 0)
+      curl_easy_getinfo(transfer.handle, CURLINFO_RESPONSE_CODE, &transfer.status);
+    if (transfer.status != 200) {
+      std::size_t const kept = std::min(kMAX_MESSAGE_LENGTH, transfer.errorBody.size());
+      transfer.errorBody.append(data, std::min(kMAX_MESSAGE_LENGTH - kept, bytes));
+      return bytes;
+    }
+    try {
+      auto const start = std::chrono::steady_clock::now();
+      transfer.parser->Feed(data, bytes);
+      transfer.parseTime += std::chrono::duration_cast<std::chrono::microseconds>(
+                              std::chrono::steady_clock::now() - start)
+                              .count();
+    }
+    catch (...) {
+      // Exceptions must not cross libcurl; this aborts the transfer.
+      transfer.error = std::current_exception();
+      return 0;
+    }
+    return bytes;
+  }
+
+} // anonymous namespace
+
+namespace lariov {
+
+  DBHttpClient& DBHttpClient::Instance()
+  {
+    static DBHttpClient* client = new DBHttpClient;
+    return *client;
+  }
+
+  DBHttpClient::DBHttpClient()
+  {
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+    fShare = curl_share_init();
+    curl_share_setopt(fShare, CURLSHOPT_LOCKFUNC, LockShare);
+    curl_share_setopt(fShare, CURLSHOPT_UNLOCKFUNC, UnlockShare);
+    curl_share_setopt(fShare, CURLSHOPT_USERDATA, &fShareMutexes);
+    curl_share_setopt(fShare, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+    curl_share_setopt(fShare, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+    curl_share_setopt(fShare, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+  }
+
+  void* DBHttpClient::AcquireHandle()
+  {
+    {
+      std::lock_guard<std::mutex> lock(fPoolMutex);
+      if (!fIdleHandles.empty()) {
+        void* handle = fIdleHandles.back();
+        fIdleHandles.pop_back();
+        return handle;
+      }
+    }
+
+    CURL* handle = curl_easy_init();
+    curl_easy_setopt(handle, CURLOPT_SHARE, fShare);
+    curl_easy_setopt(handle, CURLOPT_ACCEPT_ENCODING, ""); // All the encodings supported.
+    curl_easy_setopt(handle, CURLOPT_TCP_KEEPALIVE, 1L);
+    curl_easy_setopt(handle, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(handle, CURLOPT_FOLLOWLOCATION, 1L);
+    curl_easy_setopt(handle, CURLOPT_WRITEFUNCTION, Write);
+    return handle;
+  }
+
+  void DBHttpClient::ReleaseHandle(void* handle)
+  {
+    std::lock_guard<std::mutex> lock(fPoolMutex);
+    fIdleHandles.push_back(handle);
+  }
+
+  DBHttpClient::Response DBHttpClient::Get(const std::string& url,
+                                           int timeout,
+                                           DBDatasetParser& parser)
+  {
+    using clock = std::chrono::steady_clock;
+    auto const deadline = clock::now() + std::chrono::seconds(timeout);
+
+    // The handle returns to the pool however the query ends.
+    struct Handle {
+      DBHttpClient& client;
+      CURL* curl;
+      ~Handle()
+      {
+        curl_easy_setopt(curl, CURLOPT_ERRORBUFFER, nullptr);
+        curl_easy_setopt(curl, CURLOPT_WRITEDATA, nullptr);
+        client.ReleaseHandle(curl);
+      }
+    } handle{*this, static_cast<CURL*>(AcquireHandle())};
+
+    char errorBuffer[CURL_ERROR_SIZE];
+    curl_easy_setopt(handle.curl, CURLOPT_URL, url.c_str());
+    curl_easy_setopt(handle.curl, CURLOPT_ERRORBUFFER, errorBuffer);
+
+    Response response;
+    int delay = 1;
+    while (true) {
+      auto const remaining =
+        std::chrono::duration_cast<std::chrono::milliseconds>(deadline - clock::now()).count();
+      Transfer transfer;
+      transfer.handle = handle.curl;
+      transfer.parser = &parser;
+      parser.Reset();
+      errorBuffer[0] = '\0';
+      curl_easy_setopt(handle.curl, CURLOPT_WRITEDATA, &transfer);
+      curl_easy_setopt(handle.curl, CURLOPT_TIMEOUT_MS, std::max(remaining, 1L));
+
+      CURLcode const result = curl_easy_perform(handle.curl);
+      if (transfer.error) std::rethrow_exception(transfer.error);
+
+      curl_off_t bytes = 0;
+      curl_easy_getinfo(handle.curl, CURLINFO_SIZE_DOWNLOAD_T, &bytes);
+      response.transferBytes += bytes;
+      response.parseTime += transfer.parseTime;
+      response.status = 0;
+      if (result == CURLE_OK) {
+        curl_easy_getinfo(handle.curl, CURLINFO_RESPONSE_CODE, &response.status);
+        response.message = response.status == 200 ? "" : transfer.errorBody;
+        if (response.status < 500) return response;
+      }
+      else {
+        response.message = errorBuffer[0] ? errorBuffer : curl_easy_strerror(result);
+      }
+
+      // Retry while the timeout allows.
+      if (clock::now() + std::chrono::seconds(delay) >= deadline) return response;
+      std::this_thread::sleep_for(std::chrono::seconds(delay));
+      delay = std::min(2 * delay, kMAX_RETRY_DELAY);
+    }
+  }
+
+} //end namespace lariov
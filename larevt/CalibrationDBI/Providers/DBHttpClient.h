@@ -0,0 +1,72 @@
+/**
+ * \file DBHttpClient.h
+ *
+ * \ingroup WebDBI
+ *
+ * \brief Class def header for a class DBHttpClient
+ */
+
+/** \addtogroup WebDBI
+
+    @{*/
+#ifndef DBHTTPCLIENT_H
+#define DBHTTPCLIENT_H
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace lariov {
+
+  class DBDatasetParser;
+
+  /**
+     \class DBHttpClient
+     Process-wide HTTP client for the conditions web servers, used by
+     DBFolder in place of libwda when configured with `UseLibwda: false`.
+
+     Transfer handles are pooled and reused, and share one connection cache,
+     so that successive queries to a server reuse an open (keep-alive)
+     connection instead of setting up a new one.  Compressed responses
+     (gzip, zstd and the other encodings libcurl was built with) are
+     requested and decompressed as they arrive, straight into the parser.
+
+     Like libwda, a failed query is retried, with increasing delays, until
+     the timeout expires: transfer errors and server errors (status 5xx) are
+     retried, other responses are returned.
+  */
+  class DBHttpClient {
+
+  public:
+    struct Response {
+      long status = 0;                 ///< HTTP status; 0 if no response was received
+      std::string message;             ///< Error description when status is not 200
+      std::uint64_t transferBytes = 0; ///< Bytes received, before decompression
+      long parseTime = 0;              ///< Microseconds spent in the parser
+    };
+
+    static DBHttpClient& Instance();
+
+    /// Queries url, feeding the body of a successful response to parser
+    Response Get(const std::string& url, int timeout, DBDatasetParser& parser);
+
+    DBHttpClient(const DBHttpClient&) = delete;
+    DBHttpClient& operator=(const DBHttpClient&) = delete;
+
+  private:
+    DBHttpClient(); // Never destroyed, to serve threads still running at exit.
+
+    void* AcquireHandle();
+    void ReleaseHandle(void* handle);
+
+    void* fShare; // CURLSH, holding the connection and DNS caches.
+    std::array<std::mutex, 8> fShareMutexes; // One per kind of data shared.
+    std::vector<void*> fIdleHandles; // CURL handles not in use.
+    std::mutex fPoolMutex;
+  };
+} //end namespace lariov
+
+#endif
+/** @} */ // end of doxygen group
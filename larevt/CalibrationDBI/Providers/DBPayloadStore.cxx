@@ -0,0 +1,171 @@
+#include "DBPayloadStore.h"
+
+// art/LArSoft libraries
+#include "cetlib_except/exception.h"
+
+#include <algorithm>
+#include <variant>
+
+namespace lariov {
+
+  DBPayloadStore& DBPayloadStore::Instance()
+  {
+    static DBPayloadStore store;
+    return store;
+  }
+
+  void DBPayloadStore::Record(std::string const& folder,
+                              std::string const& tag,
+                              DatasetPtr_t data)
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    fRecorded[{folder, tag}].emplace(data->beginTime(), std::move(data));
+  }
+
+  std::vector<DBPayload> DBPayloadStore::RecordedPayloads() const
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    return ToPayloads(fRecorded);
+  }
+
+  // The uses whose handles are gone are dropped here, so the list stays as long as the
+  // number of datasets in use.
+
+  DBPayloadStore::UsePtr_t DBPayloadStore::Use(std::string const& folder,
+                                               std::string const& tag,
+                                               DatasetPtr_t data)
+  {
+    auto use = std::make_shared<Usage const>(Usage{folder, tag, std::move(data)});
+    std::lock_guard<std::mutex> lock(fMutex);
+    fRecorded[{folder, tag}].emplace(use->data->beginTime(), use->data);
+    fInUse.erase(std::remove_if(fInUse.begin(),
+                                fInUse.end(),
+                                [](std::weak_ptr<Usage const> const& u) { return u.expired(); }),
+                 fInUse.end());
+    fInUse.push_back(use);
+    return use;
+  }
+
+  std::vector<DBPayload> DBPayloadStore::TakeRecordedPayloads()
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    std::vector<DBPayload> payloads = ToPayloads(fRecorded);
+    fRecorded.clear();
+    for (auto const& weak : fInUse) {
+      if (auto const use = weak.lock())
+        fRecorded[{use->folder, use->tag}].emplace(use->data->beginTime(), use->data);
+    }
+    return payloads;
+  }
+
+  void DBPayloadStore::Load(std::vector<DBPayload> const& payloads)
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    for (auto const& payload : payloads) {
+      auto& datasets = fLoaded[{payload.folder, payload.tag}];
+      IOVTimeStamp const begin(payload.beginStamp, payload.beginSubStamp);
+      if (datasets.count(begin) == 0) datasets.emplace(begin, FromPayload(payload));
+    }
+  }
+
+  DBPayloadStore::DatasetPtr_t DBPayloadStore::Find(std::string const& folder,
+                                                    std::string const& tag,
+                                                    IOVTimeStamp const& ts) const
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    auto const datasets = fLoaded.find({folder, tag});
+    if (datasets == fLoaded.end()) return nullptr;
+
+    // The last interval beginning at or before ts.
+    auto it = datasets->second.upper_bound(ts);
+    if (it == datasets->second.begin()) return nullptr;
+    --it;
+    return ts < it->second->endTime() ? it->second : nullptr;
+  }
+
+  //----------------------------------------------------------------------------
+  std::vector<DBPayload> DBPayloadStore::ToPayloads(Store_t const& store)
+  {
+    std::vector<DBPayload> payloads;
+    for (auto const& [key, datasets] : store)
+      for (auto const& [begin, data] : datasets)
+        payloads.push_back(ToPayload(key.first, key.second, *data));
+    return payloads;
+  }
+
+  DBPayload DBPayloadStore::ToPayload(std::string const& folder,
+                                      std::string const& tag,
+                                      DBDataset const& data)
+  {
+    DBPayload payload;
+    payload.folder = folder;
+    payload.tag = tag;
+    payload.beginStamp = data.beginTime().Stamp();
+    payload.beginSubStamp = data.beginTime().SubStamp();
+    payload.endStamp = data.endTime().Stamp();
+    payload.endSubStamp = data.endTime().SubStamp();
+    payload.columnNames = data.colNames();
+    payload.columnTypes = data.colTypes();
+    payload.channels.assign(data.channels().begin(), data.channels().end());
+
+    payload.kinds.reserve(data.data().size());
+    for (auto const& value : data.data()) {
+      if (auto const* integer = std::get_if<long>(&value)) {
+        payload.kinds.push_back(DBPayload::kInteger);
+        payload.integers.push_back(*integer);
+      }
+      else if (auto const* real = std::get_if<double>(&value)) {
+        payload.kinds.push_back(DBPayload::kReal);
+        payload.reals.push_back(*real);
+      }
+      else {
+        auto const& text = std::get<std::unique_ptr<std::string>>(value);
+        payload.kinds.push_back(DBPayload::kText);
+        payload.texts.push_back(text ? *text : std::string());
+      }
+    }
+    return payload;
+  }
+
+  DBPayloadStore::DatasetPtr_t DBPayloadStore::FromPayload(DBPayload const& payload)
+  {
+    auto const count = [&payload](DBPayload::Kind_t kind) -> std::size_t {
+      return std::count(payload.kinds.begin(), payload.kinds.end(), kind);
+    };
+    std::size_t const nvalues = payload.channels.size() * payload.columnNames.size();
+    if (payload.kinds.size() != nvalues || count(DBPayload::kInteger) != payload.integers.size() ||
+        count(DBPayload::kReal) != payload.reals.size() ||
+        count(DBPayload::kText) != payload.texts.size()) {
+      throw cet::exception("DBPayloadStore")
+        << "Inconsistent payload of folder " << payload.folder << ": " << payload.kinds.size()
+        << " values for " << payload.channels.size() << " rows and "
+        << payload.columnNames.size() << " columns.\n";
+    }
+
+    std::vector<DBDataset::value_type> values;
+    values.reserve(nvalues);
+    auto integer = payload.integers.begin();
+    auto real = payload.reals.begin();
+    auto text = payload.texts.begin();
+    for (auto const kind : payload.kinds) {
+      switch (kind) {
+      case DBPayload::kInteger: values.emplace_back(static_cast<long>(*integer++)); break;
+      case DBPayload::kReal: values.emplace_back(*real++); break;
+      case DBPayload::kText: values.emplace_back(std::make_unique<std::string>(*text++)); break;
+      default:
+        throw cet::exception("DBPayloadStore")
+          << "Unknown value kind " << int(kind) << " in payload of folder " << payload.folder
+          << ".\n";
+      }
+    }
+
+    return std::make_shared<DBDataset const>(
+      IOVTimeStamp(payload.beginStamp, payload.beginSubStamp),
+      IOVTimeStamp(payload.endStamp, payload.endSubStamp),
+      std::vector<std::string>(payload.columnNames),
+      std::vector<std::string>(payload.columnTypes),
+      std::vector<DBChannelID_t>(payload.channels.begin(), payload.channels.end()),
+      std::move(values));
+  }
+
+} //end namespace lariov
@@ -0,0 +1,109 @@
+/**
+ * \file DBPayloadStore.h
+ *
+ * \ingroup WebDBI
+ *
+ * \brief Class def header for a class DBPayloadStore
+ */
+
+/** \addtogroup WebDBI
+
+    @{*/
+#ifndef DBPAYLOADSTORE_H
+#define DBPAYLOADSTORE_H
+
+#include "larevt/CalibrationDBI/IOVData/DBPayload.h"
+#include "larevt/CalibrationDBI/Providers/DBDataset.h"
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace lariov {
+
+  /**
+     \class DBPayloadStore
+     Process-wide store of the database data embedded in the art files.
+
+     When recording, every dataset a DBFolder uses is kept, so that it can
+     be written out as a DBPayload (see CalibrationPayloadWriter).  Taking the
+     recorded datasets starts a new period, which begins with the datasets
+     still in use: the ones held by a folder, or by a cached snapshot built
+     from them (see Use()), as they may be used again without any fetch.
+     Payloads read back from a file (see CalibrationPayloadReader) are loaded here, and
+     DBFolder objects configured to use embedded payloads take their data
+     from the store instead of the database.
+  */
+  class DBPayloadStore {
+
+  public:
+    using DatasetPtr_t = std::shared_ptr<DBDataset const>;
+
+    /// Handle of a recorded dataset in use (see Use())
+    using UsePtr_t = std::shared_ptr<void const>;
+
+    static DBPayloadStore& Instance();
+
+    /// Starts keeping the datasets fetched from the database
+    void SetRecording(bool record) { fRecording.store(record); }
+    bool Recording() const { return fRecording.load(std::memory_order_relaxed); }
+
+    /// Keeps a dataset fetched from the database, once per interval of validity
+    void Record(std::string const& folder, std::string const& tag, DatasetPtr_t data);
+
+    /// Returns all the recorded datasets, ordered by folder, tag and begin time
+    std::vector<DBPayload> RecordedPayloads() const;
+
+    /// Records a dataset like Record(), and returns a handle: while any copy of
+    /// the handle is alive, the dataset is recorded again in each new period
+    UsePtr_t Use(std::string const& folder, std::string const& tag, DatasetPtr_t data);
+
+    /// Returns the recorded datasets like RecordedPayloads(), then forgets them
+    /// and starts a new recording period with the datasets still in use
+    std::vector<DBPayload> TakeRecordedPayloads();
+
+    /// Adds payloads read from a file; the ones already loaded are ignored
+    void Load(std::vector<DBPayload> const& payloads);
+
+    /// Returns the loaded data of the folder valid at ts, or nullptr if none is
+    DatasetPtr_t Find(std::string const& folder,
+                      std::string const& tag,
+                      IOVTimeStamp const& ts) const;
+
+    /// Conversions between datasets and data products
+    static DBPayload ToPayload(std::string const& folder,
+                               std::string const& tag,
+                               DBDataset const& data);
+    static DatasetPtr_t FromPayload(DBPayload const& payload);
+
+  private:
+    DBPayloadStore() = default;
+
+    /// Datasets of each folder and tag, by IOV begin time
+    using Datasets_t = std::map<IOVTimeStamp, DatasetPtr_t>;
+    using Store_t = std::map<std::pair<std::string, std::string>, Datasets_t>;
+
+    /// A dataset in use, shared by the holders of its handle
+    struct Usage {
+      std::string folder;
+      std::string tag;
+      DatasetPtr_t data;
+    };
+
+    static std::vector<DBPayload> ToPayloads(Store_t const& store);
+
+    std::atomic<bool> fRecording{false};
+
+    Store_t fRecorded;         // Fetched from the database.
+    Store_t fLoaded;           // Read from files.
+    std::vector<std::weak_ptr<Usage const>> fInUse; // Handed out by Use().
+    mutable std::mutex fMutex; // Guards the stores and fInUse.
+  };
+} //end namespace lariov
+
+#endif
+/** @} */ // end of doxygen group
@@ -17,6 +17,45 @@ namespace lariov {
     std::string tag = p.get<std::string>("DBTag", "");
     bool usesqlite = p.get<bool>("UseSQLite", false);
     bool testmode = p.get<bool>("TestMode", false);
-    fFolder.reset(new DBFolder(foldername, url, url2, tag, usesqlite, testmode));
+    double shadowfraction = p.get<double>("ShadowFraction", 0.);
+    bool useembedded = p.get<bool>("UseEmbeddedPayloads", false);
+    std::string bundlefile = p.get<std::string>("BundleFile", "");
+    bool uselibwda = p.get<bool>("UseLibwda", true);
+    fFolder.reset(new DBFolder(foldername,
+                               url,
+                               url2,
+                               tag,
+                               usesqlite,
+                               testmode,
+                               shadowfraction,
+                               useembedded,
+                               bundlefile,
+                               uselibwda));
+    fFolder->SetTraced(fTraceType == ConditionsTrace::kFolder);
+    fTraceSource = kNoTraceSource;
+  }
+
+  // Not thread safe, as UpdateFolder().
+  DatabaseRetrievalAlg::IOVRange_t DatabaseRetrievalAlg::SelectTimeStamp(DBTimeStamp_t ts)
+  {
+    UpdateFolder(ts);
+    return {Begin(), End()};
+  }
+
+  void DatabaseRetrievalAlg::SetTraceType(ConditionsTrace::Source_t type)
+  {
+    fTraceType = type;
+    fFolder->SetTraced(type == ConditionsTrace::kFolder);
+    fTraceSource = kNoTraceSource;
+  }
+
+  std::uint32_t DatabaseRetrievalAlg::TraceSource() const
+  {
+    std::uint32_t source = fTraceSource.load(std::memory_order_relaxed);
+    if (source == kNoTraceSource) {
+      source = ConditionsTrace::Instance().SourceID(fTraceType, FolderName(), Tag());
+      fTraceSource.store(source, std::memory_order_relaxed);
+    }
+    return source;
   }
 }
@@ -15,7 +15,11 @@
 #define DATABASERETRIEVALALG_H
 
 #include "DBFolder.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <utility>
 
 namespace fhicl {
   class ParameterSet;
@@ -33,6 +37,9 @@ namespace lariov {
   class DatabaseRetrievalAlg {
 
   public:
+    /// Interval of validity: begin and end (excluded) times
+    using IOVRange_t = std::pair<IOVTimeStamp, IOVTimeStamp>;
+
     /// Constructors
     DatabaseRetrievalAlg(const std::string& foldername,
                          const std::string& url,
@@ -51,7 +58,11 @@ namespace lariov {
     /// Configure using fhicl::ParameterSet
     virtual void Reconfigure(fhicl::ParameterSet const& p);
 
-    /// Return true if fFolder is successfully updated
+    /// Return true if fFolder is successfully updated.  False means that the
+    /// folder already held the data valid at ts, which is the case when a
+    /// snapshot evicted from the cache is built again: either way CachedData()
+    /// is then valid at ts.  Errors are reported by exceptions.
+    /// Not thread safe: derived classes serialize calls (see SnapshotCache).
     bool UpdateFolder(DBTimeStamp_t ts) { return fFolder->UpdateData(ts); }
 
     /// Get connection information
@@ -59,12 +70,72 @@ namespace lariov {
     const std::string& FolderName() const { return fFolder->FolderName(); }
     const std::string& Tag() const { return fFolder->Tag(); }
 
+    /// Access metrics of the folder (see ConditionsMetrics)
+    FolderMetrics& Metrics() const { return fFolder->Metrics(); }
+
     /// Get Timestamp information
     const IOVTimeStamp& Begin() const { return fFolder->CachedStart(); }
     const IOVTimeStamp& End() const { return fFolder->CachedEnd(); }
 
+    /**
+       Makes ts the time stamp of the current event, loading the data valid at
+       ts, and returns their interval of validity (see IOVManager).  Data not
+       from the database are valid at all times.  The default implementation
+       updates the folder; providers keeping their own time stamp override it.
+    */
+    virtual IOVRange_t SelectTimeStamp(DBTimeStamp_t ts);
+
+    /// Interval of validity covering all times
+    static IOVRange_t AllTimes()
+    {
+      return {IOVTimeStamp::MinTimeStamp(), IOVTimeStamp::MaxTimeStamp()};
+    }
+
   protected:
+    /// Records the calls of the provider in the conditions trace instead of the folder ones
+    void SetTraceType(ConditionsTrace::Source_t type);
+
+    /// Records a call in the conditions trace, if recording (see ConditionsTrace)
+    void Trace(ConditionsTrace::Accessor_t accessor,
+               DBTimeStamp_t ts,
+               std::uint32_t value = 0) const
+    {
+      if (ConditionsTrace::Enabled())
+        ConditionsTrace::Instance().Record(TraceSource(), accessor, ts, value);
+    }
+
+    /// Records a call taking a list of values, if recording
+    void Trace(ConditionsTrace::Accessor_t accessor,
+               DBTimeStamp_t ts,
+               std::uint32_t const* values,
+               std::size_t n) const
+    {
+      if (ConditionsTrace::Enabled())
+        ConditionsTrace::Instance().Record(TraceSource(), accessor, ts, values, n);
+    }
+
+    /// Returns snapshot, made to also hold the folder data in use while the
+    /// payloads are recorded, so that a cached snapshot keeps them recorded
+    template <class S>
+    std::shared_ptr<S const> KeepCacheUse(std::shared_ptr<S const> snapshot) const
+    {
+      std::shared_ptr<void const> use = fFolder->CacheUse();
+      if (!use) return snapshot;
+      auto const holder = std::make_shared<std::pair<std::shared_ptr<S const>, decltype(use)>>(
+        std::move(snapshot), std::move(use));
+      return std::shared_ptr<S const>(holder, holder->first.get());
+    }
+
     std::unique_ptr<DBFolder> fFolder;
+
+  private:
+    static constexpr std::uint32_t kNoTraceSource = ~std::uint32_t(0);
+
+    /// Identifier of the provider in the trace, registered at the first call recorded
+    std::uint32_t TraceSource() const;
+
+    ConditionsTrace::Source_t fTraceType = ConditionsTrace::kFolder;
+    mutable std::atomic<std::uint32_t> fTraceSource{kNoTraceSource};
   };
 }
 
@@ -10,12 +10,10 @@
 #include "larcoreobj/SimpleTypesAndConstants/geo_types.h" // for kCollection
 #include "larevt/CalibrationDBI/IOVData/IOVDataError.h"   // for IOVDataE...
 #include "larevt/CalibrationDBI/IOVData/IOVTimeStamp.h"   // for IOVTimeS...
+#include "larevt/CalibrationDBI/Providers/CalibrationFileReader.h"
 #include "larevt/CalibrationDBI/Providers/DBFolder.h"     // for DBFolder
 #include "messagefacility/MessageLogger/MessageLogger.h"
 
-//C/C++
-#include <fstream>
-
 namespace lariov {
 
   //constructors
@@ -24,20 +22,17 @@ namespace lariov {
                                                    const std::string& tag /*=""*/)
     : DatabaseRetrievalAlg(foldername, url, tag)
     , fEventTimeStamp(0)
-    , fCurrentTimeStamp(0)
     , fDataSource(DataSource::Database)
   {
-
-    fData.Clear();
-    IOVTimeStamp tmp = IOVTimeStamp::MaxTimeStamp();
-    tmp.SetStamp(tmp.Stamp() - 1, tmp.SubStamp());
-    fData.SetIoV(tmp, IOVTimeStamp::MaxTimeStamp());
+    SetTraceType(ConditionsTrace::kDetPedestal);
   }
 
   DetPedestalRetrievalAlg::DetPedestalRetrievalAlg(fhicl::ParameterSet const& p)
     : DatabaseRetrievalAlg(p.get<fhicl::ParameterSet>("DatabaseRetrievalAlg"))
+    , fEventTimeStamp(0)
   {
 
+    SetTraceType(ConditionsTrace::kDetPedestal);
     this->Reconfigure(p);
   }
 
@@ -45,10 +40,15 @@ namespace lariov {
   {
 
     this->DatabaseRetrievalAlg::Reconfigure(p.get<fhicl::ParameterSet>("DatabaseRetrievalAlg"));
-    fData.Clear();
+    fSnapshots.Clear();
+    fFixedData.reset();
+
+    Rows_t data;
+    data.Clear();
     IOVTimeStamp tmp = IOVTimeStamp::MaxTimeStamp();
     tmp.SetStamp(tmp.Stamp() - 1, tmp.SubStamp());
-    fData.SetIoV(tmp, IOVTimeStamp::MaxTimeStamp());
+    data.SetIoV(tmp, IOVTimeStamp::MaxTimeStamp());
+    SnapshotBuilder<Rows_t> rows;
 
     bool UseDB = p.get<bool>("UseDB", false);
     bool UseFile = p.get<bool>("UseFile", false);
@@ -85,61 +85,50 @@ namespace lariov {
       DefaultInd.SetPedRms(default_indrms);
       DefaultInd.SetPedRmsErr(default_rms_err);
 
+      // One record per signal type; channels only store which one they use.
+      auto defaults = std::make_shared<Defaults_t>();
+      defaults->SetIoV(data.Start(), data.End());
+      std::uint8_t const coll = defaults->AddRecord(DefaultColl);
+      std::uint8_t const ind = defaults->AddRecord(DefaultInd);
+
       art::ServiceHandle<geo::Geometry const> geo;
       for (auto const& wid : geo->Iterate<geo::WireID>()) {
         DBChannelID_t ch = geo->PlaneWireToChannel(wid);
 
-        if (geo->SignalType(ch) == geo::kCollection) {
-          DefaultColl.SetChannel(ch);
-          fData.AddOrReplaceRow(DefaultColl);
-        }
-        else if (geo->SignalType(ch) == geo::kInduction) {
-          DefaultInd.SetChannel(ch);
-          fData.AddOrReplaceRow(DefaultInd);
-        }
+        if (geo->SignalType(ch) == geo::kCollection)
+          defaults->SetChannelRecord(ch, coll);
+        else if (geo->SignalType(ch) == geo::kInduction)
+          defaults->SetChannelRecord(ch, ind);
         else
           throw IOVDataError("Wire type is not collection or induction!");
       }
+      fFixedData = std::make_shared<Snapshot_t const>(std::move(defaults));
     }
     else if (fDataSource == DataSource::File) {
       cet::search_path sp("FW_SEARCH_PATH");
       std::string abs_fp = sp.find_file(fileName);
       std::cout << "Using pedestals from local file: " << abs_fp << "\n";
-      std::ifstream file(abs_fp);
-      if (!file) {
-        throw cet::exception("DetPedestalRetrievalAlg") << "File " << abs_fp << " is not found.";
-      }
+      CalibrationFileReader file(abs_fp, {"mean", "rms", "mean_err", "rms_err"});
 
-      std::string line;
+      rows.Reserve(file.NRows());
       DetPedestal dp(0);
-      while (std::getline(file, line)) {
-        size_t current_comma = line.find(',');
-        DBChannelID_t ch = (DBChannelID_t)std::stoi(line.substr(0, current_comma));
-        float ped = std::stof(
-          line.substr(current_comma + 1, line.find(',', current_comma + 1) - (current_comma + 1)));
-
-        current_comma = line.find(',', current_comma + 1);
-        float rms = std::stof(
-          line.substr(current_comma + 1, line.find(',', current_comma + 1) - (current_comma + 1)));
-
-        current_comma = line.find(',', current_comma + 1);
-        float ped_err = std::stof(
-          line.substr(current_comma + 1, line.find(',', current_comma + 1) - (current_comma + 1)));
-
-        current_comma = line.find(',', current_comma + 1);
-        float rms_err = std::stof(line.substr(current_comma + 1));
-
-        dp.SetChannel(ch);
-        dp.SetPedMean(ped);
-        dp.SetPedMeanErr(ped_err);
-        dp.SetPedRms(rms);
-        dp.SetPedRmsErr(rms_err);
-        fData.AddOrReplaceRow(dp);
+      for (size_t row = 0; row != file.NRows(); ++row) {
+        dp.SetChannel(file.Channel(row));
+        dp.SetPedMean(file.Value(row, 0));
+        dp.SetPedRms(file.Value(row, 1));
+        dp.SetPedMeanErr(file.Value(row, 2));
+        dp.SetPedRmsErr(file.Value(row, 3));
+        rows.Add(dp);
       }
     } // if source from file
     else {
       std::cout << "Using pedestals from conditions database\n";
     }
+
+    if (fDataSource == DataSource::File) {
+      rows.Fill(data);
+      fFixedData = std::make_shared<Snapshot_t const>(std::move(data));
+    }
   }
 
   // This method saves the time stamp of the latest event.
@@ -147,6 +136,7 @@ namespace lariov {
   void DetPedestalRetrievalAlg::UpdateTimeStamp(DBTimeStamp_t ts)
   {
     mf::LogInfo("DetPedestalRetrievalAlg") << "DetPedestalRetrievalAlg::UpdateTimeStamp called.";
+    Trace(ConditionsTrace::kSelectTime, ts);
     fEventTimeStamp = ts;
   }
 
@@ -155,87 +145,88 @@ namespace lariov {
   bool DetPedestalRetrievalAlg::Update(DBTimeStamp_t ts)
   {
 
+    Trace(ConditionsTrace::kSelectTime, ts);
     fEventTimeStamp = ts;
-    return DBUpdate(ts);
+    if (fDataSource != DataSource::Database || fSnapshots.Find(ts)) return false;
+    SnapshotFor(ts);
+    return true;
   }
 
-  // Maybe update method cached data (private const version using current event time).
-
-  bool DetPedestalRetrievalAlg::DBUpdate() const { return DBUpdate(fEventTimeStamp); }
+  // Called by IOVManager only when ts leaves the interval of validity of the current data.
 
-  // Maybe update method cached data (private const version).
-  // This is the function that does the actual work of updating data from database.
-
-  bool DetPedestalRetrievalAlg::DBUpdate(DBTimeStamp_t ts) const
+  DetPedestalRetrievalAlg::IOVRange_t DetPedestalRetrievalAlg::SelectTimeStamp(DBTimeStamp_t ts)
   {
+    Trace(ConditionsTrace::kSelectTime, ts);
+    fEventTimeStamp = ts;
+    if (fDataSource != DataSource::Database) return AllTimes();
+    auto const data = SnapshotFor(ts);
+    return {data->Start(), data->End()};
+  }
 
-    // A static mutex that is shared across all invocations of the function.
-    static std::mutex mutex;
-    std::lock_guard<std::mutex> lock(mutex);
-
-    bool result = false;
-    if (fDataSource == DataSource::Database && ts != fCurrentTimeStamp) {
+  // Return the snapshot valid at the specified time, building it if needed.
 
-      mf::LogInfo("DetPedestalRetrievalAlg")
-        << "DetPedestalRetrievalAlg::DBUpdate called with new timestamp.";
-      fCurrentTimeStamp = ts;
+  DetPedestalRetrievalAlg::SnapshotPtr_t DetPedestalRetrievalAlg::SnapshotFor(
+    DBTimeStamp_t ts) const
+  {
+    if (fDataSource != DataSource::Database) return fFixedData;
+    if (ConditionsMetrics::Enabled()) FolderMetrics::Count(Metrics().snapshotLookups);
+    return fSnapshots.FindOrBuild(ts, [this](DBTimeStamp_t t) { return BuildSnapshot(t); });
+  }
 
-      // Call non-const base class method.
+  // This is the function that does the actual work of updating data from database.
+  // Calls are serialized by the snapshot cache.
 
-      result = const_cast<DetPedestalRetrievalAlg*>(this)->UpdateFolder(ts);
-      if (result) {
+  DetPedestalRetrievalAlg::SnapshotPtr_t DetPedestalRetrievalAlg::BuildSnapshot(
+    DBTimeStamp_t ts) const
+  {
 
-        //DBFolder was updated, so now update the Snapshot
-        fData.Clear();
-        fData.SetIoV(this->Begin(), this->End());
+    mf::LogInfo("DetPedestalRetrievalAlg")
+      << "DetPedestalRetrievalAlg::BuildSnapshot called with new timestamp.";
 
-        std::vector<DBChannelID_t> channels;
-        fFolder->GetChannelList(channels);
-        for (auto it = channels.begin(); it != channels.end(); ++it) {
+    // Call non-const base class method; the folder may already hold the data
+    // at ts (see UpdateFolder()).
 
-          double mean, mean_err, rms, rms_err;
-          fFolder->GetNamedChannelData(*it, "mean", mean);
-          fFolder->GetNamedChannelData(*it, "mean_err", mean_err);
-          fFolder->GetNamedChannelData(*it, "rms", rms);
-          fFolder->GetNamedChannelData(*it, "rms_err", rms_err);
+    const_cast<DetPedestalRetrievalAlg*>(this)->UpdateFolder(ts);
+    MetricsTimer timer(Metrics().rebuildTime);
 
-          DetPedestal pd(*it);
-          pd.SetPedMean((float)mean);
-          pd.SetPedMeanErr((float)mean_err);
-          pd.SetPedRms((float)rms);
-          pd.SetPedRmsErr((float)rms_err);
+    Rows_t data;
+    data.SetIoV(this->Begin(), this->End());
 
-          fData.AddOrReplaceRow(pd);
-        }
-      }
-    }
+    // FIELD_NAMES starts with the channel, which is not a field.
+    SnapshotBuilder<Rows_t> rows;
+    Columns_t({FIELD_NAMES[1], FIELD_NAMES[2], FIELD_NAMES[3], FIELD_NAMES[4]})
+      .Decode(fFolder->CachedData(), DetPedestal(0), rows);
+    rows.Fill(data);
 
-    return result;
+    return KeepCacheUse(std::make_shared<Snapshot_t const>(std::move(data)));
   }
 
-  const DetPedestal& DetPedestalRetrievalAlg::Pedestal(DBChannelID_t ch) const
+  DetPedestal DetPedestalRetrievalAlg::Pedestal(DBChannelID_t ch) const
   {
-    DBUpdate();
-    return fData.GetRow(ch);
+    return SnapshotFor(fEventTimeStamp)->GetRow(ch);
   }
 
   float DetPedestalRetrievalAlg::PedMean(DBChannelID_t ch) const
   {
+    Trace(ConditionsTrace::kPedMean, fEventTimeStamp, ch);
     return this->Pedestal(ch).PedMean();
   }
 
   float DetPedestalRetrievalAlg::PedRms(DBChannelID_t ch) const
   {
+    Trace(ConditionsTrace::kPedRms, fEventTimeStamp, ch);
     return this->Pedestal(ch).PedRms();
   }
 
   float DetPedestalRetrievalAlg::PedMeanErr(DBChannelID_t ch) const
   {
+    Trace(ConditionsTrace::kPedMeanErr, fEventTimeStamp, ch);
     return this->Pedestal(ch).PedMeanErr();
   }
 
   float DetPedestalRetrievalAlg::PedRmsErr(DBChannelID_t ch) const
   {
+    Trace(ConditionsTrace::kPedRmsErr, fEventTimeStamp, ch);
     return this->Pedestal(ch).PedRmsErr();
   }
 
@@ -15,15 +15,22 @@
 #define WEBDBI_DETPEDESTALRETRIEVALALG_H
 
 // C/C++ standard libraries
+#include <atomic>
+#include <memory>
 #include <string>
 
 // LArSoft libraries
 #include "larevt/CalibrationDBI/IOVData/DetPedestal.h"
 #include "larevt/CalibrationDBI/IOVData/IOVDataConstants.h"
-#include "larevt/CalibrationDBI/IOVData/Snapshot.h"
+#include "larevt/CalibrationDBI/IOVData/DenseSnapshot.h"
+#include "larevt/CalibrationDBI/IOVData/ProviderSnapshot.h"
+#include "larevt/CalibrationDBI/IOVData/SnapshotBuilder.h"
+#include "larevt/CalibrationDBI/IOVData/SnapshotCache.h"
+#include "larevt/CalibrationDBI/IOVData/UniformSnapshot.h"
 #include "larevt/CalibrationDBI/Interface/CalibrationDBIFwd.h"
 #include "larevt/CalibrationDBI/Interface/DetPedestalProvider.h"
 #include "larevt/CalibrationDBI/Providers/DatabaseRetrievalAlg.h"
+#include "larevt/CalibrationDBI/Providers/SIOVColumns.h"
 
 namespace fhicl {
   class ParameterSet;
@@ -54,10 +61,25 @@ namespace lariov {
    *   for all channels returned when /UseDB/ and /UseFile/ parameters are false
    * - *DefaultRmsErr* (real, default: 0.0): error on the RMS value
    *   for all channels returned when /UseDB/ and /UseFile/ parameters are false
+   *
+   * Database snapshots are immutable and shared: each interval of validity is
+   * built once and kept in a SnapshotCache.  The accessors taking only a
+   * channel use the time stamp of the latest event (see UpdateTimeStamp()),
+   * which is shared by all the callers; use SnapshotFor() to get the data valid
+   * at a specific time.  Rows are returned by value, since the snapshot they
+   * come from may be dropped from the cache as soon as the call returns.
+   *
+   * Default values are stored once per signal type (see UniformSnapshot), and
+   * SnapshotFor() returns them in that form (see ProviderSnapshot).
    */
   class DetPedestalRetrievalAlg : public DatabaseRetrievalAlg, public DetPedestalProvider {
 
   public:
+    using Rows_t = DenseSnapshot<DetPedestal>;
+    using Snapshot_t = ProviderSnapshot<Rows_t>;
+    using SnapshotPtr_t = std::shared_ptr<Snapshot_t const>;
+    using Defaults_t = UniformSnapshot<DetPedestal>;
+
     /// Constructors
     DetPedestalRetrievalAlg(const std::string& foldername,
                             const std::string& url,
@@ -74,13 +96,30 @@ namespace lariov {
     /// Update Snapshot and inherited DBFolder if using database.  Return true if updated
     bool Update(DBTimeStamp_t ts);
 
+    /// Returns the pedestals valid at the specified time
+    SnapshotPtr_t SnapshotFor(DBTimeStamp_t ts) const;
+
+    /// Makes ts the current time stamp; returns the interval of validity of the data at ts
+    IOVRange_t SelectTimeStamp(DBTimeStamp_t ts) override;
+
+    /// Returns whether the data come from the conditions database (otherwise
+    /// they are valid at all times)
+    bool UsesDatabase() const { return fDataSource == DataSource::Database; }
+
     /// Retrieve pedestal information
-    const DetPedestal& Pedestal(DBChannelID_t ch) const;
+    DetPedestal Pedestal(DBChannelID_t ch) const;
     float PedMean(DBChannelID_t ch) const override;
     float PedRms(DBChannelID_t ch) const override;
     float PedMeanErr(DBChannelID_t ch) const override;
     float PedRmsErr(DBChannelID_t ch) const override;
 
+    /// Database columns, bound to the pedestal fields
+    using Columns_t = SIOVColumns<DetPedestal,
+                                  SIOVField<&DetPedestal::SetPedMean>,
+                                  SIOVField<&DetPedestal::SetPedMeanErr>,
+                                  SIOVField<&DetPedestal::SetPedRms>,
+                                  SIOVField<&DetPedestal::SetPedRmsErr>>;
+
     //hardcoded information about database folder - useful for debugging cross checks
     static constexpr unsigned int NCOLUMNS = 5;
     static constexpr const char* FIELD_NAMES[NCOLUMNS] = {"channel",
@@ -95,18 +134,14 @@ namespace lariov {
                                                           "float"};
 
   private:
-    /// Do actual database updates.
-
-    bool DBUpdate() const; // Uses current event time.
-    bool DBUpdate(DBTimeStamp_t ts) const;
-
-    // Time stamps.
+    /// Builds the snapshot for the interval of validity containing ts.
+    SnapshotPtr_t BuildSnapshot(DBTimeStamp_t ts) const;
 
-    DBTimeStamp_t fEventTimeStamp;           // Most recently seen time stamp.
-    mutable DBTimeStamp_t fCurrentTimeStamp; // Time stamp of cached data.
+    std::atomic<DBTimeStamp_t> fEventTimeStamp; // Most recently seen time stamp.
 
     DataSource::ds fDataSource;
-    mutable Snapshot<DetPedestal> fData;
+    SnapshotPtr_t fFixedData;                     // Data from file or defaults.
+    mutable SnapshotCache<Snapshot_t> fSnapshots; // Database data, one per IOV.
   };
 } //end namespace lariov
 
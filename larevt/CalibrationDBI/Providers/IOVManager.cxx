@@ -0,0 +1,100 @@
+#include "IOVManager.h"
+#include "larevt/CalibrationDBI/IOVData/TimeStampDecoder.h"
+
+// art/LArSoft libraries
+#include "messagefacility/MessageLogger/MessageLogger.h"
+
+#include "tbb/parallel_for.h"
+
+#include <exception>
+#include <utility>
+
+namespace lariov {
+
+  void IOVManager::Register(DatabaseRetrievalAlg& provider, std::string name)
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    fClients.push_back({&provider, std::move(name)});
+    SetRange(0, 0);
+  }
+
+  std::size_t IOVManager::NProviders() const
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    return fClients.size();
+  }
+
+  bool IOVManager::Refresh(DBTimeStamp_t ts)
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+
+    // Another thread may have moved the providers while we were waiting.
+    if (InRange(ts)) return false;
+
+    auto const range = SelectAll(ts);
+
+    DBTimeStamp_t const begin = TimeStampDecoder::FirstTimeStampFrom(range.first);
+    DBTimeStamp_t const end = TimeStampDecoder::FirstTimeStampFrom(range.second);
+
+    mf::LogInfo log("IOVManager");
+    log << "Moved " << fClients.size() << " providers to time stamp " << ts;
+    if (begin <= ts && ts < end) {
+      log << ", valid until " << end;
+      SetRange(begin, end);
+    }
+    else {
+      // Only for inconsistent intervals; the next event will move the providers again.
+      log << ", which is out of their interval of validity";
+      SetRange(0, 0);
+    }
+
+    ++fNRefreshes;
+    return true;
+  }
+
+  // Providers do not share state, so each can load its folder in its own TBB task.
+  // Failures are collected, so that all the providers are moved before the first
+  // one is reported.
+
+  DatabaseRetrievalAlg::IOVRange_t IOVManager::SelectAll(DBTimeStamp_t ts) const
+  {
+    std::vector<DatabaseRetrievalAlg::IOVRange_t> iovs(fClients.size(),
+                                                       DatabaseRetrievalAlg::AllTimes());
+    std::vector<std::exception_ptr> errors(fClients.size());
+    auto const select = [this, ts, &iovs, &errors](std::size_t i) {
+      try {
+        iovs[i] = fClients[i].provider->SelectTimeStamp(ts);
+      }
+      catch (...) {
+        errors[i] = std::current_exception();
+      }
+    };
+
+    if (fParallel && fClients.size() > 1)
+      tbb::parallel_for(std::size_t(0), fClients.size(), select);
+    else {
+      for (std::size_t i = 0; i < fClients.size(); ++i)
+        select(i);
+    }
+
+    for (auto const& error : errors)
+      if (error) std::rethrow_exception(error);
+
+    auto range = DatabaseRetrievalAlg::AllTimes();
+    for (auto const& iov : iovs) {
+      if (iov.first > range.first) range.first = iov.first;
+      if (iov.second < range.second) range.second = iov.second;
+    }
+    return range;
+  }
+
+  void IOVManager::SetRange(DBTimeStamp_t begin, DBTimeStamp_t end)
+  {
+    fVersion.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    fBegin.store(begin, std::memory_order_relaxed);
+    fWidth.store(end - begin, std::memory_order_relaxed);
+    fVersion.fetch_add(1, std::memory_order_release);
+  }
+
+} //end namespace lariov
@@ -0,0 +1,104 @@
+/**
+ * \file IOVManager.h
+ *
+ * \ingroup WebDBI
+ *
+ * \brief Class def header for a class IOVManager
+ */
+
+/** \addtogroup WebDBI
+
+    @{*/
+#ifndef IOVMANAGER_H
+#define IOVMANAGER_H
+
+#include "DatabaseRetrievalAlg.h"
+#include "larevt/CalibrationDBI/Interface/CalibrationDBIFwd.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace lariov {
+
+  /**
+     \class IOVManager
+     Moves a set of database providers to the time stamp of each event.
+
+     The manager keeps the range of time stamps over which the data of all the
+     registered providers stay valid, that is from the latest begin to the
+     earliest end of their intervals of validity.  Update() is then a single
+     comparison for events in that range; only an event out of it makes the
+     providers select its time stamp (see
+     DatabaseRetrievalAlg::SelectTimeStamp()) and computes the range again.
+
+     Update() may be called concurrently.  The range is published through a
+     sequence counter, and providers are moved by one thread at a time.  With
+     SetParallel(), the providers are moved concurrently, one TBB task each,
+     so that loading them at a common boundary takes as long as the slowest
+     one.
+  */
+  class IOVManager {
+
+  public:
+    /// Adds a provider, which must outlive the manager; it is moved at the next Update()
+    void Register(DatabaseRetrievalAlg& provider, std::string name);
+
+    /// Moves the providers to ts if it is out of the current range; returns whether it did
+    bool Update(DBTimeStamp_t ts) { return !InRange(ts) && Refresh(ts); }
+
+    /// Moves the providers concurrently rather than one after the other
+    void SetParallel(bool parallel) { fParallel = parallel; }
+
+    /// Returns whether the data of all the providers are valid at ts
+    bool InRange(DBTimeStamp_t ts) const
+    {
+      std::uint64_t const version = fVersion.load(std::memory_order_acquire);
+      DBTimeStamp_t const begin = fBegin.load(std::memory_order_relaxed);
+      DBTimeStamp_t const width = fWidth.load(std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      return (ts - begin < width) && (version & 1) == 0 &&
+             fVersion.load(std::memory_order_relaxed) == version;
+    }
+
+    /// First time stamp of the current range
+    DBTimeStamp_t RangeBegin() const { return fBegin.load(); }
+
+    /// First time stamp after the current range
+    DBTimeStamp_t RangeEnd() const { return fBegin.load() + fWidth.load(); }
+
+    std::size_t NProviders() const;
+
+    /// Number of times the providers were moved
+    std::size_t NRefreshes() const { return fNRefreshes.load(); }
+
+  private:
+    struct Client {
+      DatabaseRetrievalAlg* provider;
+      std::string name;
+    };
+
+    bool Refresh(DBTimeStamp_t ts);
+
+    /// Makes each provider select ts; returns the intersection of their ranges
+    DatabaseRetrievalAlg::IOVRange_t SelectAll(DBTimeStamp_t ts) const;
+
+    /// Publishes a new range; called with fMutex locked
+    void SetRange(DBTimeStamp_t begin, DBTimeStamp_t end);
+
+    std::vector<Client> fClients;
+    mutable std::mutex fMutex; // Serializes registration and refreshes.
+    bool fParallel = false;
+
+    std::atomic<std::uint64_t> fVersion{0}; // Odd while the range is being changed.
+    std::atomic<DBTimeStamp_t> fBegin{0};
+    std::atomic<DBTimeStamp_t> fWidth{0}; // Empty range: the first Update() moves the providers.
+    std::atomic<std::size_t> fNRefreshes{0};
+  };
+} //end namespace lariov
+
+#endif
+/** @} */ // end of doxygen group
@@ -0,0 +1,85 @@
+#include "NoisyChannelOverlay.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace lariov {
+
+  void NoisyChannelOverlay::Resize(size_t nChannels)
+  {
+    size_t const nWords = (nChannels + 63) / 64;
+    fWords.reset(new std::atomic<word_t>[nWords]);
+    for (size_t w = 0; w != nWords; ++w)
+      fWords[w].store(0, std::memory_order_relaxed);
+    fTouched.reset(new size_t[nWords]);
+    fNTouched.store(0, std::memory_order_relaxed);
+    fSize = nChannels;
+  }
+
+  void NoisyChannelOverlay::Clear()
+  {
+    size_t const nTouched = fNTouched.load(std::memory_order_relaxed);
+    for (size_t i = 0; i != nTouched; ++i)
+      fWords[fTouched[i]].store(0, std::memory_order_relaxed);
+    fNTouched.store(0, std::memory_order_relaxed);
+  }
+
+  // Scans all the words rather than the touched ones, whose record may be incomplete
+  // while channels are being added.
+
+  std::vector<DBChannelID_t> NoisyChannelOverlay::Channels() const
+  {
+    std::vector<DBChannelID_t> channels;
+    if (Empty()) return channels;
+    size_t const nWords = (fSize + 63) / 64;
+    for (size_t w = 0; w != nWords; ++w) {
+      word_t bits = fWords[w].load(std::memory_order_relaxed);
+      for (unsigned int b = 0; bits; ++b, bits >>= 1)
+        if (bits & 1) channels.push_back(DBChannelID_t(w * 64 + b));
+    }
+    return channels;
+  }
+
+  std::vector<DBChannelID_t> NoisyChannelOverlay::Apply(DBChannelID_t const* first,
+                                                         DBChannelID_t const* last,
+                                                         bool noisy) const
+  {
+    std::vector<DBChannelID_t> const flagged = Channels();
+    std::vector<DBChannelID_t> result;
+    result.reserve((last - first) + (noisy ? flagged.size() : 0));
+    if (noisy)
+      std::set_union(first, last, flagged.begin(), flagged.end(), std::back_inserter(result));
+    else
+      std::set_difference(first, last, flagged.begin(), flagged.end(), std::back_inserter(result));
+    return result;
+  }
+
+  void NoisyChannelOverlay::Apply(std::vector<word_t>& words, size_t size, bool noisy) const
+  {
+    for (DBChannelID_t const ch : Channels()) {
+      if (ch >= size) break;
+      word_t const bit = word_t(1) << (ch % 64);
+      if (noisy)
+        words[ch / 64] |= bit;
+      else
+        words[ch / 64] &= ~bit;
+    }
+  }
+
+  void NoisyChannelOverlay::Apply(DBChannelID_t const* channels,
+                                  size_t n,
+                                  bool noisy,
+                                  word_t* result) const
+  {
+    word_t const set = noisy ? ~word_t(0) : 0;
+    for (size_t w = 0; w != (n + 63) / 64; ++w) {
+      size_t const first = w * 64;
+      size_t const count = std::min<size_t>(n - first, 64);
+      word_t flagged = 0;
+      for (size_t i = 0; i != count; ++i)
+        flagged |= word_t(Test(channels[first + i])) << i;
+      result[w] = (result[w] & ~flagged) | (flagged & set);
+    }
+  }
+
+} //end namespace lariov
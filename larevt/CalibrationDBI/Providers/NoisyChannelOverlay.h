@@ -0,0 +1,100 @@
+/**
+ * \file NoisyChannelOverlay.h
+ *
+ * \ingroup WebDBI
+ *
+ * \brief Class def header for a class NoisyChannelOverlay
+ */
+
+/** \addtogroup WebDBI
+
+    @{*/
+#ifndef WEBDBI_NOISYCHANNELOVERLAY_H
+#define WEBDBI_NOISYCHANNELOVERLAY_H
+
+#include "larevt/CalibrationDBI/Interface/CalibrationDBIFwd.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace lariov {
+
+  /**
+     \class NoisyChannelOverlay
+     Channels flagged noisy during the current event, on top of the statuses
+     of the interval of validity.
+
+     One bit per channel, set atomically, so that several modules may flag
+     channels at the same time.  The words which got their first bit are
+     recorded, and Clear() only resets those, taking a time proportional to
+     the number of flagged channels.  Memory is allocated only by Resize().
+
+     Clear() and Resize() must not run concurrently with any other call.
+     There is a single overlay per provider, shared by all the events being
+     processed: SIOVChannelStatusService therefore supports only one schedule.
+  */
+  class NoisyChannelOverlay {
+
+  public:
+    using word_t = std::uint64_t;
+
+    NoisyChannelOverlay() = default;
+
+    /// Number of channels which can be flagged
+    size_t Size() const { return fSize; }
+
+    /// Makes room for channels [ 0, nChannels ), clearing all the flags
+    void Resize(size_t nChannels);
+
+    /// Removes all the flags
+    void Clear();
+
+    /// Flags channel ch; returns false if the channel is out of range
+    bool Add(DBChannelID_t ch)
+    {
+      if (ch >= fSize) return false;
+      size_t const w = ch / 64;
+      word_t const old = fWords[w].fetch_or(word_t(1) << (ch % 64), std::memory_order_relaxed);
+      if (old == 0) fTouched[fNTouched.fetch_add(1, std::memory_order_relaxed)] = w;
+      return true;
+    }
+
+    /// Returns whether channel ch is flagged
+    bool Test(DBChannelID_t ch) const
+    {
+      return ch < fSize && ((fWords[ch / 64].load(std::memory_order_relaxed) >> (ch % 64)) & 1);
+    }
+
+    /// Returns whether no channel is flagged
+    bool Empty() const { return fNTouched.load(std::memory_order_relaxed) == 0; }
+
+    /// Returns the flagged channels, sorted
+    std::vector<DBChannelID_t> Channels() const;
+
+    /// Returns the sorted channels [ first, last ) with the flagged channels
+    /// added (noisy) or removed (not noisy)
+    std::vector<DBChannelID_t> Apply(DBChannelID_t const* first,
+                                     DBChannelID_t const* last,
+                                     bool noisy) const;
+
+    /// Sets (noisy) or clears the bits of the flagged channels below size in
+    /// a channel mask
+    void Apply(std::vector<word_t>& words, size_t size, bool noisy) const;
+
+    /// Sets (noisy) or clears the bits of the flagged channels in the result
+    /// of a batch query on the n channels starting at channels
+    void Apply(DBChannelID_t const* channels, size_t n, bool noisy, word_t* result) const;
+
+  private:
+    size_t fSize = 0;
+    std::unique_ptr<std::atomic<word_t>[]> fWords;
+    std::unique_ptr<size_t[]> fTouched; // Indices of the words with bits set.
+    std::atomic<size_t> fNTouched{0};
+  };
+
+} //end namespace lariov
+#endif
+/** @} */ // end of doxygen group
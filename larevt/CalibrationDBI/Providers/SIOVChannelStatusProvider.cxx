@@ -11,14 +11,18 @@
 
 // LArSoft libraries
 #include "art/Framework/Services/Registry/ServiceHandle.h"
+#include "cetlib_except/exception.h"
 #include "fhiclcpp/ParameterSet.h"
 #include "larcore/Geometry/Geometry.h"
 #include "larevt/CalibrationDBI/IOVData/IOVDataConstants.h"
+#include "larevt/CalibrationDBI/Providers/CalibrationFileReader.h"
 #include "larevt/CalibrationDBI/Providers/DBFolder.h"
 #include "messagefacility/MessageLogger/MessageLogger.h"
 
 // C/C++ standard libraries
-#include <fstream>
+#include <algorithm>
+#include <numeric>
+#include <string>
 
 namespace lariov {
 
@@ -26,9 +30,10 @@ namespace lariov {
   SIOVChannelStatusProvider::SIOVChannelStatusProvider(fhicl::ParameterSet const& pset)
     : DatabaseRetrievalAlg(pset.get<fhicl::ParameterSet>("DatabaseRetrievalAlg"))
     , fEventTimeStamp(0)
-    , fCurrentTimeStamp(0)
+    , fGeometryChannels(0)
     , fDefault(0)
   {
+    SetTraceType(ConditionsTrace::kChannelStatus);
 
     bool UseDB = pset.get<bool>("UseDB", false);
     bool UseFile = pset.get<bool>("UseFile", false);
@@ -51,21 +56,19 @@ namespace lariov {
       cet::search_path sp("FW_SEARCH_PATH");
       std::string abs_fp = sp.find_file(fileName);
       std::cout << "Using channel statuses from local file: " << abs_fp << "\n";
-      std::ifstream file(abs_fp);
-      if (!file) {
-        throw cet::exception("SIOVChannelStatusProvider") << "File " << abs_fp << " is not found.";
-      }
+      CalibrationFileReader file(abs_fp, {"status"});
 
-      std::string line;
+      auto data = std::make_shared<Snapshot_t>();
+      SnapshotBuilder<Snapshot_t> rows(file.NRows());
       ChannelStatus cs(0);
-      while (std::getline(file, line)) {
-        DBChannelID_t ch = (DBChannelID_t)std::stoi(line.substr(0, line.find(',')));
-        int status = std::stoi(line.substr(line.find(',') + 1));
-
-        cs.SetChannel(ch);
-        cs.SetStatus(ChannelStatus::GetStatusFromInt(status));
-        fData.AddOrReplaceRow(cs);
+      for (size_t row = 0; row != file.NRows(); ++row) {
+        cs.SetChannel(file.Channel(row));
+        cs.SetStatus(ChannelStatus::GetStatusFromInt((int)file.Value(row, 0)));
+        rows.Add(cs);
       }
+      rows.Fill(*data);
+      data->BuildIndex();
+      fFixedData = std::move(data);
     } // if source from file
     else {
       std::cout << "Using channel statuses from conditions database\n";
@@ -78,7 +81,8 @@ namespace lariov {
   {
     mf::LogInfo("SIOVChannelStatusProvider")
       << "SIOVChannelStatusProvider::UpdateTimeStamp called.";
-    fNewNoisy.Clear();
+    Trace(ConditionsTrace::kSelectTime, ts);
+    ResetNoisyChannels();
     fEventTimeStamp = ts;
   }
 
@@ -87,116 +91,303 @@ namespace lariov {
   bool SIOVChannelStatusProvider::Update(DBTimeStamp_t ts)
   {
 
+    Trace(ConditionsTrace::kSelectTime, ts);
+    fEventTimeStamp = ts;
+    ResetNoisyChannels();
+    if (fDataSource != DataSource::Database || fSnapshots.Find(ts)) return false;
+    SnapshotFor(ts);
+    return true;
+  }
+
+  // Called by IOVManager only when ts leaves the interval of validity of the current data.
+
+  SIOVChannelStatusProvider::IOVRange_t SIOVChannelStatusProvider::SelectTimeStamp(DBTimeStamp_t ts)
+  {
+    Trace(ConditionsTrace::kSelectTime, ts);
     fEventTimeStamp = ts;
-    fNewNoisy.Clear();
-    return DBUpdate(ts);
+    if (fDataSource != DataSource::Database) return AllTimes();
+    auto const data = SnapshotFor(ts);
+    return {data->Start(), data->End()};
   }
 
-  // Maybe update method cached data (private const version using current event time).
+  // Return the snapshot valid at the specified time, building it if needed.
 
-  bool SIOVChannelStatusProvider::DBUpdate() const { return DBUpdate(fEventTimeStamp); }
+  SIOVChannelStatusProvider::SnapshotPtr_t SIOVChannelStatusProvider::SnapshotFor(
+    DBTimeStamp_t ts) const
+  {
+    if (fDataSource != DataSource::Database) return fFixedData;
+    if (ConditionsMetrics::Enabled()) FolderMetrics::Count(Metrics().snapshotLookups);
+    return fSnapshots.FindOrBuild(ts, [this](DBTimeStamp_t t) { return BuildSnapshot(t); });
+  }
 
-  // Maybe update method cached data (private const version).
   // This is the function that does the actual work of updating data from database.
+  // Calls are serialized by the snapshot cache.
 
-  bool SIOVChannelStatusProvider::DBUpdate(DBTimeStamp_t ts) const
+  SIOVChannelStatusProvider::SnapshotPtr_t SIOVChannelStatusProvider::BuildSnapshot(
+    DBTimeStamp_t ts) const
   {
 
-    // A static mutex that is shared across all invocations of the function.
-    static std::mutex mutex;
-    std::lock_guard<std::mutex> lock(mutex);
+    mf::LogInfo("SIOVChannelStatusProvider")
+      << "SIOVChannelStatusProvider::BuildSnapshot called with new timestamp.";
 
-    bool result = false;
-    if (fDataSource == DataSource::Database && ts != fCurrentTimeStamp) {
+    // Call non-const base class method.  Its result is not needed: the folder
+    // holds the data at ts whether it read them now or earlier.
 
-      mf::LogInfo("SIOVChannelStatusProvider")
-        << "SIOVChannelStatusProvider::DBUpdate called with new timestamp.";
+    const_cast<SIOVChannelStatusProvider*>(this)->UpdateFolder(ts);
+    MetricsTimer timer(Metrics().rebuildTime);
 
-      fCurrentTimeStamp = ts;
+    auto data = std::make_shared<Snapshot_t>();
+    data->SetIoV(this->Begin(), this->End());
 
-      // Call non-const base class method.
+    SnapshotBuilder<Snapshot_t> rows;
+    Columns_t({"status"}).Decode(fFolder->CachedData(), ChannelStatus(0), rows);
+    rows.Fill(*data);
+    data->BuildIndex();
 
-      result = const_cast<SIOVChannelStatusProvider*>(this)->UpdateFolder(ts);
-      if (result) {
-        //DBFolder was updated, so now update the Snapshot
-        fData.Clear();
-        fData.SetIoV(this->Begin(), this->End());
+    return KeepCacheUse(SnapshotPtr_t(std::move(data)));
+  }
 
-        std::vector<DBChannelID_t> channels;
-        fFolder->GetChannelList(channels);
-        for (auto it = channels.begin(); it != channels.end(); ++it) {
+  //----------------------------------------------------------------------------
+  ChannelStatus SIOVChannelStatusProvider::GetChannelStatus(raw::ChannelID_t ch) const
+  {
+    ChannelStatus cs = (fDataSource == DataSource::Default) ?
+                         fDefault :
+                         SnapshotFor(fEventTimeStamp)->GetRow(rawToDBChannel(ch));
+    if (fNewNoisy.Test(rawToDBChannel(ch))) cs.SetStatus(kNOISY);
+    return cs;
+  }
 
-          long status;
-          fFolder->GetNamedChannelData(*it, "status", status);
+  //----------------------------------------------------------------------------
+  SIOVChannelStatusProvider::ChannelSet_t SIOVChannelStatusProvider::GoodChannels() const
+  {
+    return ToSet(GoodChannelSpan());
+  }
 
-          ChannelStatus cs(*it);
-          cs.SetStatus(ChannelStatus::GetStatusFromInt((int)status));
+  //----------------------------------------------------------------------------
+  SIOVChannelStatusProvider::ChannelSet_t SIOVChannelStatusProvider::BadChannels() const
+  {
+    return ToSet(BadChannelSpan());
+  }
 
-          fData.AddOrReplaceRow(cs);
-        }
-      }
-    }
-    return result;
+  //----------------------------------------------------------------------------
+  SIOVChannelStatusProvider::ChannelSet_t SIOVChannelStatusProvider::NoisyChannels() const
+  {
+    return ToSet(NoisyChannelSpan());
   }
 
   //----------------------------------------------------------------------------
-  const ChannelStatus& SIOVChannelStatusProvider::GetChannelStatus(raw::ChannelID_t ch) const
+  SIOVChannelStatusProvider::ChannelSpan_t SIOVChannelStatusProvider::GoodChannelSpan() const
   {
-    if (fDataSource == DataSource::Default) { return fDefault; }
-    DBUpdate();
-    if (fNewNoisy.HasChannel(rawToDBChannel(ch))) { return fNewNoisy.GetRow(rawToDBChannel(ch)); }
-    else {
-      return fData.GetRow(rawToDBChannel(ch));
-    }
+    Trace(ConditionsTrace::kGoodChannels, fEventTimeStamp);
+    if (fDataSource == DataSource::Default) return DefaultSpan(fDefault.IsGood(), false);
+    auto const data = SnapshotFor(fEventTimeStamp);
+    return MakeSpan(data, data->ChannelsWithStatus(kGOOD), false);
+  }
+
+  //----------------------------------------------------------------------------
+  SIOVChannelStatusProvider::ChannelSpan_t SIOVChannelStatusProvider::BadChannelSpan() const
+  {
+    Trace(ConditionsTrace::kBadChannels, fEventTimeStamp);
+    if (fDataSource == DataSource::Default)
+      return DefaultSpan(fDefault.IsDead() || fDefault.IsLowNoise(), false);
+    auto const data = SnapshotFor(fEventTimeStamp);
+    return MakeSpan(data, data->BadChannels(), false);
+  }
+
+  //----------------------------------------------------------------------------
+  SIOVChannelStatusProvider::ChannelSpan_t SIOVChannelStatusProvider::NoisyChannelSpan() const
+  {
+    Trace(ConditionsTrace::kNoisyChannels, fEventTimeStamp);
+    if (fDataSource == DataSource::Default) return DefaultSpan(fDefault.IsNoisy(), true);
+    auto const data = SnapshotFor(fEventTimeStamp);
+    return MakeSpan(data, data->ChannelsWithStatus(kNOISY), true);
+  }
+
+  //----------------------------------------------------------------------------
+  SIOVChannelStatusProvider::ChannelSpan_t SIOVChannelStatusProvider::ChannelsWithStatus(
+    Status_t status) const
+  {
+    Trace(ConditionsTrace::kChannelsWithStatus, fEventTimeStamp, status);
+    if (status > kUNKNOWN)
+      throw cet::exception("SIOVChannelStatusProvider")
+        << "ChannelsWithStatus(): invalid status " << status << "\n";
+    if (fDataSource == DataSource::Default)
+      return DefaultSpan(fDefault.Status() == status, status == kNOISY);
+    auto const data = SnapshotFor(fEventTimeStamp);
+    return MakeSpan(data, data->ChannelsWithStatus(chStatus(status)), status == kNOISY);
+  }
+
+  //----------------------------------------------------------------------------
+  SIOVChannelStatusProvider::ChannelMask_t SIOVChannelStatusProvider::GoodChannelMask() const
+  {
+    Trace(ConditionsTrace::kGoodChannels, fEventTimeStamp);
+    if (fDataSource == DataSource::Default) return DefaultMask(fDefault.IsGood(), false);
+    auto const data = SnapshotFor(fEventTimeStamp);
+    return MakeMask(data, data->StatusBits(kGOOD), false);
   }
 
   //----------------------------------------------------------------------------
-  SIOVChannelStatusProvider::ChannelSet_t SIOVChannelStatusProvider::GetChannelsWithStatus(
-    chStatus status) const
+  SIOVChannelStatusProvider::ChannelMask_t SIOVChannelStatusProvider::BadChannelMask() const
   {
+    Trace(ConditionsTrace::kBadChannels, fEventTimeStamp);
+    if (fDataSource == DataSource::Default)
+      return DefaultMask(fDefault.IsDead() || fDefault.IsLowNoise(), false);
+    auto const data = SnapshotFor(fEventTimeStamp);
+    return MakeMask(data, data->BadBits(), false);
+  }
 
-    ChannelSet_t retSet;
-    retSet.clear();
-    DBChannelID_t maxChannel = art::ServiceHandle<geo::Geometry const>()->Nchannels() - 1;
+  //----------------------------------------------------------------------------
+  SIOVChannelStatusProvider::ChannelMask_t SIOVChannelStatusProvider::NoisyChannelMask() const
+  {
+    Trace(ConditionsTrace::kNoisyChannels, fEventTimeStamp);
+    if (fDataSource == DataSource::Default) return DefaultMask(fDefault.IsNoisy(), true);
+    auto const data = SnapshotFor(fEventTimeStamp);
+    return MakeMask(data, data->StatusBits(kNOISY), true);
+  }
+
+  //----------------------------------------------------------------------------
+  void SIOVChannelStatusProvider::ArePresent(raw::ChannelID_t const* channels,
+                                             std::size_t n,
+                                             ResultWord_t* result) const
+  {
+    Trace(ConditionsTrace::kArePresent, fEventTimeStamp, channels, n);
+    unsigned int const all = Snapshot_t::StatusMaskBit(kUNKNOWN) * 2 - 1;
+    MatchStatus(channels, n, all & ~Snapshot_t::StatusMaskBit(kDISCONNECTED), result);
+  }
+
+  //----------------------------------------------------------------------------
+  void SIOVChannelStatusProvider::AreBad(raw::ChannelID_t const* channels,
+                                         std::size_t n,
+                                         ResultWord_t* result) const
+  {
+    Trace(ConditionsTrace::kAreBad, fEventTimeStamp, channels, n);
+    MatchStatus(channels,
+                n,
+                Snapshot_t::StatusMaskBit(kDEAD) | Snapshot_t::StatusMaskBit(kLOWNOISE) |
+                  Snapshot_t::StatusMaskBit(kDISCONNECTED),
+                result);
+  }
+
+  //----------------------------------------------------------------------------
+  void SIOVChannelStatusProvider::AreNoisy(raw::ChannelID_t const* channels,
+                                           std::size_t n,
+                                           ResultWord_t* result) const
+  {
+    Trace(ConditionsTrace::kAreNoisy, fEventTimeStamp, channels, n);
+    MatchStatus(channels, n, Snapshot_t::StatusMaskBit(kNOISY), result);
+  }
+
+  //----------------------------------------------------------------------------
+  void SIOVChannelStatusProvider::AreGood(raw::ChannelID_t const* channels,
+                                          std::size_t n,
+                                          ResultWord_t* result) const
+  {
+    Trace(ConditionsTrace::kAreGood, fEventTimeStamp, channels, n);
+    MatchStatus(channels, n, Snapshot_t::StatusMaskBit(kGOOD), result);
+  }
+
+  //----------------------------------------------------------------------------
+  // Same answers as GetChannelStatus() on each channel, except for channels with no
+  // status: their bits are cleared, so that they are neither good nor bad.
+
+  void SIOVChannelStatusProvider::MatchStatus(raw::ChannelID_t const* channels,
+                                              std::size_t n,
+                                              unsigned int statusMask,
+                                              ResultWord_t* result) const
+  {
+    std::size_t const nWords = ResultWords(n);
     if (fDataSource == DataSource::Default) {
-      if (fDefault.Status() == status) {
-        std::vector<DBChannelID_t> chs;
-        for (DBChannelID_t ch = 0; ch != maxChannel; ++ch) {
-          chs.push_back(ch);
-        }
-        retSet.insert(chs.begin(), chs.end());
-      }
+      bool const selected = statusMask & Snapshot_t::StatusMaskBit(fDefault.Status());
+      std::fill(result, result + nWords, selected ? ~ResultWord_t(0) : 0);
+      if (selected && n % 64) result[nWords - 1] = (ResultWord_t(1) << (n % 64)) - 1;
     }
-    else {
-      std::vector<DBChannelID_t> chs;
-      for (DBChannelID_t ch = 0; ch != maxChannel; ++ch) {
-        if (this->GetChannelStatus(ch).Status() == status) chs.push_back(ch);
-      }
+    else
+      SnapshotFor(fEventTimeStamp)->MatchStatus(channels, n, statusMask, result);
 
-      retSet.insert(chs.begin(), chs.end());
-    }
-    return retSet;
+    if (fNewNoisy.Empty()) return;
+    fNewNoisy.Apply(channels, n, statusMask & Snapshot_t::StatusMaskBit(kNOISY), result);
   }
 
   //----------------------------------------------------------------------------
-  SIOVChannelStatusProvider::ChannelSet_t SIOVChannelStatusProvider::GoodChannels() const
+  // Only channels known to the geometry are reported, and channels flagged noisy in this
+  // event are noisy whatever their status in the snapshot: the views share the snapshot
+  // data unless such channels need to be added (noisy) or removed.
+
+  SIOVChannelStatusProvider::ChannelSpan_t SIOVChannelStatusProvider::MakeSpan(
+    SnapshotPtr_t const& data,
+    Snapshot_t::ChannelList_t const& channels,
+    bool noisy) const
   {
-    return GetChannelsWithStatus(kGOOD);
+    auto const end = std::lower_bound(channels.begin(), channels.end(), GeometryChannels());
+    auto const last = channels.data() + (end - channels.begin());
+    if (fNewNoisy.Empty()) return ChannelSpan_t(channels.data(), last, data);
+    return ChannelSpan_t::Adopt(fNewNoisy.Apply(channels.data(), last, noisy));
   }
 
   //----------------------------------------------------------------------------
-  SIOVChannelStatusProvider::ChannelSet_t SIOVChannelStatusProvider::BadChannels() const
+  SIOVChannelStatusProvider::ChannelMask_t SIOVChannelStatusProvider::MakeMask(
+    SnapshotPtr_t const& data,
+    Snapshot_t::ChannelBits_t const& bits,
+    bool noisy) const
   {
-    ChannelSet_t dead = GetChannelsWithStatus(kDEAD);
-    ChannelSet_t ln = GetChannelsWithStatus(kLOWNOISE);
-    dead.insert(ln.begin(), ln.end());
-    return dead;
+    size_t const size = std::min<size_t>(data->ChannelLimit(), GeometryChannels());
+    if (fNewNoisy.Empty()) return ChannelMask_t(bits.data(), size, data);
+
+    std::vector<ChannelMask_t::word_t> words(bits.begin(),
+                                             bits.begin() + ChannelMask_t::NWords(size));
+    fNewNoisy.Apply(words, size, noisy);
+    return ChannelMask_t::Adopt(std::move(words), size);
   }
 
   //----------------------------------------------------------------------------
-  SIOVChannelStatusProvider::ChannelSet_t SIOVChannelStatusProvider::NoisyChannels() const
+  // The channels flagged noisy in this event are applied as on the database snapshots.
+
+  SIOVChannelStatusProvider::ChannelSpan_t SIOVChannelStatusProvider::DefaultSpan(
+    bool selected,
+    bool noisy) const
+  {
+    std::vector<raw::ChannelID_t> channels(selected ? GeometryChannels() : 0);
+    std::iota(channels.begin(), channels.end(), raw::ChannelID_t(0));
+    if (!fNewNoisy.Empty())
+      channels = fNewNoisy.Apply(channels.data(), channels.data() + channels.size(), noisy);
+    return ChannelSpan_t::Adopt(std::move(channels));
+  }
+
+  //----------------------------------------------------------------------------
+  SIOVChannelStatusProvider::ChannelMask_t SIOVChannelStatusProvider::DefaultMask(
+    bool selected,
+    bool noisy) const
   {
-    return GetChannelsWithStatus(kNOISY);
+    size_t const size = GeometryChannels();
+    std::vector<ChannelMask_t::word_t> words(ChannelMask_t::NWords(size),
+                                             selected ? ~ChannelMask_t::word_t(0) : 0);
+    fNewNoisy.Apply(words, size, noisy);
+    return ChannelMask_t::Adopt(std::move(words), size);
+  }
+
+  //----------------------------------------------------------------------------
+  // The channel count is cached here, so that the channel views do not go
+  // through the geometry service on each call.  Memory is allocated only when
+  // the number of channels changes.
+
+  void SIOVChannelStatusProvider::ResetNoisyChannels()
+  {
+    DBChannelID_t const nChannels = art::ServiceHandle<geo::Geometry const>()->Nchannels();
+    fGeometryChannels = nChannels;
+    if (fNewNoisy.Size() != nChannels)
+      fNewNoisy.Resize(nChannels);
+    else
+      fNewNoisy.Clear();
+  }
+
+  //----------------------------------------------------------------------------
+  // Queries made before the first event read the geometry themselves.
+
+  DBChannelID_t SIOVChannelStatusProvider::GeometryChannels() const
+  {
+    DBChannelID_t const nChannels = fGeometryChannels;
+    if (nChannels) return nChannels;
+    return fGeometryChannels = art::ServiceHandle<geo::Geometry const>()->Nchannels();
   }
 
   //----------------------------------------------------------------------------
@@ -206,11 +397,7 @@ namespace lariov {
     // for c2: ISO C++17 does not allow 'register' storage class specifier
     //register DBChannelID_t const dbch = rawToDBChannel(ch);
     DBChannelID_t const dbch = rawToDBChannel(ch);
-    if (!this->IsBad(dbch) && this->IsPresent(dbch)) {
-      ChannelStatus cs(dbch);
-      cs.SetStatus(kNOISY);
-      fNewNoisy.AddOrReplaceRow(cs);
-    }
+    if (!this->IsBad(dbch) && this->IsPresent(dbch)) fNewNoisy.Add(dbch);
   }
 
   //----------------------------------------------------------------------------
@@ -12,11 +12,21 @@
 // LArSoft libraries
 #include "larcoreobj/SimpleTypesAndConstants/RawTypes.h"
 #include "larevt/CalibrationDBI/IOVData/ChannelStatus.h"
+#include "larevt/CalibrationDBI/IOVData/ChannelStatusSnapshot.h"
 #include "larevt/CalibrationDBI/IOVData/IOVDataConstants.h"
 #include "larevt/CalibrationDBI/IOVData/Snapshot.h"
+#include "larevt/CalibrationDBI/IOVData/SnapshotBuilder.h"
+#include "larevt/CalibrationDBI/IOVData/SnapshotCache.h"
 #include "larevt/CalibrationDBI/Interface/CalibrationDBIFwd.h"
 #include "larevt/CalibrationDBI/Interface/ChannelStatusProvider.h"
 #include "larevt/CalibrationDBI/Providers/DatabaseRetrievalAlg.h"
+#include "larevt/CalibrationDBI/Providers/NoisyChannelOverlay.h"
+#include "larevt/CalibrationDBI/Providers/SIOVColumns.h"
+
+// C/C++ standard libraries
+#include <atomic>
+#include <memory>
+#include <type_traits>
 
 // Utility libraries
 namespace fhicl {
@@ -31,12 +41,27 @@ namespace lariov {
    *
    * This class serves information read from a FHiCL configuration file and/or a database.
    *
+   * Database snapshots are immutable and shared, one per interval of validity;
+   * see SnapshotFor().  Each snapshot carries sorted channel lists and masks
+   * per status; the bulk queries return views sharing them, and the global
+   * channel queries take a time proportional to the size of their result.
+   *
+   * Channels flagged by AddNoisyChannel() are noisy until the next event, on
+   * top of their status in the snapshot; see NoisyChannelOverlay.  The flags
+   * are global to the provider, not kept per schedule.
+   *
    * LArSoft interface to this class is through the service
    * SIOVChannelStatusService.
    */
   class SIOVChannelStatusProvider : public DatabaseRetrievalAlg, public ChannelStatusProvider {
 
+    static_assert(std::is_same<DBChannelID_t, raw::ChannelID_t>::value,
+                  "Channel lists are shared between database and LArSoft channel IDs");
+
   public:
+    using Snapshot_t = ChannelStatusSnapshot;
+    using SnapshotPtr_t = std::shared_ptr<Snapshot_t const>;
+
     /// Constructor
     SIOVChannelStatusProvider(fhicl::ParameterSet const& pset);
 
@@ -46,8 +71,27 @@ namespace lariov {
     //
     // non-interface methods
     //
-    /// Returns Channel Status
-    const ChannelStatus& GetChannelStatus(raw::ChannelID_t channel) const;
+    /**
+     * @brief Returns Channel Status, including the noisy channels flagged in this event
+     *
+     * The status is returned by value (it used to be a reference): the snapshot
+     * holding the row may be released as soon as the current IOV changes.
+     * Throws IOVDataError if the channel has no status.
+     */
+    ChannelStatus GetChannelStatus(raw::ChannelID_t channel) const;
+
+    /// Returns the channel statuses valid at the specified time (not for default source)
+    SnapshotPtr_t SnapshotFor(DBTimeStamp_t ts) const;
+
+    /// Makes ts the current time stamp; returns the interval of validity of the data at ts
+    IOVRange_t SelectTimeStamp(DBTimeStamp_t ts) override;
+
+    /// Returns whether the data come from the conditions database (otherwise
+    /// they are valid at all times)
+    bool UsesDatabase() const { return fDataSource == DataSource::Database; }
+
+    /// Returns the status of all channels for the default source
+    ChannelStatus const& DefaultStatus() const { return fDefault; }
 
     //
     // interface methods
@@ -58,31 +102,36 @@ namespace lariov {
     /// Returns whether the specified channel is physical and connected to wire
     bool IsPresent(raw::ChannelID_t channel) const override
     {
+      Trace(ConditionsTrace::kIsPresent, fEventTimeStamp, channel);
       return GetChannelStatus(channel).IsPresent();
     }
 
     /// Returns whether the specified channel is bad in the current run
     bool IsBad(raw::ChannelID_t channel) const override
     {
-      return GetChannelStatus(channel).IsDead() || GetChannelStatus(channel).IsLowNoise() ||
-             !IsPresent(channel);
+      Trace(ConditionsTrace::kIsBad, fEventTimeStamp, channel);
+      ChannelStatus const cs = GetChannelStatus(channel);
+      return cs.IsDead() || cs.IsLowNoise() || !cs.IsPresent();
     }
 
     /// Returns whether the specified channel is noisy in the current run
     bool IsNoisy(raw::ChannelID_t channel) const override
     {
+      Trace(ConditionsTrace::kIsNoisy, fEventTimeStamp, channel);
       return GetChannelStatus(channel).IsNoisy();
     }
 
     /// Returns whether the specified channel is physical and good
     bool IsGood(raw::ChannelID_t channel) const override
     {
+      Trace(ConditionsTrace::kIsGood, fEventTimeStamp, channel);
       return GetChannelStatus(channel).IsGood();
     }
     /// @}
 
     Status_t Status(raw::ChannelID_t channel) const override
     {
+      Trace(ConditionsTrace::kStatus, fEventTimeStamp, channel);
       return (Status_t)this->GetChannelStatus(channel).Status();
     }
 
@@ -98,6 +147,56 @@ namespace lariov {
     ChannelSet_t NoisyChannels() const override;
     /// @}
 
+    /// @name Bulk channel queries
+    /// @{
+    /// Returns the sorted list of good channel IDs for the current run
+    ChannelSpan_t GoodChannelSpan() const override;
+
+    /// Returns the sorted list of bad channel IDs for the current run
+    ChannelSpan_t BadChannelSpan() const override;
+
+    /// Returns the sorted list of noisy channel IDs for the current run
+    ChannelSpan_t NoisyChannelSpan() const override;
+
+    /// Returns the sorted list of channels with the specified status (a chStatus value);
+    /// throws cet::exception if status is not one
+    ChannelSpan_t ChannelsWithStatus(Status_t status) const override;
+
+    /// Returns the mask of good channels for the current run
+    ChannelMask_t GoodChannelMask() const override;
+
+    /// Returns the mask of bad channels for the current run
+    ChannelMask_t BadChannelMask() const override;
+
+    /// Returns the mask of noisy channels for the current run
+    ChannelMask_t NoisyChannelMask() const override;
+    /// @}
+
+    /// @name Batch channel queries
+    /// One look-up of the snapshot per call, then a branchless pass on its
+    /// packed status array.  Channels with no status get a cleared bit.
+    /// @{
+    /// Sets the bits of the channels physical and connected to wire
+    void ArePresent(raw::ChannelID_t const* channels,
+                    std::size_t n,
+                    ResultWord_t* result) const override;
+
+    /// Sets the bits of the channels bad in the current run
+    void AreBad(raw::ChannelID_t const* channels,
+                std::size_t n,
+                ResultWord_t* result) const override;
+
+    /// Sets the bits of the channels noisy in the current run
+    void AreNoisy(raw::ChannelID_t const* channels,
+                  std::size_t n,
+                  ResultWord_t* result) const override;
+
+    /// Sets the bits of the channels physical and good
+    void AreGood(raw::ChannelID_t const* channels,
+                 std::size_t n,
+                 ResultWord_t* result) const override;
+    /// @}
+
     /// Update event time stamp.
     void UpdateTimeStamp(DBTimeStamp_t ts);
 
@@ -106,31 +205,61 @@ namespace lariov {
     /// Prepares the object to provide information about the specified time
     bool Update(DBTimeStamp_t);
 
-    /// Allows a service to add to the list of noisy channels
+    /// Allows a service to add to the list of noisy channels (thread-safe)
     void AddNoisyChannel(raw::ChannelID_t ch);
 
+    /// Clears the noisy channels flagged in the previous event, and reads the
+    /// number of channels of the geometry again
+    void ResetNoisyChannels();
+
     ///@}
 
     /// Converts LArSoft channel ID in the one proper for the DB
     static DBChannelID_t rawToDBChannel(raw::ChannelID_t channel) { return DBChannelID_t(channel); }
 
   private:
-    /// Do actual database updates.
+    /// Sets the status from its database value; unknown values become kUNKNOWN
+    static void SetDBStatus(ChannelStatus& cs, long status)
+    {
+      cs.SetStatus(ChannelStatus::GetStatusFromInt((int)status));
+    }
 
-    bool DBUpdate() const; // Uses current event time.
-    bool DBUpdate(DBTimeStamp_t ts) const;
+    using Columns_t =
+      SIOVColumns<ChannelStatus, SIOVField<&SIOVChannelStatusProvider::SetDBStatus>>;
 
-    // Time stamps.
+    /// Builds the snapshot for the interval of validity containing ts.
+    SnapshotPtr_t BuildSnapshot(DBTimeStamp_t ts) const;
 
-    DBTimeStamp_t fEventTimeStamp;           // Most recently seen time stamp.
-    mutable DBTimeStamp_t fCurrentTimeStamp; // Time stamp of cached data.
+    std::atomic<DBTimeStamp_t> fEventTimeStamp; // Most recently seen time stamp.
 
     DataSource::ds fDataSource;
-    mutable Snapshot<ChannelStatus> fData; // Lazily updated once per IOV.
-    Snapshot<ChannelStatus> fNewNoisy;     // Updated once per event.
+    SnapshotPtr_t fFixedData;                             // Data from file.
+    mutable SnapshotCache<Snapshot_t> fSnapshots;         // Lazily built once per IOV.
+    NoisyChannelOverlay fNewNoisy;                        // Cleared once per event.
+    mutable std::atomic<DBChannelID_t> fGeometryChannels; // Read once per event.
     ChannelStatus fDefault;
 
-    ChannelSet_t GetChannelsWithStatus(chStatus status) const;
+    /// Views of the channel lists of data, applying this event's noisy channels
+    ChannelSpan_t MakeSpan(SnapshotPtr_t const& data,
+                           Snapshot_t::ChannelList_t const& channels,
+                           bool noisy) const;
+    ChannelMask_t MakeMask(SnapshotPtr_t const& data,
+                           Snapshot_t::ChannelBits_t const& bits,
+                           bool noisy) const;
+
+    /// Views of either all or none of the channels, for the default source,
+    /// with the channels flagged noisy in this event added (noisy) or removed
+    ChannelSpan_t DefaultSpan(bool selected, bool noisy) const;
+    ChannelMask_t DefaultMask(bool selected, bool noisy) const;
+
+    /// Batch query for the channels with one of the statuses in statusMask
+    void MatchStatus(raw::ChannelID_t const* channels,
+                     std::size_t n,
+                     unsigned int statusMask,
+                     ResultWord_t* result) const;
+
+    /// Number of channels in the geometry, as of the last ResetNoisyChannels()
+    DBChannelID_t GeometryChannels() const;
 
   }; // class SIOVChannelStatusProvider
 
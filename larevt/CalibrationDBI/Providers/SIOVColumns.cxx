@@ -0,0 +1,30 @@
+#include "SIOVColumns.h"
+#include "WebError.h"
+
+namespace lariov {
+
+  // Column types as set by DBDataset (web database) and DBFolder (sqlite).
+
+  std::size_t FindSIOVColumn(const DBDataset& data, const char* name, SIOVColumnKind kind)
+  {
+    int const col = data.getColNumber(name);
+    if (col < 0) {
+      throw WebError(std::string("Column ") + name + " is not found in database!");
+    }
+
+    std::string const& type = data.colTypes()[col];
+    bool const integer = (type == "integer" || type == "bigint" || type == "boolean");
+    bool match = false;
+    switch (kind) {
+    case SIOVColumnKind::Integer: match = integer; break;
+    case SIOVColumnKind::Real: match = integer || type == "real"; break;
+    case SIOVColumnKind::Text: match = (type == "text"); break;
+    }
+    if (!match) {
+      throw WebError(std::string("Column ") + name + " has unexpected type " + type + "!");
+    }
+
+    return col;
+  }
+
+} //end namespace lariov
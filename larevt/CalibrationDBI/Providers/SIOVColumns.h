@@ -0,0 +1,171 @@
+/**
+ * \file SIOVColumns.h
+ *
+ * \ingroup WebDBI
+ *
+ * \brief Class def header for a class SIOVColumns
+ */
+
+/** \addtogroup WebDBI
+
+    @{*/
+#ifndef SIOVCOLUMNS_H
+#define SIOVCOLUMNS_H
+
+#include "larevt/CalibrationDBI/IOVData/SnapshotBuilder.h"
+#include "larevt/CalibrationDBI/Providers/DBDataset.h"
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace lariov {
+
+  /// Kind of the values of a database column
+  enum class SIOVColumnKind { Integer, Real, Text };
+
+  /// Returns the index of the column name in data; throws WebError if it is missing or
+  /// holds another kind of values
+  std::size_t FindSIOVColumn(const DBDataset& data, const char* name, SIOVColumnKind kind);
+
+  namespace details {
+
+    /// Decodes one database value into the argument type V of a setter of R
+    template <class R, class V>
+    struct SIOVFieldTraits {
+      using record_type = R;
+      using value_type = std::decay_t<V>;
+
+      static constexpr SIOVColumnKind Kind = std::is_floating_point<value_type>::value ?
+                                               SIOVColumnKind::Real :
+                                             std::is_same<value_type, std::string>::value ?
+                                               SIOVColumnKind::Text :
+                                               SIOVColumnKind::Integer;
+
+      static auto Value(const DBDataset::value_type& cell)
+      {
+        if constexpr (Kind == SIOVColumnKind::Real) {
+          // Real columns may hold integral values, as sqlite types each value.
+          const double* value = std::get_if<double>(&cell);
+          return value_type(value ? *value : std::get<long>(cell));
+        }
+        else if constexpr (Kind == SIOVColumnKind::Text) {
+          return *std::get<std::unique_ptr<std::string>>(cell);
+        }
+        else {
+          return static_cast<value_type>(std::get<long>(cell));
+        }
+      }
+    };
+
+  } // namespace details
+
+  /**
+     \class SIOVField
+     Binds a database column to a setter of a record, at compile time.
+
+     Setter is either a member function `void R::Set(V)` or a function
+     `void Set(R&, V)`.  The kind of the column follows from V: floating
+     point values are read from real (or integer) columns, std::string from
+     text columns, and everything else (integers, booleans, enumerators) from
+     integer columns.
+  */
+  template <auto Setter>
+  struct SIOVField;
+
+  template <class R, class V, void (R::*Setter)(V)>
+  struct SIOVField<Setter> : details::SIOVFieldTraits<R, V> {
+    static void Decode(R& record, const DBDataset::value_type& cell)
+    {
+      (record.*Setter)(details::SIOVFieldTraits<R, V>::Value(cell));
+    }
+  };
+
+  template <class R, class V, void (*Setter)(R&, V)>
+  struct SIOVField<Setter> : details::SIOVFieldTraits<R, V> {
+    static void Decode(R& record, const DBDataset::value_type& cell)
+    {
+      Setter(record, details::SIOVFieldTraits<R, V>::Value(cell));
+    }
+  };
+
+  /**
+     \class SIOVColumns
+     Decodes the rows of a database dataset into records.
+
+     Each of the Fields (see SIOVField) is bound to a column name given at
+     construction.  Decode() looks the columns up once per dataset, checking
+     that they exist and hold the expected kind of values, and then sets the
+     fields of each record by column index, with no lookup by name.  The
+     channel of each record is the one of its row.
+  */
+  template <class Record, class... Fields>
+  class SIOVColumns {
+
+    static_assert((std::is_base_of<typename Fields::record_type, Record>::value && ...),
+                  "SIOVColumns: fields must set members of the record");
+
+  public:
+    using Record_t = Record;
+    static constexpr std::size_t NColumns = sizeof...(Fields);
+    using Names_t = std::array<const char*, NColumns>;
+
+    /// Constructor: names[i] is the column of the i-th field
+    explicit SIOVColumns(const Names_t& names) : fNames(names) {}
+
+    const Names_t& Names() const { return fNames; }
+
+    /// Adds one record per row of data to rows, each a copy of prototype with the row content
+    template <class S>
+    void Decode(const DBDataset& data, const Record& prototype, SnapshotBuilder<S>& rows) const;
+
+  private:
+    using Indices_t = std::array<std::size_t, NColumns>;
+
+    template <std::size_t... I>
+    static void DecodeRow(const DBDataset::DBRow& row,
+                          const Indices_t& columns,
+                          Record& record,
+                          std::index_sequence<I...>)
+    {
+      (Fields::Decode(record, row.getData(columns[I])), ...);
+    }
+
+    Names_t fNames;
+  };
+
+  //=============================================
+  // Class implementation
+  //=============================================
+  template <class Record, class... Fields>
+  template <class S>
+  void SIOVColumns<Record, Fields...>::Decode(const DBDataset& data,
+                                              const Record& prototype,
+                                              SnapshotBuilder<S>& rows) const
+  {
+    // An interval of validity with no rows may come with no columns either.
+    if (data.nrows() == 0) return;
+
+    static constexpr std::array<SIOVColumnKind, NColumns> kinds = {Fields::Kind...};
+    Indices_t columns;
+    for (std::size_t i = 0; i != NColumns; ++i)
+      columns[i] = FindSIOVColumn(data, fNames[i], kinds[i]);
+
+    const auto& channels = data.channels();
+    rows.Reserve(rows.Size() + channels.size());
+    Record record(prototype);
+    for (std::size_t row = 0; row != channels.size(); ++row) {
+      record.SetChannel(channels[row]);
+      DecodeRow(data.getRow(row), columns, record, std::index_sequence_for<Fields...>());
+      rows.Add(record);
+    }
+  }
+
+} //end namespace lariov
+
+#endif
+/** @} */ // end of doxygen group
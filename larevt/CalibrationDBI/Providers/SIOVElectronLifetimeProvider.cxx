@@ -0,0 +1,151 @@
+#include "SIOVElectronLifetimeProvider.h"
+#include "CalibrationFileReader.h"
+
+// art/LArSoft libraries
+#include "cetlib/search_path.h"
+#include "fhiclcpp/ParameterSet.h"
+#include "messagefacility/MessageLogger/MessageLogger.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace lariov {
+
+  //constructor
+  SIOVElectronLifetimeProvider::SIOVElectronLifetimeProvider(fhicl::ParameterSet const& p)
+    : SIOVProvider(p.get<fhicl::ParameterSet>("DatabaseRetrievalAlg"),
+                   "SIOVElectronLifetimeProvider",
+                   FIELD_NAMES)
+  {
+
+    SetTraceType(ConditionsTrace::kElectronLifetime);
+    this->Reconfigure(p);
+  }
+
+  void SIOVElectronLifetimeProvider::Reconfigure(fhicl::ParameterSet const& p)
+  {
+
+    this->DatabaseRetrievalAlg::Reconfigure(p.get<fhicl::ParameterSet>("DatabaseRetrievalAlg"));
+
+    fChannel = p.get<DBChannelID_t>("Channel", 0);
+    fMaxDriftTime = p.get<float>("MaxDriftTime", 10000.);
+    fTableSteps = p.get<unsigned int>("AttenuationTableSteps", 4096);
+
+    auto data = std::make_shared<Snapshot_t>();
+    data->Clear();
+    IOVTimeStamp tmp = IOVTimeStamp::MaxTimeStamp();
+    tmp.SetStamp(tmp.Stamp() - 1, tmp.SubStamp());
+    data->SetIoV(tmp, IOVTimeStamp::MaxTimeStamp());
+    SnapshotBuilder<Snapshot_t> rows;
+
+    bool UseDB = p.get<bool>("UseDB", false);
+    bool UseFile = p.get<bool>("UseFile", false);
+    std::string fileName = p.get<std::string>("FileName", "");
+
+    //priority:  (1) use db, (2) use table, (3) use defaults
+    //If none are specified, use defaults
+    if (UseDB)
+      ResetData(DataSource::Database);
+    else if (UseFile)
+      ResetData(DataSource::File);
+    else
+      ResetData(DataSource::Default);
+
+    if (Source() == DataSource::Default) {
+      ElectronLifetimeContainer defaultLifetime(fChannel);
+
+      defaultLifetime.SetExpOffset(p.get<float>("DefaultExpOffset"));
+      defaultLifetime.SetExpOffsetErr(p.get<float>("DefaultExpOffsetErr"));
+      defaultLifetime.SetTimeConstant(p.get<float>("DefaultTimeConstant"));
+      defaultLifetime.SetTimeConstantErr(p.get<float>("DefaultTimeConstantErr"));
+
+      rows.Add(defaultLifetime);
+    }
+    else if (Source() == DataSource::File) {
+      cet::search_path sp("FW_SEARCH_PATH");
+      std::string abs_fp = sp.find_file(fileName);
+      std::cout << "Using electron lifetime from local file: " << abs_fp << "\n";
+      CalibrationFileReader file(
+        abs_fp, {"exp_offset", "err_exp_offset", "time_constant", "err_time_constant"});
+
+      rows.Reserve(file.NRows());
+      ElectronLifetimeContainer el(0);
+      for (size_t row = 0; row != file.NRows(); ++row) {
+        el.SetChannel(file.Channel(row));
+        el.SetExpOffset(file.Value(row, 0));
+        el.SetExpOffsetErr(file.Value(row, 1));
+        el.SetTimeConstant(file.Value(row, 2));
+        el.SetTimeConstantErr(file.Value(row, 3));
+        rows.Add(el);
+      }
+    }
+    else {
+      std::cout << "Using electron lifetime from conditions database" << std::endl;
+    }
+
+    if (Source() != DataSource::Database) {
+      FinishSnapshot(rows, *data);
+      SetFixedData(std::move(data));
+    }
+  }
+
+  // The attenuation table is computed once per interval of validity.
+
+  void SIOVElectronLifetimeProvider::FinishSnapshot(SnapshotBuilder<Snapshot_t>& rows,
+                                                    Snapshot_t& data) const
+  {
+    rows.Fill(data);
+    data.BuildAttenuationTable(fChannel, fMaxDriftTime, fTableSteps);
+  }
+
+  // Returned by value: the snapshot may be evicted once the returned row is in use.
+
+  ElectronLifetimeContainer SIOVElectronLifetimeProvider::LifetimeContainer() const
+  {
+    return CurrentSnapshot()->GetRow(fChannel);
+  }
+
+  float SIOVElectronLifetimeProvider::Lifetime(float t) const
+  {
+    Trace(ConditionsTrace::kLifetime, EventTimeStamp(), ConditionsTrace::FloatBits(t));
+    return this->LifetimeContainer().TimeConstant();
+  }
+
+  float SIOVElectronLifetimeProvider::Purity() const
+  {
+    Trace(ConditionsTrace::kPurity, EventTimeStamp());
+    return this->LifetimeContainer().ExpOffset();
+  }
+
+  float SIOVElectronLifetimeProvider::LifetimeErr(float t) const
+  {
+    Trace(ConditionsTrace::kLifetimeErr, EventTimeStamp(), ConditionsTrace::FloatBits(t));
+    return this->LifetimeContainer().TimeConstantErr();
+  }
+
+  float SIOVElectronLifetimeProvider::PurityErr() const
+  {
+    Trace(ConditionsTrace::kPurityErr, EventTimeStamp());
+    return this->LifetimeContainer().ExpOffsetErr();
+  }
+
+  float SIOVElectronLifetimeProvider::Attenuation(float t) const
+  {
+    Trace(ConditionsTrace::kAttenuation, EventTimeStamp(), ConditionsTrace::FloatBits(t));
+    return CurrentSnapshot()->Attenuation(t);
+  }
+
+  void SIOVElectronLifetimeProvider::Attenuation(float const* driftTimes,
+                                                 std::size_t n,
+                                                 float* attenuation) const
+  {
+    if (ConditionsTrace::Enabled()) {
+      std::vector<std::uint32_t> bits(n);
+      std::transform(driftTimes, driftTimes + n, bits.begin(), ConditionsTrace::FloatBits);
+      Trace(ConditionsTrace::kAttenuationBatch, EventTimeStamp(), bits.data(), n);
+    }
+    CurrentSnapshot()->Attenuation(driftTimes, n, attenuation);
+  }
+
+} //end namespace lariov
@@ -0,0 +1,91 @@
+/**
+ * \file SIOVElectronLifetimeProvider.h
+ *
+ * \ingroup WebDBI
+ *
+ * \brief Class def header for a class SIOVElectronLifetimeProvider
+ */
+
+#ifndef SIOVELECTRONLIFETIMEPROVIDER_H
+#define SIOVELECTRONLIFETIMEPROVIDER_H
+
+#include "SIOVProvider.h"
+#include "larevt/CalibrationDBI/IOVData/ElectronLifetimeSnapshot.h"
+#include "larevt/CalibrationDBI/Interface/ElectronLifetimeProvider.h"
+
+#include <cstddef>
+
+namespace lariov {
+
+  /**
+   * @brief Retrieves information: electron lifetime
+   *
+   * The electron lifetime is the time constant of the row of the configured
+   * channel, and the purity its exponential offset.  Each interval of validity
+   * comes with a table of the attenuation of the drifting charge, so that
+   * Attenuation() interpolates instead of computing an exponential.
+   *
+   * Configuration parameters
+   * =========================
+   *
+   * - *DatabaseRetrievalAlg* (parameter set, mandatory): configuration for the
+   *   database; see lariov::DatabaseRetrievalAlg
+   * - *UseDB* (boolean, default: false): retrieve information from the database
+   * - *UseFile* (boolean, default: false): retrieve information from a file
+   *   with columns `exp_offset`, `err_exp_offset`, `time_constant` and
+   *   `err_time_constant`
+   * - *FileName* (string, default: ""): file name, in `FW_SEARCH_PATH`
+   * - *Channel* (integer, default: 0): channel holding the lifetime
+   * - *DefaultExpOffset*, *DefaultExpOffsetErr*, *DefaultTimeConstant*,
+   *   *DefaultTimeConstantErr* (real, mandatory for defaults): values used
+   *   when /UseDB/ and /UseFile/ parameters are false
+   * - *MaxDriftTime* (real, default: 10000): largest drift time in the
+   *   attenuation table, in the units of the time constant; longer drift
+   *   times are computed exactly
+   * - *AttenuationTableSteps* (integer, default: 4096): steps in the table
+   */
+  class SIOVElectronLifetimeProvider
+    : public SIOVProvider<ElectronLifetimeSnapshot,
+                          SIOVField<&ElectronLifetimeContainer::SetExpOffset>,
+                          SIOVField<&ElectronLifetimeContainer::SetExpOffsetErr>,
+                          SIOVField<&ElectronLifetimeContainer::SetTimeConstant>,
+                          SIOVField<&ElectronLifetimeContainer::SetTimeConstantErr>>,
+      public ElectronLifetimeProvider {
+
+  public:
+    /// Constructors
+    SIOVElectronLifetimeProvider(fhicl::ParameterSet const& p);
+
+    /// Reconfigure function called by fhicl constructor
+    void Reconfigure(fhicl::ParameterSet const& p) override;
+
+    /// Retrieve electron lifetime information
+    ElectronLifetimeContainer LifetimeContainer() const;
+    float Lifetime(float t) const override;
+    float Purity() const override;
+    float LifetimeErr(float t) const override;
+    float PurityErr() const override;
+
+    /// Fraction of the drifting charge left after the drift time t
+    float Attenuation(float t) const override;
+
+    /// Sets attenuation[i] to Attenuation(driftTimes[i]), for i < n
+    void Attenuation(float const* driftTimes, std::size_t n, float* attenuation) const override;
+
+    //hardcoded information about database folder - useful for debugging cross checks
+    static constexpr Columns_t::Names_t FIELD_NAMES = {"exp_offset",
+                                                       "err_exp_offset",
+                                                       "time_constant",
+                                                       "err_time_constant"};
+
+  private:
+    /// Fills the snapshot from the rows and computes its attenuation table
+    void FinishSnapshot(SnapshotBuilder<Snapshot_t>& rows, Snapshot_t& data) const override;
+
+    DBChannelID_t fChannel;
+    float fMaxDriftTime;
+    unsigned int fTableSteps;
+  };
+} //end namespace lariov
+
+#endif
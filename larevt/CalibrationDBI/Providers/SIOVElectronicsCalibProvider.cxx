@@ -1,4 +1,5 @@
 #include "SIOVElectronicsCalibProvider.h"
+#include "CalibrationFileReader.h"
 
 // art/LArSoft libraries
 #include "art/Framework/Services/Registry/ServiceHandle.h"
@@ -6,17 +7,15 @@
 #include "larcore/Geometry/Geometry.h"
 #include "messagefacility/MessageLogger/MessageLogger.h"
 
-#include <fstream>
-
 namespace lariov {
 
   //constructor
   SIOVElectronicsCalibProvider::SIOVElectronicsCalibProvider(fhicl::ParameterSet const& p)
     : DatabaseRetrievalAlg(p.get<fhicl::ParameterSet>("DatabaseRetrievalAlg"))
     , fEventTimeStamp(0)
-    , fCurrentTimeStamp(0)
   {
 
+    SetTraceType(ConditionsTrace::kElectronicsCalib);
     this->Reconfigure(p);
   }
 
@@ -24,10 +23,15 @@ namespace lariov {
   {
 
     this->DatabaseRetrievalAlg::Reconfigure(p.get<fhicl::ParameterSet>("DatabaseRetrievalAlg"));
-    fData.Clear();
+    fSnapshots.Clear();
+    fFixedData.reset();
+
+    Rows_t data;
+    data.Clear();
     IOVTimeStamp tmp = IOVTimeStamp::MaxTimeStamp();
     tmp.SetStamp(tmp.Stamp() - 1, tmp.SubStamp());
-    fData.SetIoV(tmp, IOVTimeStamp::MaxTimeStamp());
+    data.SetIoV(tmp, IOVTimeStamp::MaxTimeStamp());
+    SnapshotBuilder<Rows_t> rows;
 
     bool UseDB = p.get<bool>("UseDB", false);
     bool UseFile = p.get<bool>("UseFile", false);
@@ -54,59 +58,40 @@ namespace lariov {
       defaultCalib.SetGainErr(default_gain_err);
       defaultCalib.SetShapingTime(default_st);
       defaultCalib.SetShapingTimeErr(default_st_err);
-      defaultCalib.SetExtraInfo(CalibrationExtraInfo("ElectronicsCalib"));
 
-      art::ServiceHandle<geo::Geometry const> geo;
-      for (auto const& wid : geo->Iterate<geo::WireID>()) {
-        DBChannelID_t ch = geo->PlaneWireToChannel(wid);
-        defaultCalib.SetChannel(ch);
-        fData.AddOrReplaceRow(defaultCalib);
-      }
+      // A single record shared by all channels.
+      auto defaults = std::make_shared<Defaults_t>();
+      defaults->SetIoV(data.Start(), data.End());
+      defaults->AddRecord(defaultCalib);
+      defaults->SetAllChannels(art::ServiceHandle<geo::Geometry const>()->Nchannels());
+      fFixedData = std::make_shared<Snapshot_t const>(std::move(defaults));
     }
     else if (fDataSource == DataSource::File) {
       cet::search_path sp("FW_SEARCH_PATH");
       std::string abs_fp = sp.find_file(fileName);
       std::cout << "Using electronics calibrations from local file: " << abs_fp << "\n";
-      std::ifstream file(abs_fp);
-      if (!file) {
-        throw cet::exception("SIOVElectronicsCalibProvider")
-          << "File " << abs_fp << " is not found.";
-      }
+      CalibrationFileReader file(abs_fp,
+                                 {"gain", "gain_err", "shaping_time", "shaping_time_err"});
 
-      std::string line;
+      rows.Reserve(file.NRows());
       ElectronicsCalib dp(0);
-      while (std::getline(file, line)) {
-        size_t current_comma = line.find(',');
-        DBChannelID_t ch = (DBChannelID_t)std::stoi(line.substr(0, current_comma));
-        float gain = std::stof(
-          line.substr(current_comma + 1, line.find(',', current_comma + 1) - (current_comma + 1)));
-
-        current_comma = line.find(',', current_comma + 1);
-        float gain_err = std::stof(
-          line.substr(current_comma + 1, line.find(',', current_comma + 1) - (current_comma + 1)));
-
-        current_comma = line.find(',', current_comma + 1);
-        float shaping_time = std::stof(
-          line.substr(current_comma + 1, line.find(',', current_comma + 1) - (current_comma + 1)));
-
-        current_comma = line.find(',', current_comma + 1);
-        float shaping_time_err = std::stof(line.substr(current_comma + 1));
-
-        CalibrationExtraInfo info("ElectronicsCalib");
-
-        dp.SetChannel(ch);
-        dp.SetGain(gain);
-        dp.SetGainErr(gain_err);
-        dp.SetShapingTime(shaping_time);
-        dp.SetShapingTimeErr(shaping_time_err);
-        dp.SetExtraInfo(info);
-
-        fData.AddOrReplaceRow(dp);
+      for (size_t row = 0; row != file.NRows(); ++row) {
+        dp.SetChannel(file.Channel(row));
+        dp.SetGain(file.Value(row, 0));
+        dp.SetGainErr(file.Value(row, 1));
+        dp.SetShapingTime(file.Value(row, 2));
+        dp.SetShapingTimeErr(file.Value(row, 3));
+        rows.Add(dp);
       }
     }
     else {
       std::cout << "Using electronics calibrations from conditions database" << std::endl;
     }
+
+    if (fDataSource == DataSource::File) {
+      rows.Fill(data);
+      fFixedData = std::make_shared<Snapshot_t const>(std::move(data));
+    }
   }
 
   // This method saves the time stamp of the latest event.
@@ -115,6 +100,7 @@ namespace lariov {
   {
     mf::LogInfo("SIOVElectronicsCalibProvider")
       << "SIOVElectronicsCalibProvider::UpdateTimeStamp called.";
+    Trace(ConditionsTrace::kSelectTime, ts);
     fEventTimeStamp = ts;
   }
 
@@ -123,90 +109,98 @@ namespace lariov {
   bool SIOVElectronicsCalibProvider::Update(DBTimeStamp_t ts)
   {
 
+    Trace(ConditionsTrace::kSelectTime, ts);
     fEventTimeStamp = ts;
-    return DBUpdate(ts);
+    if (fDataSource != DataSource::Database || fSnapshots.Find(ts)) return false;
+    SnapshotFor(ts);
+    return true;
   }
 
-  // Maybe update method cached data (private const version using current event time).
-
-  bool SIOVElectronicsCalibProvider::DBUpdate() const { return DBUpdate(fEventTimeStamp); }
+  // Called by IOVManager only when ts leaves the interval of validity of the current data.
 
-  // Maybe update method cached data (private const version).
-  // This is the function that does the actual work of updating data from database.
-
-  bool SIOVElectronicsCalibProvider::DBUpdate(DBTimeStamp_t ts) const
+  SIOVElectronicsCalibProvider::IOVRange_t SIOVElectronicsCalibProvider::SelectTimeStamp(
+    DBTimeStamp_t ts)
   {
+    Trace(ConditionsTrace::kSelectTime, ts);
+    fEventTimeStamp = ts;
+    if (fDataSource != DataSource::Database) return AllTimes();
+    auto const data = SnapshotFor(ts);
+    return {data->Start(), data->End()};
+  }
 
-    bool result = false;
-    if (fDataSource == DataSource::Database && ts != fCurrentTimeStamp) {
+  // Return the snapshot valid at the specified time, building it if needed.
 
-      mf::LogInfo("SIOVElectronicsCalibProvider")
-        << "SIOVElectronicsCalibProvider::DBUpdate called with new timestamp.";
+  SIOVElectronicsCalibProvider::SnapshotPtr_t SIOVElectronicsCalibProvider::SnapshotFor(
+    DBTimeStamp_t ts) const
+  {
+    if (fDataSource != DataSource::Database) return fFixedData;
+    if (ConditionsMetrics::Enabled()) FolderMetrics::Count(Metrics().snapshotLookups);
+    return fSnapshots.FindOrBuild(ts, [this](DBTimeStamp_t t) { return BuildSnapshot(t); });
+  }
 
-      fCurrentTimeStamp = ts;
+  // This is the function that does the actual work of updating data from database.
+  // Calls are serialized by the snapshot cache.
 
-      // Call non-const base class method.
+  SIOVElectronicsCalibProvider::SnapshotPtr_t SIOVElectronicsCalibProvider::BuildSnapshot(
+    DBTimeStamp_t ts) const
+  {
 
-      result = const_cast<SIOVElectronicsCalibProvider*>(this)->UpdateFolder(ts);
-      if (result) {
-        //DBFolder was updated, so now update the Snapshot
-        fData.Clear();
-        fData.SetIoV(this->Begin(), this->End());
+    mf::LogInfo("SIOVElectronicsCalibProvider")
+      << "SIOVElectronicsCalibProvider::BuildSnapshot called with new timestamp.";
 
-        std::vector<DBChannelID_t> channels;
-        fFolder->GetChannelList(channels);
-        for (auto it = channels.begin(); it != channels.end(); ++it) {
+    // Call non-const base class method; it returns false if the folder data
+    // are already those at ts, which are decoded again below.
 
-          double gain, gain_err, shaping_time, shaping_time_err;
-          fFolder->GetNamedChannelData(*it, "gain", gain);
-          fFolder->GetNamedChannelData(*it, "gain_err", gain_err);
-          fFolder->GetNamedChannelData(*it, "shaping_time", shaping_time);
-          fFolder->GetNamedChannelData(*it, "shaping_time_err", shaping_time_err);
+    const_cast<SIOVElectronicsCalibProvider*>(this)->UpdateFolder(ts);
+    MetricsTimer timer(Metrics().rebuildTime);
 
-          ElectronicsCalib pg(*it);
-          pg.SetGain((float)gain);
-          pg.SetGainErr((float)gain_err);
-          pg.SetShapingTime((float)shaping_time);
-          pg.SetShapingTimeErr((float)shaping_time_err);
-          pg.SetExtraInfo(CalibrationExtraInfo("ElectronicsCalib"));
+    Rows_t data;
+    data.SetIoV(this->Begin(), this->End());
 
-          fData.AddOrReplaceRow(pg);
-        }
-      }
-    }
+    SnapshotBuilder<Rows_t> rows;
+    Columns_t(FIELD_NAMES).Decode(fFolder->CachedData(), ElectronicsCalib(0), rows);
+    rows.Fill(data);
 
-    return result;
+    return KeepCacheUse(std::make_shared<Snapshot_t const>(std::move(data)));
   }
 
-  const ElectronicsCalib& SIOVElectronicsCalibProvider::ElectronicsCalibObject(
-    DBChannelID_t ch) const
+  // By value: the snapshot of the row may be evicted once the call returns.
+
+  ElectronicsCalib SIOVElectronicsCalibProvider::ElectronicsCalibObject(DBChannelID_t ch) const
   {
-    DBUpdate();
-    return fData.GetRow(ch);
+    return SnapshotFor(fEventTimeStamp)->GetRow(ch);
   }
 
   float SIOVElectronicsCalibProvider::Gain(DBChannelID_t ch) const
   {
+    Trace(ConditionsTrace::kElectronicsGain, fEventTimeStamp, ch);
     return this->ElectronicsCalibObject(ch).Gain();
   }
 
   float SIOVElectronicsCalibProvider::GainErr(DBChannelID_t ch) const
   {
+    Trace(ConditionsTrace::kElectronicsGainErr, fEventTimeStamp, ch);
     return this->ElectronicsCalibObject(ch).GainErr();
   }
 
   float SIOVElectronicsCalibProvider::ShapingTime(DBChannelID_t ch) const
   {
+    Trace(ConditionsTrace::kShapingTime, fEventTimeStamp, ch);
     return this->ElectronicsCalibObject(ch).ShapingTime();
   }
 
   float SIOVElectronicsCalibProvider::ShapingTimeErr(DBChannelID_t ch) const
   {
+    Trace(ConditionsTrace::kShapingTimeErr, fEventTimeStamp, ch);
     return this->ElectronicsCalibObject(ch).ShapingTimeErr();
   }
 
+  // The row is a copy, but its extra information is the process-wide shared one, which
+  // does not go away with the snapshot.
+
   CalibrationExtraInfo const& SIOVElectronicsCalibProvider::ExtraInfo(DBChannelID_t ch) const
   {
+    Trace(ConditionsTrace::kElectronicsExtraInfo, fEventTimeStamp, ch);
     return this->ElectronicsCalibObject(ch).ExtraInfo();
   }
 
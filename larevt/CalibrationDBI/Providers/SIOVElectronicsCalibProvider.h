@@ -12,11 +12,19 @@
 #define SIOVELECTRONICSCALIBPROVIDER_H
 
 #include "DatabaseRetrievalAlg.h"
+#include "SIOVColumns.h"
 #include "larevt/CalibrationDBI/IOVData/ElectronicsCalib.h"
 #include "larevt/CalibrationDBI/IOVData/IOVDataConstants.h"
+#include "larevt/CalibrationDBI/IOVData/ProviderSnapshot.h"
 #include "larevt/CalibrationDBI/IOVData/Snapshot.h"
+#include "larevt/CalibrationDBI/IOVData/SnapshotBuilder.h"
+#include "larevt/CalibrationDBI/IOVData/SnapshotCache.h"
+#include "larevt/CalibrationDBI/IOVData/UniformSnapshot.h"
 #include "larevt/CalibrationDBI/Interface/ElectronicsCalibProvider.h"
 
+#include <atomic>
+#include <memory>
+
 namespace lariov {
 
   /**
@@ -38,11 +46,19 @@ namespace lariov {
    *   when /UseDB/ and /UseFile/ parameters are false
    * - *DefaultShapingTimeErr* (real, default: ): Shaping Time uncertainty returned
    *   when /UseDB/ and /UseFile/ parameters are false
+   *
+   * Default values are stored once for all channels (see UniformSnapshot), and
+   * SnapshotFor() returns them in that form (see ProviderSnapshot).
    */
   class SIOVElectronicsCalibProvider : public DatabaseRetrievalAlg,
                                        public ElectronicsCalibProvider {
 
   public:
+    using Rows_t = Snapshot<ElectronicsCalib>;
+    using Snapshot_t = ProviderSnapshot<Rows_t>;
+    using SnapshotPtr_t = std::shared_ptr<Snapshot_t const>;
+    using Defaults_t = UniformSnapshot<ElectronicsCalib>;
+
     /// Constructors
     SIOVElectronicsCalibProvider(fhicl::ParameterSet const& p);
 
@@ -55,28 +71,50 @@ namespace lariov {
     /// Update Snapshot and inherited DBFolder if using database.  Return true if updated
     bool Update(DBTimeStamp_t ts);
 
+    /// Returns the data valid at the specified time
+    SnapshotPtr_t SnapshotFor(DBTimeStamp_t ts) const;
+
+    /// Makes ts the current time stamp; returns the interval of validity of the data at ts
+    IOVRange_t SelectTimeStamp(DBTimeStamp_t ts) override;
+
+    /// Returns whether the data come from the conditions database (otherwise
+    /// they are valid at all times)
+    bool UsesDatabase() const { return fDataSource == DataSource::Database; }
+
     /// Retrieve electronics calibration information
-    const ElectronicsCalib& ElectronicsCalibObject(DBChannelID_t ch) const;
+    ElectronicsCalib ElectronicsCalibObject(DBChannelID_t ch) const;
     float Gain(DBChannelID_t ch) const override;
     float GainErr(DBChannelID_t ch) const override;
     float ShapingTime(DBChannelID_t ch) const override;
     float ShapingTimeErr(DBChannelID_t ch) const override;
+
+    /// Returns the extra information of channel ch; all rows share
+    /// ElectronicsCalib::EmptyExtraInfo(), so the reference outlives the snapshots
     CalibrationExtraInfo const& ExtraInfo(DBChannelID_t ch) const override;
 
-  private:
-    /// Do actual database updates.
+    /// Database columns, bound to the calibration fields
+    using Columns_t = SIOVColumns<ElectronicsCalib,
+                                  SIOVField<&ElectronicsCalib::SetGain>,
+                                  SIOVField<&ElectronicsCalib::SetGainErr>,
+                                  SIOVField<&ElectronicsCalib::SetShapingTime>,
+                                  SIOVField<&ElectronicsCalib::SetShapingTimeErr>>;
 
-    bool DBUpdate() const; // Uses current event time.
-    bool DBUpdate(DBTimeStamp_t ts) const;
+    //hardcoded information about database folder - useful for debugging cross checks
+    static constexpr Columns_t::Names_t FIELD_NAMES = {"gain",
+                                                       "gain_err",
+                                                       "shaping_time",
+                                                       "shaping_time_err"};
 
-    // Time stamps.
+  private:
+    /// Builds the snapshot for the interval of validity containing ts.
+    SnapshotPtr_t BuildSnapshot(DBTimeStamp_t ts) const;
 
-    DBTimeStamp_t fEventTimeStamp;           // Most recently seen time stamp.
-    mutable DBTimeStamp_t fCurrentTimeStamp; // Time stamp of cached data.
+    std::atomic<DBTimeStamp_t> fEventTimeStamp; // Most recently seen time stamp.
 
     DataSource::ds fDataSource;
 
-    mutable Snapshot<ElectronicsCalib> fData;
+    SnapshotPtr_t fFixedData;                     // Data from file or defaults.
+    mutable SnapshotCache<Snapshot_t> fSnapshots; // Database data, one per IOV.
   };
 } //end namespace lariov
 
@@ -1,4 +1,5 @@
 #include "SIOVPmtGainProvider.h"
+#include "CalibrationFileReader.h"
 
 // art/LArSoft libraries
 #include "art/Framework/Services/Registry/ServiceHandle.h"
@@ -6,17 +7,16 @@
 #include "larcore/Geometry/Geometry.h"
 #include "messagefacility/MessageLogger/MessageLogger.h"
 
-#include <fstream>
-
 namespace lariov {
 
   //constructor
   SIOVPmtGainProvider::SIOVPmtGainProvider(fhicl::ParameterSet const& p)
-    : DatabaseRetrievalAlg(p.get<fhicl::ParameterSet>("DatabaseRetrievalAlg"))
-    , fEventTimeStamp(0)
-    , fCurrentTimeStamp(0)
+    : SIOVProvider(p.get<fhicl::ParameterSet>("DatabaseRetrievalAlg"),
+                   "SIOVPmtGainProvider",
+                   FIELD_NAMES)
   {
 
+    SetTraceType(ConditionsTrace::kPmtGain);
     this->Reconfigure(p);
   }
 
@@ -24,10 +24,13 @@ namespace lariov {
   {
 
     this->DatabaseRetrievalAlg::Reconfigure(p.get<fhicl::ParameterSet>("DatabaseRetrievalAlg"));
-    fData.Clear();
+
+    auto data = std::make_shared<Snapshot_t>();
+    data->Clear();
     IOVTimeStamp tmp = IOVTimeStamp::MaxTimeStamp();
     tmp.SetStamp(tmp.Stamp() - 1, tmp.SubStamp());
-    fData.SetIoV(tmp, IOVTimeStamp::MaxTimeStamp());
+    data->SetIoV(tmp, IOVTimeStamp::MaxTimeStamp());
+    SnapshotBuilder<Snapshot_t> rows;
 
     bool UseDB = p.get<bool>("UseDB", false);
     bool UseFile = p.get<bool>("UseFile", false);
@@ -36,13 +39,13 @@ namespace lariov {
     //priority:  (1) use db, (2) use table, (3) use defaults
     //If none are specified, use defaults
     if (UseDB)
-      fDataSource = DataSource::Database;
+      ResetData(DataSource::Database);
     else if (UseFile)
-      fDataSource = DataSource::File;
+      ResetData(DataSource::File);
     else
-      fDataSource = DataSource::Default;
+      ResetData(DataSource::Default);
 
-    if (fDataSource == DataSource::Default) {
+    if (Source() == DataSource::Default) {
       float default_gain = p.get<float>("DefaultGain");
       float default_gain_err = p.get<float>("DefaultGainErr");
 
@@ -50,131 +53,63 @@ namespace lariov {
 
       defaultGain.SetGain(default_gain);
       defaultGain.SetGainErr(default_gain_err);
-      defaultGain.SetExtraInfo(CalibrationExtraInfo("PmtGain"));
 
       art::ServiceHandle<geo::Geometry const> geo;
       for (unsigned int od = 0; od != geo->NOpDets(); ++od) {
         if (geo->IsValidOpChannel(od)) {
           defaultGain.SetChannel(od);
-          fData.AddOrReplaceRow(defaultGain);
+          rows.Add(defaultGain);
         }
       }
     }
-    else if (fDataSource == DataSource::File) {
+    else if (Source() == DataSource::File) {
       cet::search_path sp("FW_SEARCH_PATH");
       std::string abs_fp = sp.find_file(fileName);
       std::cout << "Using pmt gains from local file: " << abs_fp << "\n";
-      std::ifstream file(abs_fp);
-      if (!file) {
-        throw cet::exception("SIOVPmtGainProvider") << "File " << abs_fp << " is not found.";
-      }
+      CalibrationFileReader file(abs_fp, {"gain", "gain_err"});
 
-      std::string line;
+      rows.Reserve(file.NRows());
       PmtGain dp(0);
-      while (std::getline(file, line)) {
-        if (line[0] == '#') continue;
-        size_t current_comma = line.find(',');
-        DBChannelID_t ch = (DBChannelID_t)std::stoi(line.substr(0, current_comma));
-        float gain = std::stof(
-          line.substr(current_comma + 1, line.find(',', current_comma + 1) - (current_comma + 1)));
-
-        current_comma = line.find(',', current_comma + 1);
-        float gain_err = std::stof(line.substr(current_comma + 1));
-
-        CalibrationExtraInfo info("PmtGain");
-
-        dp.SetChannel(ch);
-        dp.SetGain(gain);
-        dp.SetGainErr(gain_err);
-        dp.SetExtraInfo(info);
-
-        fData.AddOrReplaceRow(dp);
+      for (size_t row = 0; row != file.NRows(); ++row) {
+        dp.SetChannel(file.Channel(row));
+        dp.SetGain(file.Value(row, 0));
+        dp.SetGainErr(file.Value(row, 1));
+        rows.Add(dp);
       }
     }
     else {
       std::cout << "Using pmt gains from conditions database" << std::endl;
     }
-  }
 
-  // This method saves the time stamp of the latest event.
-
-  void SIOVPmtGainProvider::UpdateTimeStamp(DBTimeStamp_t ts)
-  {
-    mf::LogInfo("SIOVPmtGainProvider") << "SIOVPmtGainProvider::UpdateTimeStamp called.";
-    fEventTimeStamp = ts;
-  }
-
-  // Maybe update method cached data (public non-const version).
-
-  bool SIOVPmtGainProvider::Update(DBTimeStamp_t ts)
-  {
-
-    fEventTimeStamp = ts;
-    return DBUpdate(ts);
+    rows.Fill(*data);
+    if (Source() != DataSource::Database) SetFixedData(std::move(data));
   }
 
-  // Maybe update method cached data (private const version using current event time).
-
-  bool SIOVPmtGainProvider::DBUpdate() const { return DBUpdate(fEventTimeStamp); }
+  // A copy, since the current snapshot may be replaced by another event.
 
-  // Maybe update method cached data (private const version).
-  // This is the function that does the actual work of updating data from database.
-
-  bool SIOVPmtGainProvider::DBUpdate(DBTimeStamp_t ts) const
+  PmtGain SIOVPmtGainProvider::PmtGainObject(DBChannelID_t ch) const
   {
-
-    bool result = false;
-    if (fDataSource == DataSource::Database && ts != fCurrentTimeStamp) {
-
-      mf::LogInfo("SIOVPmtGainProvider")
-        << "SIOVPmtGainProvider::DBUpdate called with new timestamp.";
-
-      fCurrentTimeStamp = ts;
-
-      // Call non-const base class method.
-
-      result = const_cast<SIOVPmtGainProvider*>(this)->UpdateFolder(ts);
-      if (result) {
-        //DBFolder was updated, so now update the Snapshot
-        fData.Clear();
-        fData.SetIoV(this->Begin(), this->End());
-
-        std::vector<DBChannelID_t> channels;
-        fFolder->GetChannelList(channels);
-        for (auto it = channels.begin(); it != channels.end(); ++it) {
-
-          double gain, gain_err;
-          fFolder->GetNamedChannelData(*it, "gain", gain);
-          fFolder->GetNamedChannelData(*it, "gain_sigma", gain_err);
-
-          PmtGain pg(*it);
-          pg.SetGain((float)gain);
-          pg.SetGainErr((float)gain_err);
-          pg.SetExtraInfo(CalibrationExtraInfo("PmtGain"));
-
-          fData.AddOrReplaceRow(pg);
-        }
-      }
-    }
-
-    return result;
+    return CurrentSnapshot()->GetRow(ch);
   }
 
-  const PmtGain& SIOVPmtGainProvider::PmtGainObject(DBChannelID_t ch) const
+  float SIOVPmtGainProvider::Gain(DBChannelID_t ch) const
   {
-    DBUpdate();
-    return fData.GetRow(ch);
+    Trace(ConditionsTrace::kPmtGainValue, EventTimeStamp(), ch);
+    return this->PmtGainObject(ch).Gain();
   }
 
-  float SIOVPmtGainProvider::Gain(DBChannelID_t ch) const { return this->PmtGainObject(ch).Gain(); }
-
   float SIOVPmtGainProvider::GainErr(DBChannelID_t ch) const
   {
+    Trace(ConditionsTrace::kPmtGainErr, EventTimeStamp(), ch);
     return this->PmtGainObject(ch).GainErr();
   }
 
+  // The row is a copy, but its extra information is the process-wide shared one, which
+  // does not go away with the snapshot.
+
   CalibrationExtraInfo const& SIOVPmtGainProvider::ExtraInfo(DBChannelID_t ch) const
   {
+    Trace(ConditionsTrace::kPmtExtraInfo, EventTimeStamp(), ch);
     return this->PmtGainObject(ch).ExtraInfo();
   }
 
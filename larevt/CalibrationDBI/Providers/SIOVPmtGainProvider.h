@@ -11,8 +11,7 @@
 #ifndef SIOVPMTGAINPROVIDER_H
 #define SIOVPMTGAINPROVIDER_H
 
-#include "DatabaseRetrievalAlg.h"
-#include "larevt/CalibrationDBI/IOVData/IOVDataConstants.h"
+#include "SIOVProvider.h"
 #include "larevt/CalibrationDBI/IOVData/PmtGain.h"
 #include "larevt/CalibrationDBI/IOVData/Snapshot.h"
 #include "larevt/CalibrationDBI/Interface/PmtGainProvider.h"
@@ -35,7 +34,11 @@ namespace lariov {
    * - *DefaultGainErr* (real, default: ): Gain uncertainty returned
    *   when /UseDB/ and /UseFile/ parameters are false
    */
-  class SIOVPmtGainProvider : public DatabaseRetrievalAlg, public PmtGainProvider {
+  class SIOVPmtGainProvider
+    : public SIOVProvider<Snapshot<PmtGain>,
+                          SIOVField<&PmtGain::SetGain>,
+                          SIOVField<&PmtGain::SetGainErr>>,
+      public PmtGainProvider {
 
   public:
     /// Constructors
@@ -44,32 +47,17 @@ namespace lariov {
     /// Reconfigure function called by fhicl constructor
     void Reconfigure(fhicl::ParameterSet const& p) override;
 
-    /// Update event time stamp.
-    void UpdateTimeStamp(DBTimeStamp_t ts);
-
-    /// Update Snapshot and inherited DBFolder if using database.  Return true if updated
-    bool Update(DBTimeStamp_t ts);
-
     /// Retrieve gain information
-    const PmtGain& PmtGainObject(DBChannelID_t ch) const;
+    PmtGain PmtGainObject(DBChannelID_t ch) const;
     float Gain(DBChannelID_t ch) const override;
     float GainErr(DBChannelID_t ch) const override;
-    CalibrationExtraInfo const& ExtraInfo(DBChannelID_t ch) const override;
-
-  private:
-    /// Do actual database updates.
 
-    bool DBUpdate() const; // Uses current event time.
-    bool DBUpdate(DBTimeStamp_t ts) const;
-
-    // Time stamps.
-
-    DBTimeStamp_t fEventTimeStamp;           // Most recently seen time stamp.
-    mutable DBTimeStamp_t fCurrentTimeStamp; // Time stamp of cached data.
-
-    DataSource::ds fDataSource;
+    /// Returns the extra information of channel ch; all rows share
+    /// PmtGain::EmptyExtraInfo(), so the reference outlives the snapshots
+    CalibrationExtraInfo const& ExtraInfo(DBChannelID_t ch) const override;
 
-    mutable Snapshot<PmtGain> fData;
+    //hardcoded information about database folder - useful for debugging cross checks
+    static constexpr Columns_t::Names_t FIELD_NAMES = {"gain", "gain_sigma"};
   };
 } //end namespace lariov
 
@@ -0,0 +1,185 @@
+/**
+ * \file SIOVProvider.h
+ *
+ * \ingroup WebDBI
+ *
+ * \brief Class def header for a class SIOVProvider
+ */
+
+/** \addtogroup WebDBI
+
+    @{*/
+#ifndef SIOVPROVIDER_H
+#define SIOVPROVIDER_H
+
+#include "DatabaseRetrievalAlg.h"
+#include "SIOVColumns.h"
+#include "larevt/CalibrationDBI/IOVData/IOVDataConstants.h"
+#include "larevt/CalibrationDBI/IOVData/SnapshotBuilder.h"
+#include "larevt/CalibrationDBI/IOVData/SnapshotCache.h"
+#include "messagefacility/MessageLogger/MessageLogger.h"
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace lariov {
+
+  /**
+   * @brief Database retrieval of a calibration with a single interval of validity
+   *
+   * Holds what the SIOV providers have in common: the choice of the data
+   * source, the data read from file or defaults, and the cache of the
+   * database snapshots, one per interval of validity.  Database rows are
+   * decoded into Snapshot::value_type records by SIOVColumns, through the
+   * Fields (see SIOVField), and the column names given at construction.
+   *
+   * Derived classes fill the data from file or defaults in their
+   * Reconfigure(), and may customize the database snapshots by overriding
+   * RowPrototype() and FinishSnapshot().
+    *
+   * SnapshotFor() may resolve different time stamps concurrently, and its
+   * lookups take no lock.  The accessors, though, answer for the latest time
+   * stamp passed to Update() or SelectTimeStamp(), which all the callers
+   * share: the services built on them support a single schedule.
+   */
+  template <class Snapshot, class... Fields>
+  class SIOVProvider : public DatabaseRetrievalAlg {
+
+  public:
+    using Snapshot_t = Snapshot;
+    using SnapshotPtr_t = std::shared_ptr<Snapshot_t const>;
+    using Record_t = typename Snapshot_t::value_type;
+    using Columns_t = SIOVColumns<Record_t, Fields...>;
+
+    /// Update event time stamp.
+    void UpdateTimeStamp(DBTimeStamp_t ts);
+
+    /// Update Snapshot and inherited DBFolder if using database.  Return true if updated
+    bool Update(DBTimeStamp_t ts);
+
+    /// Returns the data valid at the specified time
+    SnapshotPtr_t SnapshotFor(DBTimeStamp_t ts) const;
+
+    /// Makes ts the current time stamp; returns the interval of validity of the data at ts
+    IOVRange_t SelectTimeStamp(DBTimeStamp_t ts) override;
+
+  protected:
+    /// Constructor: name labels the messages, columns are the names of the Fields
+    SIOVProvider(fhicl::ParameterSet const& dbConfig,
+                 std::string name,
+                 typename Columns_t::Names_t const& columns)
+      : DatabaseRetrievalAlg(dbConfig), fName(std::move(name)), fColumns(columns)
+    {}
+
+    /// Selects the data source and drops all the data
+    void ResetData(DataSource::ds source);
+
+    /// Sets the data returned when the source is not the database
+    void SetFixedData(SnapshotPtr_t data) { fFixedData = std::move(data); }
+
+    DataSource::ds Source() const { return fDataSource; }
+
+    /// Returns the data valid for the latest event
+    SnapshotPtr_t CurrentSnapshot() const { return SnapshotFor(fEventTimeStamp); }
+
+    DBTimeStamp_t EventTimeStamp() const { return fEventTimeStamp; }
+
+    /// Record copied into each database row; called once per interval of validity
+    virtual Record_t RowPrototype() const { return Record_t(0); }
+
+    /// Moves the rows into the snapshot
+    virtual void FinishSnapshot(SnapshotBuilder<Snapshot_t>& rows, Snapshot_t& data) const
+    {
+      rows.Fill(data);
+    }
+
+  private:
+    /// Builds the snapshot for the interval of validity containing ts.
+    SnapshotPtr_t BuildSnapshot(DBTimeStamp_t ts) const;
+
+    std::string fName;
+    Columns_t fColumns;
+
+    std::atomic<DBTimeStamp_t> fEventTimeStamp{0}; // Most recently seen time stamp.
+
+    DataSource::ds fDataSource = DataSource::Default;
+
+    SnapshotPtr_t fFixedData;                     // Data from file or defaults.
+    mutable SnapshotCache<Snapshot_t> fSnapshots; // Database data, one per IOV.
+  };
+
+  //=============================================
+  // Class implementation
+  //=============================================
+  template <class Snapshot, class... Fields>
+  void SIOVProvider<Snapshot, Fields...>::UpdateTimeStamp(DBTimeStamp_t ts)
+  {
+    mf::LogInfo(fName) << fName << "::UpdateTimeStamp called.";
+    this->Trace(ConditionsTrace::kSelectTime, ts);
+    fEventTimeStamp = ts;
+  }
+
+  template <class Snapshot, class... Fields>
+  bool SIOVProvider<Snapshot, Fields...>::Update(DBTimeStamp_t ts)
+  {
+    this->Trace(ConditionsTrace::kSelectTime, ts);
+    fEventTimeStamp = ts;
+    if (fDataSource != DataSource::Database || fSnapshots.Find(ts)) return false;
+    SnapshotFor(ts);
+    return true;
+  }
+
+  template <class Snapshot, class... Fields>
+  auto SIOVProvider<Snapshot, Fields...>::SnapshotFor(DBTimeStamp_t ts) const -> SnapshotPtr_t
+  {
+    if (fDataSource != DataSource::Database) return fFixedData;
+    if (ConditionsMetrics::Enabled()) FolderMetrics::Count(this->Metrics().snapshotLookups);
+    return fSnapshots.FindOrBuild(ts, [this](DBTimeStamp_t t) { return BuildSnapshot(t); });
+  }
+
+  template <class Snapshot, class... Fields>
+  auto SIOVProvider<Snapshot, Fields...>::SelectTimeStamp(DBTimeStamp_t ts) -> IOVRange_t
+  {
+    this->Trace(ConditionsTrace::kSelectTime, ts);
+    fEventTimeStamp = ts;
+    if (fDataSource != DataSource::Database) return AllTimes();
+    auto const data = SnapshotFor(ts);
+    return {data->Start(), data->End()};
+  }
+
+  template <class Snapshot, class... Fields>
+  void SIOVProvider<Snapshot, Fields...>::ResetData(DataSource::ds source)
+  {
+    fDataSource = source;
+    fSnapshots.Clear();
+    fFixedData.reset();
+  }
+
+  // Calls are serialized by the snapshot cache.
+
+  template <class Snapshot, class... Fields>
+  auto SIOVProvider<Snapshot, Fields...>::BuildSnapshot(DBTimeStamp_t ts) const -> SnapshotPtr_t
+  {
+    mf::LogInfo(fName) << fName << "::BuildSnapshot called with new timestamp.";
+
+    // Call non-const base class method (false only means no new data were read).
+
+    const_cast<SIOVProvider*>(this)->UpdateFolder(ts);
+    MetricsTimer timer(this->Metrics().rebuildTime);
+
+    auto data = std::make_shared<Snapshot_t>();
+    data->SetIoV(this->Begin(), this->End());
+
+    SnapshotBuilder<Snapshot_t> rows;
+    fColumns.Decode(fFolder->CachedData(), RowPrototype(), rows);
+    FinishSnapshot(rows, *data);
+
+    return KeepCacheUse(SnapshotPtr_t(std::move(data)));
+  }
+
+} //end namespace lariov
+
+#endif
+/** @} */ // end of doxygen group
@@ -0,0 +1,93 @@
+/**
+ * \file ConditionsMetricsService_service.cc
+ *
+ * \ingroup WebDBI
+ *
+ * \brief art service reporting the conditions access metrics
+ */
+
+#include "art/Framework/Services/Registry/ActivityRegistry.h"
+#include "art/Framework/Services/Registry/ServiceDefinitionMacros.h"
+#include "fhiclcpp/ParameterSet.h"
+#include "larevt/CalibrationDBI/Providers/ConditionsMetrics.h"
+#include "larevt/CalibrationDBI/Providers/ConditionsTrace.h"
+#include "messagefacility/MessageLogger/MessageLogger.h"
+
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace lariov {
+
+  /**
+     \class ConditionsMetricsService
+     Enables the recording of the conditions access metrics (see
+     ConditionsMetrics) and reports them at the end of the job.
+
+     Configuration parameters:
+     - `PrintSummary` (default: true): logs a table with one line per folder
+     - `JSONFileName` (default: "conditions_metrics.json"): file the metrics
+       are written to in JSON format; none is written if empty
+     - `TraceFileName` (default: ""): file the calls to the providers are
+       recorded into (see ConditionsTrace), to be replayed with
+       replay_conditions_trace; no trace is recorded if empty
+  */
+  class ConditionsMetricsService {
+
+  public:
+    ConditionsMetricsService(fhicl::ParameterSet const& pset, art::ActivityRegistry& reg);
+
+  private:
+    void PostEndJob();
+
+    bool fPrintSummary;
+    std::string fJSONFileName;
+    std::string fTraceFileName;
+  };
+} //end namespace lariov
+
+DECLARE_ART_SERVICE(lariov::ConditionsMetricsService, SHARED)
+
+namespace lariov {
+
+  ConditionsMetricsService::ConditionsMetricsService(fhicl::ParameterSet const& pset,
+                                                     art::ActivityRegistry& reg)
+    : fPrintSummary(pset.get<bool>("PrintSummary", true))
+    , fJSONFileName(pset.get<std::string>("JSONFileName", "conditions_metrics.json"))
+    , fTraceFileName(pset.get<std::string>("TraceFileName", ""))
+  {
+    ConditionsMetrics::Enable();
+    if (!fTraceFileName.empty()) ConditionsTrace::Instance().Start(fTraceFileName);
+
+    reg.sPostEndJob.watch(this, &ConditionsMetricsService::PostEndJob);
+  }
+
+  void ConditionsMetricsService::PostEndJob()
+  {
+    if (!fTraceFileName.empty()) {
+      std::uint64_t const calls = ConditionsTrace::Instance().Stop();
+      mf::LogInfo("ConditionsMetricsService")
+        << "Recorded " << calls << " conditions calls in " << fTraceFileName;
+    }
+
+    auto const& metrics = ConditionsMetrics::Instance();
+
+    if (fPrintSummary) {
+      std::ostringstream summary;
+      metrics.WriteSummary(summary);
+      mf::LogInfo("ConditionsMetricsService") << "Conditions access summary:\n" << summary.str();
+    }
+
+    if (fJSONFileName.empty()) return;
+    std::ofstream out(fJSONFileName);
+    metrics.WriteJSON(out);
+    if (!out) {
+      mf::LogError("ConditionsMetricsService")
+        << "Failed to write the conditions access metrics to " << fJSONFileName;
+    }
+  }
+
+} //end namespace lariov
+
+DEFINE_ART_SERVICE(lariov::ConditionsMetricsService)
@@ -0,0 +1,70 @@
+/**
+ * \file IOVManagerService.h
+ *
+ * \ingroup WebDBI
+ *
+ * \brief Class def header for a class IOVManagerService
+ */
+
+#ifndef IOVMANAGERSERVICE_H
+#define IOVMANAGERSERVICE_H
+
+#include "art/Framework/Services/Registry/ServiceDeclarationMacros.h"
+#include "larevt/CalibrationDBI/Providers/IOVManager.h"
+
+#include <string>
+#include <utility>
+
+namespace art {
+  class ActivityRegistry;
+  class Event;
+  class Run;
+  class ScheduleContext;
+}
+
+namespace fhicl {
+  class ParameterSet;
+}
+
+namespace lariov {
+
+  class DatabaseRetrievalAlg;
+
+  /**
+     \class IOVManagerService
+     art service moving the registered database providers to the time of each
+     event (see IOVManager).  The SIOV services register their provider with
+     it when configured with `UseIOVManager: true`, instead of updating their
+     provider before every event themselves.
+
+     Configuration parameters:
+     - `ParallelLoad` (default: true): loads the data of the providers
+       concurrently (see IOVManager::SetParallel())
+     - `WarmUpAtBeginRun` (default: true): loads the data valid at the start
+       of each run before its first event, if the run has a start time
+  */
+  class IOVManagerService {
+
+  public:
+    IOVManagerService(fhicl::ParameterSet const& pset, art::ActivityRegistry& reg);
+
+    /// Adds a provider, which must live as long as the service
+    void Register(DatabaseRetrievalAlg& provider, std::string name)
+    {
+      fManager.Register(provider, std::move(name));
+    }
+
+    IOVManager const& Manager() const { return fManager; }
+
+  private:
+    void PreBeginRun(const art::Run& run);
+    void PreProcessEvent(const art::Event& evt, art::ScheduleContext);
+
+    IOVManager fManager;
+    bool fWarmUpAtBeginRun;
+  };
+} //end namespace lariov
+
+DECLARE_ART_SERVICE(lariov::IOVManagerService, SHARED)
+
+#endif
@@ -0,0 +1,52 @@
+#include "larevt/CalibrationDBI/Services/IOVManagerService.h"
+
+#include "art/Framework/Principal/Event.h"
+#include "art/Framework/Principal/Run.h"
+#include "art/Framework/Services/Registry/ActivityRegistry.h"
+#include "art/Framework/Services/Registry/ServiceDefinitionMacros.h"
+#include "art/Persistency/Provenance/ScheduleContext.h"
+#include "fhiclcpp/ParameterSet.h"
+#include "messagefacility/MessageLogger/MessageLogger.h"
+
+#include <exception>
+
+namespace lariov {
+
+  IOVManagerService::IOVManagerService(fhicl::ParameterSet const& pset,
+                                       art::ActivityRegistry& reg)
+    : fWarmUpAtBeginRun(pset.get<bool>("WarmUpAtBeginRun", true))
+  {
+    fManager.SetParallel(pset.get<bool>("ParallelLoad", true));
+
+    //register callback to load the data valid at the run start before its first event
+    reg.sPreBeginRun.watch(this, &IOVManagerService::PreBeginRun);
+
+    //register callback to update the providers before each event is processed
+    reg.sPreProcessEvent.watch(this, &IOVManagerService::PreProcessEvent);
+  }
+
+  void IOVManagerService::PreBeginRun(const art::Run& run)
+  {
+    DBTimeStamp_t const ts = run.beginTime().value();
+    if (!fWarmUpAtBeginRun || ts == 0) return;
+
+    // Failures are not fatal here: the data may come from the input file (see
+    // CalibrationPayloadReader), which is read only after this callback.
+    try {
+      fManager.Update(ts);
+    }
+    catch (std::exception const& e) {
+      mf::LogWarning("IOVManagerService")
+        << "Loading of the conditions data at the start of run " << run.run()
+        << " failed, deferred to its first event: " << e.what();
+    }
+  }
+
+  void IOVManagerService::PreProcessEvent(const art::Event& evt, art::ScheduleContext)
+  {
+    fManager.Update(evt.time().value());
+  }
+
+} //end namespace lariov
+
+DEFINE_ART_SERVICE(lariov::IOVManagerService)
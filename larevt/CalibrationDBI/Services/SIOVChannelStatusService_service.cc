@@ -1,11 +1,14 @@
 #include "art/Framework/Principal/Event.h"
 #include "art/Framework/Services/Registry/ActivityRegistry.h"
 #include "art/Framework/Services/Registry/ServiceDefinitionMacros.h"
+#include "art/Framework/Services/Registry/ServiceHandle.h"
 #include "art/Persistency/Provenance/ScheduleContext.h"
 #include "fhiclcpp/ParameterSet.h"
 #include "larcore/CoreUtils/EnsureOnlyOneSchedule.h"
 #include "larevt/CalibrationDBI/Interface/ChannelStatusService.h"
+#include "larevt/CalibrationDBI/Providers/DBFolder.h"
 #include "larevt/CalibrationDBI/Providers/SIOVChannelStatusProvider.h"
+#include "larevt/CalibrationDBI/Services/IOVManagerService.h"
 
 namespace lariov {
 
@@ -14,6 +17,9 @@ namespace lariov {
      art service implementation of ChannelStatusService.  Implements
      a channel status retrieval service for database scheme in which
      all elements in a database folder share a common interval of validity
+
+     The noisy channels added during an event are kept by the provider for
+     all the schedules, so only one schedule is supported.
   */
   class SIOVChannelStatusService : public ChannelStatusService,
                                    private lar::EnsureOnlyOneSchedule<SIOVChannelStatusService> {
@@ -29,6 +35,7 @@ namespace lariov {
     const ChannelStatusProvider* DoGetProviderPtr() const override { return &fProvider; }
 
     SIOVChannelStatusProvider fProvider;
+    bool fUseIOVManager; // The IOV manager moves the provider.
   };
 } //end namespace lariov
 
@@ -41,7 +48,13 @@ namespace lariov {
   SIOVChannelStatusService::SIOVChannelStatusService(fhicl::ParameterSet const& pset,
                                                      art::ActivityRegistry& reg)
     : fProvider(pset.get<fhicl::ParameterSet>("ChannelStatusProvider"))
+    , fUseIOVManager(pset.get<bool>("UseIOVManager", false))
   {
+    // the comparison thread must be idle before the message logger goes away
+    reg.sPostEndJob.watch(&DBFolder::StopShadowComparisons);
+
+    if (fUseIOVManager)
+      art::ServiceHandle<IOVManagerService>()->Register(fProvider, "SIOVChannelStatusService");
 
     //register callback to update local database cache before each event is processed
     reg.sPreProcessEvent.watch(this, &SIOVChannelStatusService::PreProcessEvent);
@@ -50,6 +63,12 @@ namespace lariov {
   void SIOVChannelStatusService::PreProcessEvent(const art::Event& evt, art::ScheduleContext)
   {
 
+    // Noisy channels are per event, the rest is updated by the IOV manager.
+    if (fUseIOVManager) {
+      fProvider.ResetNoisyChannels();
+      return;
+    }
+
     //First grab an update from the database
     fProvider.UpdateTimeStamp(evt.time().value());
   }
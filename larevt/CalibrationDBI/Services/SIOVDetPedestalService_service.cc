@@ -1,11 +1,14 @@
 #include "art/Framework/Principal/Event.h"
 #include "art/Framework/Services/Registry/ActivityRegistry.h"
 #include "art/Framework/Services/Registry/ServiceDefinitionMacros.h"
+#include "art/Framework/Services/Registry/ServiceHandle.h"
 #include "art/Persistency/Provenance/ScheduleContext.h"
 #include "fhiclcpp/ParameterSet.h"
 #include "larcore/CoreUtils/EnsureOnlyOneSchedule.h"
 #include "larevt/CalibrationDBI/Interface/DetPedestalService.h"
+#include "larevt/CalibrationDBI/Providers/DBFolder.h"
 #include "larevt/CalibrationDBI/Providers/DetPedestalRetrievalAlg.h"
+#include "larevt/CalibrationDBI/Services/IOVManagerService.h"
 
 namespace lariov {
 
@@ -13,7 +16,9 @@ namespace lariov {
      \class SIOVDetPedestalService
      art service implementation of DetPedestalService.  Implements
      a detector pedestal retrieval service for database scheme in which
-     all elements in a database folder share a common interval of validity
+     all elements in a database folder share a common interval of validity.
+     The provider answers with the data of the latest event time stamp, which
+     is shared by all schedules, so only one schedule is supported.
   */
   class SIOVDetPedestalService : public DetPedestalService,
                                  private lar::EnsureOnlyOneSchedule<SIOVDetPedestalService> {
@@ -44,6 +49,15 @@ namespace lariov {
                                                  art::ActivityRegistry& reg)
     : fProvider(pset.get<fhicl::ParameterSet>("DetPedestalRetrievalAlg"))
   {
+    // the comparison thread must be idle before the message logger goes away
+    reg.sPostEndJob.watch(&DBFolder::StopShadowComparisons);
+
+    //the IOV manager moves the provider only when a validity boundary is crossed
+    if (pset.get<bool>("UseIOVManager", false)) {
+      art::ServiceHandle<IOVManagerService>()->Register(fProvider, "SIOVDetPedestalService");
+      return;
+    }
+
     //register callback to update local database cache before each event is processed
     //reg.sPreProcessEvent.watch(&SIOVDetPedestalService::PreProcessEvent, *this);
     reg.sPreProcessEvent.watch(this, &SIOVDetPedestalService::PreProcessEvent);
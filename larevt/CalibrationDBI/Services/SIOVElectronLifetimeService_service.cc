@@ -0,0 +1,63 @@
+#include "art/Framework/Principal/Event.h"
+#include "art/Framework/Services/Registry/ActivityRegistry.h"
+#include "art/Framework/Services/Registry/ServiceDefinitionMacros.h"
+#include "art/Framework/Services/Registry/ServiceHandle.h"
+#include "art/Persistency/Provenance/ScheduleContext.h"
+#include "fhiclcpp/ParameterSet.h"
+#include "larevt/CalibrationDBI/Interface/ElectronLifetimeService.h"
+#include "larevt/CalibrationDBI/Providers/DBFolder.h"
+#include "larevt/CalibrationDBI/Providers/SIOVElectronLifetimeProvider.h"
+#include "larevt/CalibrationDBI/Services/IOVManagerService.h"
+
+namespace lariov {
+
+  /**
+     \class SIOVElectronLifetimeService
+     art service implementation of ElectronLifetimeService.  Implements
+     an electron lifetime retrieval service for database scheme in which
+     all elements in a database folder share a common interval of validity
+  */
+  class SIOVElectronLifetimeService : public ElectronLifetimeService {
+
+  public:
+    SIOVElectronLifetimeService(fhicl::ParameterSet const& pset, art::ActivityRegistry& reg);
+
+    void PreProcessEvent(const art::Event& evt, art::ScheduleContext)
+    {
+      fProvider.UpdateTimeStamp(evt.time().value());
+    }
+
+  private:
+    ElectronLifetimeProvider const& DoGetProvider() const override { return fProvider; }
+
+    SIOVElectronLifetimeProvider fProvider;
+  };
+} //end namespace lariov
+
+DECLARE_ART_SERVICE_INTERFACE_IMPL(lariov::SIOVElectronLifetimeService,
+                                   lariov::ElectronLifetimeService,
+                                   LEGACY)
+
+namespace lariov {
+
+  SIOVElectronLifetimeService::SIOVElectronLifetimeService(fhicl::ParameterSet const& pset,
+                                                           art::ActivityRegistry& reg)
+    : fProvider(pset.get<fhicl::ParameterSet>("ElectronLifetimeProvider"))
+  {
+    // the comparison thread must be idle before the message logger goes away
+    reg.sPostEndJob.watch(&DBFolder::StopShadowComparisons);
+
+    //the IOV manager moves the provider only when a validity boundary is crossed
+    if (pset.get<bool>("UseIOVManager", false)) {
+      art::ServiceHandle<IOVManagerService>()->Register(fProvider, "SIOVElectronLifetimeService");
+      return;
+    }
+
+    //register callback to update local database cache before each event is processed
+    reg.sPreProcessEvent.watch(this, &SIOVElectronLifetimeService::PreProcessEvent);
+  }
+
+} //end namespace lariov
+
+DEFINE_ART_SERVICE_INTERFACE_IMPL(lariov::SIOVElectronLifetimeService,
+                                  lariov::ElectronLifetimeService)
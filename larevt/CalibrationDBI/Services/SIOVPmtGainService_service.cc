@@ -1,10 +1,13 @@
 #include "art/Framework/Principal/Event.h"
 #include "art/Framework/Services/Registry/ActivityRegistry.h"
 #include "art/Framework/Services/Registry/ServiceDefinitionMacros.h"
+#include "art/Framework/Services/Registry/ServiceHandle.h"
 #include "art/Persistency/Provenance/ScheduleContext.h"
 #include "fhiclcpp/ParameterSet.h"
 #include "larevt/CalibrationDBI/Interface/PmtGainService.h"
+#include "larevt/CalibrationDBI/Providers/DBFolder.h"
 #include "larevt/CalibrationDBI/Providers/SIOVPmtGainProvider.h"
+#include "larevt/CalibrationDBI/Services/IOVManagerService.h"
 
 namespace lariov {
 
@@ -42,6 +45,15 @@ namespace lariov {
                                          art::ActivityRegistry& reg)
     : fProvider(pset.get<fhicl::ParameterSet>("PmtGainProvider"))
   {
+    // the comparison thread must be idle before the message logger goes away
+    reg.sPostEndJob.watch(&DBFolder::StopShadowComparisons);
+
+    //the IOV manager moves the provider only when a validity boundary is crossed
+    if (pset.get<bool>("UseIOVManager", false)) {
+      art::ServiceHandle<IOVManagerService>()->Register(fProvider, "SIOVPmtGainService");
+      return;
+    }
+
     //register callback to update local database cache before each event is processed
     reg.sPreProcessEvent.watch(this, &SIOVPmtGainService::PreProcessEvent);
   }
@@ -0,0 +1,312 @@
+/**
+ * \file generate_conditions_db.cc
+ *
+ * \ingroup WebDBI
+ *
+ * \brief Writes a synthetic conditions folder into a SQLite file
+ *
+ * Usage:
+ *
+ *     generate_conditions_db -f <folder> [-o <file>] [-n <channels>] [-m <IOVs>]
+ *                            [-k <tags>] [-c <name>:<type>[:<min>:<max>] ...]
+ *                            [-x <fraction>[,<fraction>...]] [--begin <time>]
+ *                            [--step <seconds>] [--seed <seed>] [--index]
+ *
+ * The file has the `<folder>_iovs`, `<folder>_tag_iovs` and `<folder>_data`
+ * tables DBFolder reads with `UseSQLite` (see DBFolder::GetSQLiteData()), and
+ * is named `<folder>.db` unless `-o` is given, so that DBFolder finds it in
+ * FW_SEARCH_PATH.
+ *
+ * Each of the tags `v1` to `v<tags>` has its own <IOVs> intervals of
+ * validity, starting every <seconds> from <time> (seconds since the epoch).
+ * The first interval holds a row for each channel; each later one holds new
+ * values only for a fraction of the channels, chosen at random, the others
+ * keeping the values of the previous interval.  The i-th fraction of `-x`
+ * applies to the i-th interval after the first, the last one to all the
+ * remaining intervals.
+ *
+ * After the channel column, the data have the columns given with `-c`
+ * (by default `mean:real` and `rms:real`): `integer` columns hold values
+ * from <min> to <max> (default 0 to 1000), `real` columns values from <min>
+ * to <max> (default 0 to 1) and `text` columns short strings.  The values
+ * depend only on the options, so that a file can be generated again
+ * identically.  `--index` adds the indexes a production database may have
+ * on the interval and channel columns.
+ */
+
+#include <sqlite3.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+  struct Column {
+    std::string name;
+    std::string type; // "integer", "real" or "text"
+    double min;
+    double max;
+  };
+
+  void Usage(std::ostream& out)
+  {
+    out << "Usage: generate_conditions_db -f <folder> [-o <file>] [-n <channels>] [-m <IOVs>]\n"
+        << "                              [-k <tags>] [-c <name>:<type>[:<min>:<max>] ...]\n"
+        << "                              [-x <fraction>[,<fraction>...]] [--begin <time>]\n"
+        << "                              [--step <seconds>] [--seed <seed>] [--index]\n"
+        << "Column types are integer, real and text; tags are named v1 to v<tags>.\n";
+  }
+
+  Column ParseColumn(const std::string& spec)
+  {
+    std::vector<std::string> fields;
+    std::istringstream in(spec);
+    std::string field;
+    while (std::getline(in, field, ':'))
+      fields.push_back(field);
+    if (fields.size() != 2 && fields.size() != 4)
+      throw std::runtime_error("bad column " + spec);
+
+    Column column{fields[0], fields[1], 0., fields[1] == "integer" ? 1000. : 1.};
+    if (column.name.empty() || column.name[0] == '_' || column.name == "channel")
+      throw std::runtime_error("bad column name in " + spec);
+    if (column.type != "integer" && column.type != "real" && column.type != "text")
+      throw std::runtime_error("bad column type in " + spec);
+    if (fields.size() == 4) {
+      if (column.type == "text") throw std::runtime_error("text column with a range: " + spec);
+      column.min = std::stod(fields[2]);
+      column.max = std::stod(fields[3]);
+      if (column.min > column.max) throw std::runtime_error("empty range in " + spec);
+    }
+    return column;
+  }
+
+  std::vector<double> ParseFractions(const std::string& spec)
+  {
+    std::vector<double> fractions;
+    std::istringstream in(spec);
+    std::string field;
+    while (std::getline(in, field, ',')) {
+      double const fraction = std::stod(field);
+      if (fraction < 0. || fraction > 1.)
+        throw std::runtime_error("change fraction out of [0,1]: " + field);
+      fractions.push_back(fraction);
+    }
+    if (fractions.empty()) throw std::runtime_error("no change fraction in " + spec);
+    return fractions;
+  }
+
+  /// Uniform value in [0, 1), the same on every platform (unlike std distributions)
+  double Uniform(std::mt19937_64& engine) { return (engine() >> 11) * 0x1.0p-53; }
+
+  class Database {
+  public:
+    explicit Database(const std::string& path)
+    {
+      std::remove(path.c_str());
+      if (sqlite3_open(path.c_str(), &fDB) != SQLITE_OK) {
+        std::string const message = sqlite3_errmsg(fDB);
+        sqlite3_close(fDB);
+        throw std::runtime_error("cannot create " + path + ": " + message);
+      }
+    }
+    ~Database()
+    {
+      for (auto stmt : fStatements)
+        sqlite3_finalize(stmt);
+      sqlite3_close(fDB);
+    }
+    Database(const Database&) = delete;
+    Database& operator=(const Database&) = delete;
+
+    void Execute(const std::string& sql)
+    {
+      char* error = nullptr;
+      if (sqlite3_exec(fDB, sql.c_str(), nullptr, nullptr, &error) != SQLITE_OK) {
+        std::string const message = error ? error : "unknown error";
+        sqlite3_free(error);
+        throw std::runtime_error("SQLite error: " + message + " in: " + sql);
+      }
+    }
+
+    sqlite3_stmt* Prepare(const std::string& sql)
+    {
+      sqlite3_stmt* stmt = nullptr;
+      if (sqlite3_prepare_v2(fDB, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK)
+        throw std::runtime_error("SQLite error: " + std::string(sqlite3_errmsg(fDB)) +
+                                 " in: " + sql);
+      fStatements.push_back(stmt);
+      return stmt;
+    }
+
+    void Step(sqlite3_stmt* stmt)
+    {
+      if (sqlite3_step(stmt) != SQLITE_DONE)
+        throw std::runtime_error("SQLite error: " + std::string(sqlite3_errmsg(fDB)));
+      sqlite3_reset(stmt);
+    }
+
+  private:
+    sqlite3* fDB = nullptr;
+    std::vector<sqlite3_stmt*> fStatements;
+  };
+
+} // anonymous namespace
+
+int main(int argc, char** argv)
+{
+  std::string folder;
+  std::string output;
+  std::size_t nchannels = 15360;
+  std::size_t niovs = 10;
+  std::size_t ntags = 1;
+  std::vector<Column> columns;
+  std::vector<double> fractions{0.1};
+  long begin = 1600000000;
+  long step = 3600;
+  std::uint64_t seed = 1;
+  bool index = false;
+
+  try {
+    for (int i = 1; i < argc; ++i) {
+      std::string const arg = argv[i];
+      bool const hasValue = i + 1 < argc;
+      if (arg == "-h" || arg == "--help") {
+        Usage(std::cout);
+        return 0;
+      }
+      else if (arg == "--index")
+        index = true;
+      else if (arg == "-f" && hasValue)
+        folder = argv[++i];
+      else if (arg == "-o" && hasValue)
+        output = argv[++i];
+      else if (arg == "-n" && hasValue)
+        nchannels = std::stoul(argv[++i]);
+      else if (arg == "-m" && hasValue)
+        niovs = std::stoul(argv[++i]);
+      else if (arg == "-k" && hasValue)
+        ntags = std::stoul(argv[++i]);
+      else if (arg == "-c" && hasValue)
+        columns.push_back(ParseColumn(argv[++i]));
+      else if (arg == "-x" && hasValue)
+        fractions = ParseFractions(argv[++i]);
+      else if (arg == "--begin" && hasValue)
+        begin = std::stol(argv[++i]);
+      else if (arg == "--step" && hasValue)
+        step = std::stol(argv[++i]);
+      else if (arg == "--seed" && hasValue)
+        seed = std::stoull(argv[++i]);
+      else
+        throw std::runtime_error("unexpected argument " + arg);
+    }
+    if (folder.empty() || nchannels == 0 || niovs == 0 || ntags == 0 || step <= 0) {
+      Usage(std::cerr);
+      return 1;
+    }
+    if (output.empty()) output = folder + ".db";
+    if (columns.empty()) columns = {ParseColumn("mean:real"), ParseColumn("rms:real")};
+
+    auto const start = std::chrono::steady_clock::now();
+    Database db(output);
+    db.Execute("PRAGMA journal_mode=OFF; PRAGMA synchronous=OFF;");
+
+    std::string const table_iovs = folder + "_iovs";
+    std::string const table_tag_iovs = folder + "_tag_iovs";
+    std::string const table_data = folder + "_data";
+    std::ostringstream sql;
+    sql << "CREATE TABLE " << table_iovs << "(iov_id integer, begin_time integer);"
+        << "CREATE TABLE " << table_tag_iovs << "(tag text, iov_id integer);"
+        << "CREATE TABLE " << table_data << "(__iov_id integer, channel integer";
+    for (auto const& column : columns)
+      sql << ", " << column.name << " " << column.type;
+    sql << ");";
+    db.Execute(sql.str());
+
+    sqlite3_stmt* const insert_iov = db.Prepare("INSERT INTO " + table_iovs + " VALUES(?,?)");
+    sqlite3_stmt* const insert_tag = db.Prepare("INSERT INTO " + table_tag_iovs + " VALUES(?,?)");
+    std::string values = "?,?";
+    for (std::size_t col = 0; col < columns.size(); ++col)
+      values += ",?";
+    sqlite3_stmt* const insert_data =
+      db.Prepare("INSERT INTO " + table_data + " VALUES(" + values + ")");
+
+    db.Execute("BEGIN");
+    std::size_t nrows = 0;
+    std::vector<std::uint32_t> order(nchannels);
+    for (std::size_t tag = 0; tag < ntags; ++tag) {
+      std::string const tagname = "v" + std::to_string(tag + 1);
+      std::mt19937_64 engine(seed * 1000003 + tag);
+      for (std::size_t ch = 0; ch < nchannels; ++ch)
+        order[ch] = ch;
+
+      for (std::size_t iov = 0; iov < niovs; ++iov) {
+        long const iov_id = tag * niovs + iov + 1;
+        sqlite3_bind_int64(insert_iov, 1, iov_id);
+        sqlite3_bind_int64(insert_iov, 2, begin + long(iov) * step);
+        db.Step(insert_iov);
+        sqlite3_bind_text(insert_tag, 1, tagname.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_int64(insert_tag, 2, iov_id);
+        db.Step(insert_tag);
+
+        // Channels with new values: all of them, then a random subset.
+        std::size_t nchanged = nchannels;
+        if (iov > 0) {
+          double const fraction = fractions[std::min(iov - 1, fractions.size() - 1)];
+          nchanged = std::size_t(fraction * nchannels + 0.5);
+          for (std::size_t i = 0; i < nchanged; ++i)
+            std::swap(order[i], order[i + engine() % (nchannels - i)]);
+        }
+        std::vector<std::uint32_t> changed(order.begin(), order.begin() + nchanged);
+        std::sort(changed.begin(), changed.end());
+
+        sqlite3_bind_int64(insert_data, 1, iov_id);
+        for (auto const ch : changed) {
+          sqlite3_bind_int64(insert_data, 2, ch);
+          for (std::size_t col = 0; col < columns.size(); ++col) {
+            auto const& column = columns[col];
+            int const param = int(col) + 3;
+            double const u = Uniform(engine);
+            if (column.type == "integer")
+              sqlite3_bind_int64(
+                insert_data, param, long(column.min) + long(u * (column.max - column.min + 1)));
+            else if (column.type == "real")
+              sqlite3_bind_double(insert_data, param, column.min + u * (column.max - column.min));
+            else {
+              std::string const text = "t" + std::to_string(engine() % 1000000);
+              sqlite3_bind_text(insert_data, param, text.c_str(), -1, SQLITE_TRANSIENT);
+            }
+          }
+          db.Step(insert_data);
+        }
+        nrows += nchanged;
+      }
+    }
+    db.Execute("COMMIT");
+
+    if (index) {
+      db.Execute("CREATE INDEX " + table_iovs + "_begin ON " + table_iovs + "(begin_time);" +
+                 "CREATE INDEX " + table_tag_iovs + "_tag ON " + table_tag_iovs + "(tag);" +
+                 "CREATE INDEX " + table_data + "_iov ON " + table_data + "(__iov_id, channel);");
+    }
+
+    std::chrono::duration<double> const elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "Wrote folder " << folder << " to " << output << ": " << ntags << " tags, "
+              << ntags * niovs << " intervals of validity, " << nrows << " data rows in "
+              << elapsed.count() << " s\n";
+  }
+  catch (std::exception const& e) {
+    std::cerr << "generate_conditions_db: " << e.what() << "\n";
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,164 @@
+/**
+ * \file prestage_conditions.cc
+ *
+ * \ingroup WebDBI
+ *
+ * \brief Writes the conditions data needed by a list of runs into a bundle
+ *
+ * Usage:
+ *
+ *     prestage_conditions -o <bundle> -f <folder>[:<tag>] [-f ...]
+ *                         (-r <run list> | -t <begin>:<end> [-t ...])
+ *                         [-u <url>] [--sqlite]
+ *
+ * Each line of the run list holds the start and end times of a run, in
+ * seconds since the epoch, optionally preceded by the run number; lines
+ * starting with '#' are ignored.  Every interval of validity of each folder
+ * overlapping a run is fetched once, from the web server at the given url,
+ * or from the <folder>.db SQLite files in FW_SEARCH_PATH with `--sqlite`.
+ * Jobs read the bundle by setting `BundleFile` in the DatabaseRetrievalAlg
+ * configuration of their providers (see DBBundle).
+ */
+
+#include "larevt/CalibrationDBI/IOVData/TimeStampDecoder.h"
+#include "larevt/CalibrationDBI/Providers/DBBundle.h"
+#include "larevt/CalibrationDBI/Providers/DBFolder.h"
+
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+  using TimeRange_t = std::pair<lariov::DBTimeStamp_t, lariov::DBTimeStamp_t>;
+
+  constexpr lariov::DBTimeStamp_t kNS_PER_SECOND = 1000000000;
+
+  void Usage(std::ostream& out)
+  {
+    out << "Usage: prestage_conditions -o <bundle> -f <folder>[:<tag>] [-f ...]\n"
+        << "                           (-r <run list> | -t <begin>:<end> [-t ...])\n"
+        << "                           [-u <url>] [--sqlite]\n"
+        << "Times are in seconds since the epoch; run list lines are\n"
+        << "\"[<run>] <begin> <end>\".\n";
+  }
+
+  TimeRange_t MakeRange(unsigned long begin, unsigned long end)
+  {
+    if (begin > end) throw std::runtime_error("time range ending before it begins");
+    return {begin * kNS_PER_SECOND, end * kNS_PER_SECOND};
+  }
+
+  std::vector<TimeRange_t> ReadRunList(const std::string& path)
+  {
+    std::ifstream in(path);
+    if (!in) throw std::runtime_error("cannot read run list " + path);
+    std::vector<TimeRange_t> ranges;
+    std::string line;
+    while (std::getline(in, line)) {
+      if (line.empty() || line[0] == '#') continue;
+      std::istringstream fields(line);
+      std::vector<unsigned long> values;
+      unsigned long value;
+      while (fields >> value)
+        values.push_back(value);
+      if (!fields.eof() || values.size() < 2 || values.size() > 3)
+        throw std::runtime_error("bad line in run list " + path + ": " + line);
+      ranges.push_back(MakeRange(values[values.size() - 2], values.back()));
+    }
+    return ranges;
+  }
+
+  TimeRange_t ParseRange(const std::string& arg)
+  {
+    auto const colon = arg.find(':');
+    if (colon == std::string::npos) throw std::runtime_error("bad time range " + arg);
+    return MakeRange(std::stoul(arg.substr(0, colon)), std::stoul(arg.substr(colon + 1)));
+  }
+
+  // Adds all the intervals of the folder overlapping the time range.
+  void Prestage(lariov::DBFolder& folder,
+                const TimeRange_t& range,
+                lariov::DBBundle::Writer& writer)
+  {
+    lariov::DBTimeStamp_t t = range.first;
+    while (t <= range.second) {
+      folder.UpdateData(t);
+      writer.Add(folder.FolderName(), folder.Tag(), folder.CachedData());
+      lariov::DBTimeStamp_t const next =
+        lariov::TimeStampDecoder::FirstTimeStampFrom(folder.CachedEnd());
+      if (next <= t) break; // The interval extends to the end of time.
+      t = next;
+    }
+  }
+
+} // anonymous namespace
+
+int main(int argc, char** argv)
+{
+  std::string output;
+  std::string url;
+  bool usesqlite = false;
+  std::vector<std::pair<std::string, std::string>> folders;
+  std::vector<TimeRange_t> ranges;
+
+  try {
+    for (int i = 1; i < argc; ++i) {
+      std::string const arg = argv[i];
+      bool const hasValue = i + 1 < argc;
+      if (arg == "-h" || arg == "--help") {
+        Usage(std::cout);
+        return 0;
+      }
+      else if (arg == "--sqlite")
+        usesqlite = true;
+      else if (arg == "-o" && hasValue)
+        output = argv[++i];
+      else if (arg == "-u" && hasValue)
+        url = argv[++i];
+      else if (arg == "-f" && hasValue) {
+        std::string const spec = argv[++i];
+        auto const colon = spec.find(':');
+        if (colon == std::string::npos)
+          folders.emplace_back(spec, "");
+        else
+          folders.emplace_back(spec.substr(0, colon), spec.substr(colon + 1));
+      }
+      else if (arg == "-r" && hasValue) {
+        auto const runs = ReadRunList(argv[++i]);
+        ranges.insert(ranges.end(), runs.begin(), runs.end());
+      }
+      else if (arg == "-t" && hasValue)
+        ranges.push_back(ParseRange(argv[++i]));
+      else
+        throw std::runtime_error("unexpected argument " + arg);
+    }
+    if (output.empty() || folders.empty() || ranges.empty() || (url.empty() && !usesqlite)) {
+      Usage(std::cerr);
+      return 1;
+    }
+
+    lariov::DBBundle::Writer writer;
+    for (auto const& [name, tag] : folders) {
+      lariov::DBFolder folder(name, url, "", tag, usesqlite);
+      std::size_t const before = writer.NEntries();
+      for (auto const& range : ranges)
+        Prestage(folder, range, writer);
+      std::cout << "Folder " << name << (tag.empty() ? "" : " tag " + tag) << ": "
+                << writer.NEntries() - before << " intervals of validity\n";
+    }
+    writer.Write(output);
+    std::cout << "Wrote " << writer.NEntries() << " intervals, " << writer.NPayloads()
+              << " distinct payloads, to " << output << "\n";
+  }
+  catch (std::exception const& e) {
+    std::cerr << "prestage_conditions: " << e.what() << "\n";
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,384 @@
+/**
+ * \file replay_conditions_trace.cc
+ *
+ * \ingroup WebDBI
+ *
+ * \brief Replays the conditions calls recorded by a job
+ *
+ * Usage:
+ *
+ *     replay_conditions_trace -t <trace> (-u <url> | --sqlite | -b <bundle>)
+ *                             [-g <folder>:<tag> ...] [-n <passes>] [--metrics]
+ *
+ * The trace is recorded by ConditionsMetricsService with `TraceFileName` set
+ * (see ConditionsTrace).  Each provider and DBFolder of the trace is created
+ * again reading the database at the given url, the <folder>.db SQLite files
+ * in FW_SEARCH_PATH, or a bundle written by prestage_conditions, with the tag
+ * recorded unless changed with `-g`, and the calls are made again in the
+ * same order, with the same time stamps and arguments.  Neither art nor the
+ * geometry service is needed: the channel status lists are read from the
+ * snapshots, without the selection of the channels known to the geometry
+ * and the channels flagged noisy by the job.
+ *
+ * Each of the <passes> (default 1) starts from new providers, with empty
+ * caches.  The report gives the time of each pass and, for each source, the
+ * number of calls, the number that threw, and a checksum of the values
+ * returned, which is the same for any backend holding the same data.
+ */
+
+#include "larevt/CalibrationDBI/IOVData/ChannelStatus.h"
+#include "larevt/CalibrationDBI/Providers/ConditionsMetrics.h"
+#include "larevt/CalibrationDBI/Providers/ConditionsTrace.h"
+#include "larevt/CalibrationDBI/Providers/DBFolder.h"
+#include "larevt/CalibrationDBI/Providers/DetPedestalRetrievalAlg.h"
+#include "larevt/CalibrationDBI/Providers/SIOVChannelStatusProvider.h"
+#include "larevt/CalibrationDBI/Providers/SIOVElectronLifetimeProvider.h"
+#include "larevt/CalibrationDBI/Providers/SIOVElectronicsCalibProvider.h"
+#include "larevt/CalibrationDBI/Providers/SIOVPmtGainProvider.h"
+
+#include "fhiclcpp/ParameterSet.h"
+
+#include <array>
+#include <bitset>
+#include <chrono>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+  using lariov::ConditionsTrace;
+  using Call_t = ConditionsTrace::Reader::Call;
+  using Source_t = ConditionsTrace::Reader::Source;
+
+  struct Backend {
+    std::string url;
+    bool usesqlite = false;
+    std::string bundle;
+    std::map<std::string, std::string> tags; // Replacing the recorded ones, by folder.
+  };
+
+  void Usage(std::ostream& out)
+  {
+    out << "Usage: replay_conditions_trace -t <trace> (-u <url> | --sqlite | -b <bundle>)\n"
+        << "                               [-g <folder>:<tag> ...] [-n <passes>] [--metrics]\n";
+  }
+
+  /// A provider or folder of the trace, with what its calls returned
+  struct Target {
+    ConditionsTrace::Source_t type;
+    std::string folder;
+    std::string tag;
+
+    std::unique_ptr<lariov::DBFolder> dbFolder;
+    std::unique_ptr<lariov::DetPedestalRetrievalAlg> pedestals;
+    std::unique_ptr<lariov::SIOVChannelStatusProvider> channelStatus;
+    std::unique_ptr<lariov::SIOVElectronLifetimeProvider> lifetime;
+    std::unique_ptr<lariov::SIOVElectronicsCalibProvider> electronics;
+    std::unique_ptr<lariov::SIOVPmtGainProvider> pmtGain;
+    bool folderLoaded = false; // The latest UpdateData() did not throw.
+
+    std::uint64_t calls = 0;
+    std::uint64_t errors = 0;
+    std::string firstError;
+    double checksum = 0.;
+  };
+
+  std::unique_ptr<Target> MakeTarget(Source_t const& source, Backend const& backend)
+  {
+    auto target = std::make_unique<Target>();
+    target->type = source.type;
+    target->folder = source.folder;
+    auto const tag = backend.tags.find(source.folder);
+    target->tag = tag == backend.tags.end() ? source.tag : tag->second;
+
+    if (source.type == ConditionsTrace::kFolder) {
+      target->dbFolder = std::make_unique<lariov::DBFolder>(target->folder,
+                                                            backend.url,
+                                                            "",
+                                                            target->tag,
+                                                            backend.usesqlite,
+                                                            false,
+                                                            0.,
+                                                            false,
+                                                            backend.bundle);
+      return target;
+    }
+
+    fhicl::ParameterSet alg;
+    alg.put("DBFolderName", target->folder);
+    alg.put("DBUrl", backend.url);
+    alg.put("DBTag", target->tag);
+    alg.put("UseSQLite", backend.usesqlite);
+    alg.put("BundleFile", backend.bundle);
+    fhicl::ParameterSet pset;
+    pset.put("DatabaseRetrievalAlg", alg);
+    pset.put("UseDB", true);
+
+    switch (source.type) {
+    case ConditionsTrace::kDetPedestal:
+      target->pedestals = std::make_unique<lariov::DetPedestalRetrievalAlg>(pset);
+      break;
+    case ConditionsTrace::kChannelStatus:
+      target->channelStatus = std::make_unique<lariov::SIOVChannelStatusProvider>(pset);
+      break;
+    case ConditionsTrace::kElectronLifetime:
+      target->lifetime = std::make_unique<lariov::SIOVElectronLifetimeProvider>(pset);
+      break;
+    case ConditionsTrace::kElectronicsCalib:
+      target->electronics = std::make_unique<lariov::SIOVElectronicsCalibProvider>(pset);
+      break;
+    case ConditionsTrace::kPmtGain:
+      target->pmtGain = std::make_unique<lariov::SIOVPmtGainProvider>(pset);
+      break;
+    default: throw std::runtime_error("unknown source type in the trace");
+    }
+    return target;
+  }
+
+  double NamedData(lariov::DBFolder& folder, Call_t const& call)
+  {
+    auto const& data = folder.CachedData();
+    int const col = data.getColNumber(call.column);
+    std::string const type = col < 0 ? "real" : data.colTypes()[col];
+    if (type == "real") {
+      double value = 0.;
+      folder.GetNamedChannelData(call.value, call.column, value);
+      return value;
+    }
+    if (type == "text") {
+      std::string value;
+      folder.GetNamedChannelData(call.value, call.column, value);
+      return value.size();
+    }
+    long value = 0;
+    folder.GetNamedChannelData(call.value, call.column, value);
+    return value;
+  }
+
+  double StatusList(lariov::SIOVChannelStatusProvider& provider, Call_t const& call)
+  {
+    auto const data = provider.SnapshotFor(call.time);
+    switch (call.accessor) {
+    case ConditionsTrace::kGoodChannels: return data->ChannelsWithStatus(lariov::kGOOD).size();
+    case ConditionsTrace::kBadChannels: return data->BadChannels().size();
+    case ConditionsTrace::kNoisyChannels: return data->ChannelsWithStatus(lariov::kNOISY).size();
+    default:
+      if (call.value > lariov::kUNKNOWN) return 0.;
+      return data->ChannelsWithStatus(lariov::chStatus(call.value)).size();
+    }
+  }
+
+  double StatusBatch(lariov::SIOVChannelStatusProvider& provider, Call_t const& call)
+  {
+    std::vector<lariov::ChannelStatusProvider::ResultWord_t> words(
+      lariov::ChannelStatusProvider::ResultWords(call.values.size()));
+    switch (call.accessor) {
+    case ConditionsTrace::kArePresent:
+      provider.ArePresent(call.values.data(), call.values.size(), words.data());
+      break;
+    case ConditionsTrace::kAreBad:
+      provider.AreBad(call.values.data(), call.values.size(), words.data());
+      break;
+    case ConditionsTrace::kAreNoisy:
+      provider.AreNoisy(call.values.data(), call.values.size(), words.data());
+      break;
+    default: provider.AreGood(call.values.data(), call.values.size(), words.data());
+    }
+    double count = 0.;
+    for (auto const word : words)
+      count += std::bitset<64>(word).count();
+    return count;
+  }
+
+  double Attenuation(lariov::SIOVElectronLifetimeProvider& provider, Call_t const& call)
+  {
+    std::vector<float> times(call.values.size());
+    for (std::size_t i = 0; i < times.size(); ++i)
+      times[i] = ConditionsTrace::BitsFloat(call.values[i]);
+    std::vector<float> attenuation(times.size());
+    provider.Attenuation(times.data(), times.size(), attenuation.data());
+    double sum = 0.;
+    for (float const a : attenuation)
+      sum += a;
+    return sum;
+  }
+
+  /// Makes the call again; returns a value for the checksum
+  double Replay(Target& target, Call_t const& call)
+  {
+    float const t = ConditionsTrace::BitsFloat(call.value);
+    switch (call.accessor) {
+    case ConditionsTrace::kUpdateData: {
+      target.folderLoaded = false;
+      bool const updated = target.dbFolder->UpdateData(call.time);
+      target.folderLoaded = true;
+      return updated;
+    }
+    case ConditionsTrace::kNamedData:
+      // DBFolder does not check that data were read.
+      if (!target.folderLoaded) throw std::runtime_error("no data read for the folder");
+      return NamedData(*target.dbFolder, call);
+    case ConditionsTrace::kSelectTime: {
+      lariov::DatabaseRetrievalAlg* provider = nullptr;
+      if (target.pedestals) provider = target.pedestals.get();
+      if (target.channelStatus) provider = target.channelStatus.get();
+      if (target.lifetime) provider = target.lifetime.get();
+      if (target.electronics) provider = target.electronics.get();
+      if (target.pmtGain) provider = target.pmtGain.get();
+      if (!provider) break;
+      return provider->SelectTimeStamp(call.time).first.Stamp();
+    }
+    case ConditionsTrace::kPedMean: return target.pedestals->PedMean(call.value);
+    case ConditionsTrace::kPedRms: return target.pedestals->PedRms(call.value);
+    case ConditionsTrace::kPedMeanErr: return target.pedestals->PedMeanErr(call.value);
+    case ConditionsTrace::kPedRmsErr: return target.pedestals->PedRmsErr(call.value);
+    case ConditionsTrace::kIsPresent: return target.channelStatus->IsPresent(call.value);
+    case ConditionsTrace::kIsBad: return target.channelStatus->IsBad(call.value);
+    case ConditionsTrace::kIsNoisy: return target.channelStatus->IsNoisy(call.value);
+    case ConditionsTrace::kIsGood: return target.channelStatus->IsGood(call.value);
+    case ConditionsTrace::kStatus: return target.channelStatus->Status(call.value);
+    case ConditionsTrace::kGoodChannels:
+    case ConditionsTrace::kBadChannels:
+    case ConditionsTrace::kNoisyChannels:
+    case ConditionsTrace::kChannelsWithStatus: return StatusList(*target.channelStatus, call);
+    case ConditionsTrace::kArePresent:
+    case ConditionsTrace::kAreBad:
+    case ConditionsTrace::kAreNoisy:
+    case ConditionsTrace::kAreGood: return StatusBatch(*target.channelStatus, call);
+    case ConditionsTrace::kLifetime: return target.lifetime->Lifetime(t);
+    case ConditionsTrace::kPurity: return target.lifetime->Purity();
+    case ConditionsTrace::kLifetimeErr: return target.lifetime->LifetimeErr(t);
+    case ConditionsTrace::kPurityErr: return target.lifetime->PurityErr();
+    case ConditionsTrace::kAttenuation: return target.lifetime->Attenuation(t);
+    case ConditionsTrace::kAttenuationBatch: return Attenuation(*target.lifetime, call);
+    case ConditionsTrace::kElectronicsGain: return target.electronics->Gain(call.value);
+    case ConditionsTrace::kElectronicsGainErr: return target.electronics->GainErr(call.value);
+    case ConditionsTrace::kShapingTime: return target.electronics->ShapingTime(call.value);
+    case ConditionsTrace::kShapingTimeErr: return target.electronics->ShapingTimeErr(call.value);
+    case ConditionsTrace::kElectronicsExtraInfo:
+      target.electronics->ExtraInfo(call.value);
+      return 0.;
+    case ConditionsTrace::kPmtGainValue: return target.pmtGain->Gain(call.value);
+    case ConditionsTrace::kPmtGainErr: return target.pmtGain->GainErr(call.value);
+    case ConditionsTrace::kPmtExtraInfo: target.pmtGain->ExtraInfo(call.value); return 0.;
+    default: break;
+    }
+    throw std::runtime_error(std::string(ConditionsTrace::AccessorName(call.accessor)) +
+                             " called on " + ConditionsTrace::SourceName(target.type));
+  }
+
+} // anonymous namespace
+
+int main(int argc, char** argv)
+{
+  std::string tracePath;
+  Backend backend;
+  unsigned int passes = 1;
+  bool metrics = false;
+
+  try {
+    for (int i = 1; i < argc; ++i) {
+      std::string const arg = argv[i];
+      bool const hasValue = i + 1 < argc;
+      if (arg == "-h" || arg == "--help") {
+        Usage(std::cout);
+        return 0;
+      }
+      else if (arg == "--sqlite")
+        backend.usesqlite = true;
+      else if (arg == "--metrics")
+        metrics = true;
+      else if (arg == "-t" && hasValue)
+        tracePath = argv[++i];
+      else if (arg == "-u" && hasValue)
+        backend.url = argv[++i];
+      else if (arg == "-b" && hasValue)
+        backend.bundle = argv[++i];
+      else if (arg == "-n" && hasValue)
+        passes = std::stoul(argv[++i]);
+      else if (arg == "-g" && hasValue) {
+        std::string const spec = argv[++i];
+        auto const colon = spec.find(':');
+        if (colon == std::string::npos) throw std::runtime_error("bad folder tag " + spec);
+        backend.tags[spec.substr(0, colon)] = spec.substr(colon + 1);
+      }
+      else
+        throw std::runtime_error("unexpected argument " + arg);
+    }
+    if (tracePath.empty() || passes == 0 ||
+        (backend.url.empty() && !backend.usesqlite && backend.bundle.empty())) {
+      Usage(std::cerr);
+      return 1;
+    }
+
+    // The whole trace is read first, so that reading it is not timed.
+    ConditionsTrace::Reader reader(tracePath);
+    std::vector<Call_t> calls;
+    Call_t call;
+    while (reader.Next(call))
+      calls.push_back(call);
+    std::vector<Source_t> const sources = reader.Sources();
+    std::cout << "Read " << calls.size() << " calls to " << sources.size() << " sources from "
+              << tracePath << "\n";
+
+    if (metrics) lariov::ConditionsMetrics::Enable();
+
+    std::vector<std::unique_ptr<Target>> targets;
+    std::vector<double> passTimes;
+    for (unsigned int pass = 0; pass < passes; ++pass) {
+      // Providers are created when first called, as in a job, and their
+      // creation is timed with the calls.
+      targets.clear();
+      targets.resize(sources.size());
+      auto const start = std::chrono::steady_clock::now();
+      for (auto const& c : calls) {
+        auto& target = targets[c.source];
+        if (!target) target = MakeTarget(sources[c.source], backend);
+        ++target->calls;
+        try {
+          target->checksum += Replay(*target, c);
+        }
+        catch (std::exception const& e) {
+          if (target->errors++ == 0) target->firstError = e.what();
+        }
+      }
+      std::chrono::duration<double> const elapsed = std::chrono::steady_clock::now() - start;
+      passTimes.push_back(elapsed.count());
+    }
+
+    std::cout << "\n# pass    seconds    ns/call\n";
+    for (std::size_t pass = 0; pass < passTimes.size(); ++pass) {
+      std::cout << std::setw(6) << pass + 1 << std::fixed << std::setprecision(3)
+                << std::setw(11) << passTimes[pass] << std::setprecision(1) << std::setw(11)
+                << (calls.empty() ? 0. : passTimes[pass] * 1e9 / calls.size()) << "\n";
+    }
+
+    std::cout << "\n# source                                          calls     errors"
+                 "               checksum\n";
+    for (auto const& target : targets) {
+      if (!target) continue;
+      std::string const name = std::string(ConditionsTrace::SourceName(target->type)) + " " +
+                               target->folder + (target->tag.empty() ? "" : ":" + target->tag);
+      std::cout << std::left << std::setw(44) << name << std::right << std::setw(11)
+                << target->calls << std::setw(11) << target->errors << std::setw(23)
+                << std::defaultfloat << std::setprecision(15) << target->checksum << "\n";
+      if (target->errors) std::cout << "    first error: " << target->firstError << "\n";
+    }
+
+    if (metrics) {
+      std::cout << "\n";
+      lariov::ConditionsMetrics::Instance().WriteSummary(std::cout);
+    }
+  }
+  catch (std::exception const& e) {
+    std::cerr << "replay_conditions_trace: " << e.what() << "\n";
+    return 1;
+  }
+  return 0;
+}
@@ -9,6 +9,7 @@
 ////////////////////////////////////////////////////////////////////////
 
 #include <algorithm>
+#include <vector>
 
 //Framework Includes
 #include "art/Framework/Core/EDFilter.h"
@@ -57,10 +58,20 @@ namespace filter {
     lariov::ChannelStatusProvider const& channelFilter =
       art::ServiceHandle<lariov::ChannelStatusService const>()->GetProvider();
 
+    // query the status of all the channels at once
+    std::vector<raw::ChannelID_t> channels;
+    channels.reserve(rawdigitView.size());
+    for (const raw::RawDigit* digit : rawdigitView)
+      channels.push_back(digit->Channel());
+    std::vector<lariov::ChannelStatusProvider::ResultWord_t> good(
+      lariov::ChannelStatusProvider::ResultWords(channels.size()));
+    channelFilter.AreGood(channels.data(), channels.size(), good.data());
+
     // look through the good channels
     //      for(const raw::RawDigit* digit: filter::SelectGoodChannels(rawdigitView))
+    std::size_t iDigit = 0;
     for (const raw::RawDigit* digit : rawdigitView) {
-      if (!channelFilter.IsGood(digit->Channel())) continue;
+      if (!lariov::ChannelStatusProvider::ResultBit(good.data(), iDigit++)) continue;
       //get ADC values after decompressing
       std::vector<short> rawadc(digit->Samples());
       raw::Uncompress(digit->ADCs(), rawadc, digit->Compression());
@@ -13,13 +13,32 @@
 #include "larcoreobj/SimpleTypesAndConstants/RawTypes.h" // raw::isValidChannelID()
 
 // Framework libraries
-#include "cetlib/container_algorithms.h"
 #include "cetlib_except/exception.h"
 #include "fhiclcpp/ParameterSet.h"
 
 // C/C++ standard libraries
-#include <iterator> // std::inserter()
-#include <utility>  // std::pair<>
+#include <algorithm> // std::sort(), std::set_union()
+#include <iterator>  // std::back_inserter()
+#include <utility>   // std::move()
+
+namespace {
+
+  /// Returns the channels sorted, without duplicates
+  std::vector<raw::ChannelID_t> SortedChannels(std::vector<raw::ChannelID_t> channels)
+  {
+    std::sort(channels.begin(), channels.end());
+    channels.erase(std::unique(channels.begin(), channels.end()), channels.end());
+    return channels;
+  }
+
+  /// Returns the mask of the sorted channels, up to the largest one
+  lariov::ChannelBitMask MakeMask(std::vector<raw::ChannelID_t> const& channels)
+  {
+    return lariov::ChannelBitMask::FromChannels(
+      channels.begin(), channels.end(), channels.empty() ? 0 : std::size_t(channels.back()) + 1);
+  }
+
+} // local namespace
 
 namespace lariov {
 
@@ -29,13 +48,15 @@ namespace lariov {
   {
     using chan_vect_t = std::vector<raw::ChannelID_t>;
 
-    // Read the bad channels as a vector, then convert it into a set
-    auto BadChannels = pset.get<chan_vect_t>("BadChannels", {});
-    cet::copy_all(BadChannels, std::inserter(fBadChannels, fBadChannels.begin()));
+    // Read the bad channels as a vector, then sort it
+    fBadChannelList = std::make_shared<ChannelList_t const>(
+      SortedChannels(pset.get<chan_vect_t>("BadChannels", {})));
+    fBadMask = MakeMask(*fBadChannelList);
 
-    // Read the noise channels as a vector, then convert it into a set
-    auto NoisyChannels = pset.get<chan_vect_t>("NoisyChannels", {});
-    cet::copy_all(NoisyChannels, std::inserter(fNoisyChannels, fNoisyChannels.begin()));
+    // Read the noise channels as a vector, then sort it
+    fNoisyChannelList = std::make_shared<ChannelList_t const>(
+      SortedChannels(pset.get<chan_vect_t>("NoisyChannels", {})));
+    fNoisyMask = MakeMask(*fNoisyChannelList);
 
   } // SimpleChannelStatus::SimpleChannelStatus()
 
@@ -46,8 +67,9 @@ namespace lariov {
     fMaxChannel = MaxChannel;
     fMaxPresentChannel = MaxGoodChannel;
 
-    // clear the caches, if any
-    fGoodChannels.reset();
+    // refill the good channel ranges and clear the caches, if any
+    FillGoodRanges();
+    std::atomic_store(&fGoodChannels, std::shared_ptr<ChannelList_t const>());
 
   } // SimpleChannelStatus::Setup()
 
@@ -63,76 +85,103 @@ namespace lariov {
   SimpleChannelStatus::ChannelSet_t SimpleChannelStatus::GoodChannels() const
   {
 
-    if (!fGoodChannels) FillGoodChannels();
-    return *fGoodChannels;
+    auto const ranges = GoodChannelRanges();
+    return ChannelSet_t(ranges.begin(), ranges.end());
 
   } // SimpleChannelStatus::GoodChannels()
 
   //----------------------------------------------------------------------------
-  void SimpleChannelStatus::FillGoodChannels() const
+  SimpleChannelStatus::ChannelSpan_t SimpleChannelStatus::GoodChannelSpan() const
   {
 
-    if (!fGoodChannels) fGoodChannels.reset(new ChannelSet_t);
-
-    ChannelSet_t& GoodChannels = *fGoodChannels;
-    GoodChannels.clear();
+    auto channels = std::atomic_load(&fGoodChannels);
+    if (!channels) {
+      auto const ranges = GoodChannelRanges();
+      auto list = std::make_shared<ChannelList_t>();
+      list->reserve(ranges.size());
+      list->assign(ranges.begin(), ranges.end());
+      channels = std::move(list);
+      std::atomic_store(&fGoodChannels, channels);
+    }
+    return MakeSpan(channels);
 
-    std::vector<std::pair<ChannelSet_t::const_iterator, ChannelSet_t::const_iterator>> VetoedIDs;
+  } // SimpleChannelStatus::GoodChannelSpan()
 
-    VetoedIDs.emplace_back(fBadChannels.cbegin(), fBadChannels.cend());
-    VetoedIDs.emplace_back(fNoisyChannels.cbegin(), fNoisyChannels.cend());
-
-    // go for the first (lowest) channel ID...
-    raw::ChannelID_t channel = 0;
-    while (!raw::isValidChannelID(channel))
-      ++channel;
-
-    // ... to the last present one
-    raw::ChannelID_t last_channel = fMaxChannel;
-    if (raw::isValidChannelID(fMaxPresentChannel) && (fMaxPresentChannel < last_channel))
-      last_channel = fMaxPresentChannel;
+  //----------------------------------------------------------------------------
+  SimpleChannelStatus::ChannelRanges_t SimpleChannelStatus::GoodChannelRanges() const
+  {
 
     // if we don't know how many channels
-    if (!raw::isValidChannelID(last_channel)) {
+    if (!raw::isValidChannelID(LastPresentChannel())) {
       // this exception means that the Setup() function was not called
       // or it was called with an invalid value
       throw cet::exception("SimpleChannelStatus")
         << "Can't fill good channel list since no largest channel was set up\n";
     } // if
 
-    // add the channels to the set one by one
-    while (channel <= last_channel) {
-      bool bGood = true;
+    return fGoodRanges;
 
-      // check if this channel is in any of the vetoed lists
-      for (auto iter : VetoedIDs) {
+  } // SimpleChannelStatus::GoodChannelRanges()
 
-        // check all the remaining vetoed channels in this list
-        while (iter.first != iter.second) {
-          // if the first vetoed channel is larger than the tested channel,
-          // we are done with this list
-          if (*(iter.first) > channel) break;
+  //----------------------------------------------------------------------------
+  SimpleChannelStatus::ChannelMask_t SimpleChannelStatus::GoodChannelMask() const
+  {
 
-          if (*(iter.first) == channel) { // vetoed!
-            bGood = false;
-            ++(iter.first); // we have found this already
-            break;
-          }
+    auto const ranges = GoodChannelRanges();
+    std::size_t const size = ranges.nRanges() ? ranges.endRanges()[-1].last : 0;
+    std::vector<ChannelMask_t::word_t> words(ChannelMask_t::NWords(size), 0);
+    for (auto range = ranges.beginRanges(); range != ranges.endRanges(); ++range) {
+      for (std::size_t ch = range->first; ch != range->last; ++ch)
+        words[ch / ChannelMask_t::kWordBits] |= ChannelMask_t::word_t(1)
+                                                << (ch % ChannelMask_t::kWordBits);
+    }
+    return ChannelMask_t::Adopt(std::move(words), size);
 
-          // the last vetoed channel is smaller than the tested channel;
-          // maybe the next vetoed channel will be it!
-          ++(iter.first);
-        } // while
+  } // SimpleChannelStatus::GoodChannelMask()
 
-        if (!bGood) break; // already known bad, we are done
-      }                    // for
+  //----------------------------------------------------------------------------
+  raw::ChannelID_t SimpleChannelStatus::LastPresentChannel() const
+  {
+
+    raw::ChannelID_t last_channel = fMaxChannel;
+    if (raw::isValidChannelID(fMaxPresentChannel) && (fMaxPresentChannel < last_channel))
+      last_channel = fMaxPresentChannel;
+    return last_channel;
 
-      // add the channel
-      if (bGood) GoodChannels.insert(channel);
-      ++channel;
-    } // while
+  } // SimpleChannelStatus::LastPresentChannel()
 
-  } // SimpleChannelStatus::GoodChannels()
+  //----------------------------------------------------------------------------
+  void SimpleChannelStatus::FillGoodRanges()
+  {
+
+    fGoodRanges = ChannelRanges_t();
+
+    // go for the first (lowest) channel ID to the last present one
+    raw::ChannelID_t const last_channel = LastPresentChannel();
+    if (!raw::isValidChannelID(last_channel)) return; // GoodChannelRanges() will complain
+
+    // the good channels are the gaps between the vetoed ones
+    ChannelList_t VetoedIDs;
+    VetoedIDs.reserve(fBadChannelList->size() + fNoisyChannelList->size());
+    std::set_union(fBadChannelList->begin(),
+                   fBadChannelList->end(),
+                   fNoisyChannelList->begin(),
+                   fNoisyChannelList->end(),
+                   std::back_inserter(VetoedIDs));
+
+    std::vector<ChannelRanges_t::Range> GoodRanges;
+    GoodRanges.reserve(VetoedIDs.size() + 1);
+    raw::ChannelID_t channel = 0;
+    for (raw::ChannelID_t vetoed : VetoedIDs) {
+      if (vetoed > last_channel) break;
+      if (vetoed > channel) GoodRanges.push_back({channel, vetoed});
+      channel = vetoed + 1;
+    } // for
+    if (channel <= last_channel) GoodRanges.push_back({channel, last_channel + 1});
+
+    fGoodRanges = ChannelRanges_t::Adopt(std::move(GoodRanges));
+
+  } // SimpleChannelStatus::FillGoodRanges()
 
   //----------------------------------------------------------------------------
 
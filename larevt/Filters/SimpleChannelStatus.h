@@ -19,7 +19,8 @@ namespace fhicl {
 }
 
 // C/C++ standard library
-#include <memory> // std::unique_ptr<>
+#include <memory> // std::shared_ptr<>
+#include <vector>
 
 namespace lariov {
 
@@ -33,6 +34,11 @@ namespace lariov {
    * one included) are considered present. If no valid ID is specified, all
    * channels are supposed present.
    *
+   * Bad and noisy channels are kept as bit masks, so that single channel
+   * queries take constant time. Good channels are kept as ranges, computed by
+   * Setup() in a time proportional to the number of bad and noisy channels;
+   * the sorted list of all good channels is filled only on request.
+   *
    * LArSoft interface to this class is through the service
    * SimpleChannelStatusService.
    *
@@ -68,15 +74,12 @@ namespace lariov {
     }
 
     /// Returns whether the specified channel is bad in the current run
-    virtual bool IsBad(raw::ChannelID_t channel) const override
-    {
-      return fBadChannels.count(channel) > 0;
-    }
+    virtual bool IsBad(raw::ChannelID_t channel) const override { return fBadMask.test(channel); }
 
     /// Returns whether the specified channel is noisy in the current run
     virtual bool IsNoisy(raw::ChannelID_t channel) const override
     {
-      return fNoisyChannels.count(channel) > 0;
+      return fNoisyMask.test(channel);
     }
     /// @}
 
@@ -86,10 +89,66 @@ namespace lariov {
     virtual ChannelSet_t GoodChannels() const override;
 
     /// Returns a copy of set of bad channel IDs for the current run
-    virtual ChannelSet_t BadChannels() const override { return fBadChannels; }
+    virtual ChannelSet_t BadChannels() const override { return ToSet(BadChannelSpan()); }
 
     /// Returns a copy of set of noisy channel IDs for the current run
-    virtual ChannelSet_t NoisyChannels() const override { return fNoisyChannels; }
+    virtual ChannelSet_t NoisyChannels() const override { return ToSet(NoisyChannelSpan()); }
+    /// @}
+
+    /// @name Bulk channel queries
+    /// @{
+    /// Returns the sorted list of good channel IDs for the current run
+    virtual ChannelSpan_t GoodChannelSpan() const override;
+
+    /// Returns the sorted list of bad channel IDs for the current run
+    virtual ChannelSpan_t BadChannelSpan() const override { return MakeSpan(fBadChannelList); }
+
+    /// Returns the sorted list of noisy channel IDs for the current run
+    virtual ChannelSpan_t NoisyChannelSpan() const override
+    {
+      return MakeSpan(fNoisyChannelList);
+    }
+
+    /// Returns the good channel IDs for the current run, as ranges
+    virtual ChannelRanges_t GoodChannelRanges() const override;
+
+    /// Returns the mask of good channels for the current run
+    virtual ChannelMask_t GoodChannelMask() const override;
+
+    /// Returns the mask of bad channels for the current run
+    virtual ChannelMask_t BadChannelMask() const override { return fBadMask; }
+
+    /// Returns the mask of noisy channels for the current run
+    virtual ChannelMask_t NoisyChannelMask() const override { return fNoisyMask; }
+    /// @}
+
+    /// @name Batch channel queries
+    /// @{
+    /// Sets the bits of the channels bad in the current run
+    virtual void AreBad(raw::ChannelID_t const* channels,
+                        std::size_t n,
+                        ResultWord_t* result) const override
+    {
+      FillResult(channels, n, result, [this](raw::ChannelID_t ch) { return fBadMask.test(ch); });
+    }
+
+    /// Sets the bits of the channels noisy in the current run
+    virtual void AreNoisy(raw::ChannelID_t const* channels,
+                          std::size_t n,
+                          ResultWord_t* result) const override
+    {
+      FillResult(channels, n, result, [this](raw::ChannelID_t ch) { return fNoisyMask.test(ch); });
+    }
+
+    /// Sets the bits of the channels physical and good
+    virtual void AreGood(raw::ChannelID_t const* channels,
+                         std::size_t n,
+                         ResultWord_t* result) const override
+    {
+      FillResult(channels, n, result, [this](raw::ChannelID_t ch) {
+        return SimpleChannelStatus::IsPresent(ch) && !fBadMask.test(ch) && !fNoisyMask.test(ch);
+      });
+    }
     /// @}
 
     //
@@ -134,17 +193,36 @@ namespace lariov {
     ///@}
 
   protected:
-    ChannelSet_t fBadChannels;   ///< set of bad channels
-    ChannelSet_t fNoisyChannels; ///< set of noisy channels
+    /// Type of sorted list of channels
+    using ChannelList_t = std::vector<raw::ChannelID_t>;
+
+    /// sorted lists of bad and noisy channels, shared by the views
+    std::shared_ptr<ChannelList_t const> fBadChannelList;
+    std::shared_ptr<ChannelList_t const> fNoisyChannelList;
+
+    ChannelMask_t fBadMask;   ///< bad channels, up to the largest one
+    ChannelMask_t fNoisyMask; ///< noisy channels, up to the largest one
 
     raw::ChannelID_t fMaxChannel;        ///< largest ID among existing channels
     raw::ChannelID_t fMaxPresentChannel; ///< largest ID among present channels
 
-    /// cached set of good channels (lazy evaluation)
-    mutable std::unique_ptr<ChannelSet_t> fGoodChannels;
+    /// good channels, as ranges (filled by Setup())
+    ChannelRanges_t fGoodRanges;
+
+    /// cached sorted list of good channels (lazy evaluation)
+    mutable std::shared_ptr<ChannelList_t const> fGoodChannels;
 
-    /// Fills the collection of good channels
-    void FillGoodChannels() const;
+    /// Fills the ranges of good channels
+    void FillGoodRanges();
+
+    /// Returns the largest ID among present channels, invalid if unknown
+    raw::ChannelID_t LastPresentChannel() const;
+
+    /// Returns a view of the list, which it keeps alive
+    static ChannelSpan_t MakeSpan(std::shared_ptr<ChannelList_t const> const& channels)
+    {
+      return ChannelSpan_t(channels->data(), channels->data() + channels->size(), channels);
+    }
 
   }; // class SimpleChannelStatus
 
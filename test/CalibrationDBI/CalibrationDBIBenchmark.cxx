@@ -0,0 +1,445 @@
+/**
+ * @file   CalibrationDBIBenchmark.cxx
+ * @brief  Benchmark of the calibration database access hot paths
+ *
+ * Usage:
+ *
+ *     CalibrationDBIBenchmark [--channels N] [--iovs M] [--repeat R] [--no-times]
+ *
+ * All the data are synthetic and generated with a fixed seed: N channels per
+ * interval of validity (default 15360), M intervals (default 4).  Each
+ * benchmark is run R times (default 5) and the fastest run is reported.
+ *
+ * The report has one line per benchmark, in a fixed order: the number of
+ * items processed, the time per item and a checksum of the results.  The
+ * checksums depend only on N and M, so that two reports can be compared
+ * with diff; `--no-times` leaves the times out, for an exact comparison.
+ *
+ * The repetitions of a benchmark must all give the same checksum; the
+ * program reports the ones which do not and exits with status 2, so that
+ * it also runs as a test.
+ */
+
+// LArSoft libraries
+#include "larevt/CalibrationDBI/IOVData/ChannelStatus.h"
+#include "larevt/CalibrationDBI/IOVData/ChannelStatusSnapshot.h"
+#include "larevt/CalibrationDBI/IOVData/DetPedestal.h"
+#include "larevt/CalibrationDBI/IOVData/Snapshot.h"
+#include "larevt/CalibrationDBI/IOVData/SnapshotBuilder.h"
+#include "larevt/CalibrationDBI/Providers/DBBundle.h"
+#include "larevt/CalibrationDBI/Providers/DBDataset.h"
+#include "larevt/CalibrationDBI/Providers/DBDatasetParser.h"
+#include "larevt/CalibrationDBI/Providers/DBFolder.h"
+#include "larevt/CalibrationDBI/Providers/DetPedestalRetrievalAlg.h"
+#include "larevt/CalibrationDBI/Providers/SIOVChannelStatusProvider.h"
+
+// framework libraries
+#include "fhiclcpp/ParameterSet.h"
+
+// C/C++ standard library
+#include <algorithm>
+#include <bitset>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+namespace {
+
+  using lariov::DBChannelID_t;
+  using lariov::DBDataset;
+  using lariov::DBTimeStamp_t;
+  using lariov::IOVTimeStamp;
+
+  struct Config {
+    std::size_t channels = 15360;
+    std::size_t iovs = 4;
+    int repeat = 5;
+    bool times = true;
+  };
+
+  // Start of the first interval of validity, and length of each, in seconds.
+  constexpr unsigned long kFIRST_IOV = 1600000000;
+  constexpr unsigned long kIOV_LENGTH = 1000;
+
+  /// Event time stamp in the middle of the interval iov
+  DBTimeStamp_t EventTime(std::size_t iov)
+  {
+    return (kFIRST_IOV + iov * kIOV_LENGTH + kIOV_LENGTH / 2) * DBTimeStamp_t(1000000000);
+  }
+
+  IOVTimeStamp IOVBegin(std::size_t iov) { return IOVTimeStamp(kFIRST_IOV + iov * kIOV_LENGTH); }
+
+  IOVTimeStamp IOVEnd(std::size_t iov, std::size_t niovs)
+  {
+    return iov + 1 == niovs ? IOVTimeStamp::MaxTimeStamp() : IOVBegin(iov + 1);
+  }
+
+  /// Uniform value in [0, 1), the same on every platform (unlike std distributions)
+  double Uniform(std::mt19937_64& engine) { return (engine() >> 11) * 0x1.0p-53; }
+
+  //--------------------------------------------------------------------------
+  // Synthetic folders: pedestals (four real columns) and channel status.
+
+  DBDataset MakePedestals(std::size_t nchannels, std::size_t iov, std::size_t niovs)
+  {
+    std::mt19937_64 engine(1000 + iov);
+    std::vector<DBChannelID_t> channels(nchannels);
+    std::vector<DBDataset::value_type> values;
+    values.reserve(nchannels * 5);
+    for (std::size_t ch = 0; ch < nchannels; ++ch) {
+      channels[ch] = ch;
+      values.emplace_back(long(ch));
+      values.emplace_back(400. + 100. * Uniform(engine));
+      values.emplace_back(0.01 * Uniform(engine));
+      values.emplace_back(2. + Uniform(engine));
+      values.emplace_back(0.01 * Uniform(engine));
+    }
+    return DBDataset(IOVBegin(iov),
+                     IOVEnd(iov, niovs),
+                     {"channel", "mean", "mean_err", "rms", "rms_err"},
+                     {"integer", "real", "real", "real", "real"},
+                     std::move(channels),
+                     std::move(values));
+  }
+
+  DBDataset MakeStatuses(std::size_t nchannels, std::size_t iov, std::size_t niovs)
+  {
+    std::mt19937_64 engine(2000 + iov);
+    std::vector<DBChannelID_t> channels(nchannels);
+    std::vector<DBDataset::value_type> values;
+    values.reserve(nchannels * 2);
+    for (std::size_t ch = 0; ch < nchannels; ++ch) {
+      // Mostly good channels, a few of each other status.
+      double const u = Uniform(engine);
+      long const status = u < 0.9 ? long(lariov::kGOOD) : long(u * 100) % 4;
+      channels[ch] = ch;
+      values.emplace_back(long(ch));
+      values.emplace_back(status);
+    }
+    return DBDataset(IOVBegin(iov),
+                     IOVEnd(iov, niovs),
+                     {"channel", "status"},
+                     {"integer", "integer"},
+                     std::move(channels),
+                     std::move(values));
+  }
+
+  /// The pedestals as a conditions web server would send them
+  std::string PedestalText(const DBDataset& data)
+  {
+    std::ostringstream text;
+    text << std::setprecision(17) << data.beginTime().DBStamp() << "\n-\n"
+         << "channel,mean,mean_err,rms,rms_err\ninteger,real,real,real,real\n";
+    for (std::size_t row = 0; row < data.nrows(); ++row) {
+      auto const r = data.getRow(row);
+      text << r.getLongData(0);
+      for (std::size_t col = 1; col < data.ncols(); ++col)
+        text << ',' << r.getDoubleData(col);
+      text << '\n';
+    }
+    return text.str();
+  }
+
+  /// Channels in a fixed pseudo-random order
+  std::vector<DBChannelID_t> ShuffledChannels(std::size_t nchannels)
+  {
+    std::vector<DBChannelID_t> channels(nchannels);
+    std::iota(channels.begin(), channels.end(), DBChannelID_t(0));
+    std::mt19937_64 engine(3000);
+    for (std::size_t i = nchannels; i > 1; --i)
+      std::swap(channels[i - 1], channels[engine() % i]);
+    return channels;
+  }
+
+  fhicl::ParameterSet ProviderConfig(const std::string& folder, const std::string& bundle)
+  {
+    fhicl::ParameterSet alg;
+    alg.put("DBFolderName", folder);
+    alg.put("DBUrl", std::string());
+    alg.put("DBTag", std::string("v1"));
+    alg.put("BundleFile", bundle);
+    fhicl::ParameterSet pset;
+    pset.put("DatabaseRetrievalAlg", alg);
+    pset.put("UseDB", true);
+    return pset;
+  }
+
+  /// Removes the file at the end of the scope
+  struct TemporaryFile {
+    std::string path;
+    explicit TemporaryFile(const std::filesystem::path& p) : path(p.string()) {}
+    ~TemporaryFile() { std::filesystem::remove(path); }
+  };
+
+  //--------------------------------------------------------------------------
+  // Timing and report.
+
+  struct Result {
+    std::string name;
+    std::size_t items;
+    double nsPerItem;
+    double checksum;
+  };
+
+  class Benchmark {
+  public:
+    explicit Benchmark(const Config& config) : fConfig(config) {}
+
+    /// Runs body, which returns a checksum, and keeps the fastest run
+    void Run(const std::string& name, std::size_t items, const std::function<double()>& body)
+    {
+      double best = std::numeric_limits<double>::max();
+      double checksum = 0.;
+      bool consistent = true;
+      for (int i = 0; i < fConfig.repeat; ++i) {
+        auto const start = std::chrono::steady_clock::now();
+        double const sum = body();
+        std::chrono::duration<double, std::nano> const elapsed =
+          std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count());
+        if (i > 0 && !(sum == checksum)) consistent = false;
+        checksum = sum;
+      }
+      fResults.push_back({name, items, best / std::max<std::size_t>(items, 1), checksum});
+      if (!consistent) fInconsistent.push_back(name);
+    }
+
+    /// Benchmarks whose repetitions gave different checksums
+    const std::vector<std::string>& Inconsistent() const { return fInconsistent; }
+
+    void Report(std::ostream& out) const
+    {
+      out << "# CalibrationDBI benchmark: channels=" << fConfig.channels
+          << " iovs=" << fConfig.iovs << " repeat=" << fConfig.repeat << "\n";
+      out << std::left << std::setw(48) << "# benchmark" << std::right << std::setw(10)
+          << "items";
+      if (fConfig.times) out << std::setw(12) << "ns/item";
+      out << std::setw(22) << "checksum" << "\n";
+      for (auto const& r : fResults) {
+        out << std::left << std::setw(48) << r.name << std::right << std::setw(10) << r.items;
+        if (fConfig.times)
+          out << std::setw(12) << std::fixed << std::setprecision(2) << r.nsPerItem;
+        out << std::setw(22) << std::defaultfloat << std::setprecision(15) << r.checksum << "\n";
+      }
+    }
+
+  private:
+    const Config& fConfig;
+    std::vector<Result> fResults;
+    std::vector<std::string> fInconsistent;
+  };
+
+  Config ParseArguments(int argc, char** argv)
+  {
+    Config config;
+    for (int i = 1; i < argc; ++i) {
+      std::string const arg = argv[i];
+      bool const hasValue = i + 1 < argc;
+      if (arg == "--channels" && hasValue)
+        config.channels = std::stoul(argv[++i]);
+      else if (arg == "--iovs" && hasValue)
+        config.iovs = std::stoul(argv[++i]);
+      else if (arg == "--repeat" && hasValue)
+        config.repeat = std::stoi(argv[++i]);
+      else if (arg == "--no-times")
+        config.times = false;
+      else {
+        std::cerr << "Usage: " << argv[0]
+                  << " [--channels N] [--iovs M] [--repeat R] [--no-times]\n";
+        std::exit(1);
+      }
+    }
+    if (config.channels == 0 || config.iovs == 0 || config.repeat < 1) {
+      std::cerr << "Channels, IOVs and repetitions must be positive.\n";
+      std::exit(1);
+    }
+    return config;
+  }
+
+} // anonymous namespace
+
+int main(int argc, char** argv)
+{
+  Config const config = ParseArguments(argc, argv);
+  std::size_t const nch = config.channels;
+  std::size_t const niovs = config.iovs;
+  std::vector<DBChannelID_t> const shuffled = ShuffledChannels(nch);
+  Benchmark bench(config);
+
+  // The providers report on their progress on standard output: keep that out
+  // of the way of the report, which is printed at the end.
+  std::ostringstream chatter;
+  std::streambuf* const out = std::cout.rdbuf(chatter.rdbuf());
+
+  // DBDataset construction, from values and from a server response.
+  bench.Run("DBDataset construction", nch, [&] {
+    return double(MakePedestals(nch, 0, niovs).nrows());
+  });
+
+  std::string const text = PedestalText(MakePedestals(nch, 0, niovs));
+  bench.Run("DBDatasetParser::Feed (64 kB chunks)", nch, [&] {
+    lariov::DBDatasetParser parser;
+    for (std::size_t i = 0; i < text.size(); i += 65536)
+      parser.Feed(text.data() + i, std::min<std::size_t>(65536, text.size() - i));
+    auto const data = parser.Finish();
+    return data.getRow(data.nrows() - 1).getDoubleData(1);
+  });
+
+  // Row look-up.
+  DBDataset const pedestals = MakePedestals(nch, 0, niovs);
+  bench.Run("DBDataset::getRowNumber (random order)", nch, [&] {
+    double sum = 0.;
+    for (auto const ch : shuffled)
+      sum += pedestals.getRowNumber(ch);
+    return sum;
+  });
+
+  // The folders below read their data from a bundle holding all the intervals.
+  TemporaryFile const bundleFile(
+    std::filesystem::temp_directory_path() /
+    ("CalibrationDBIBenchmark_" + std::to_string(getpid()) + ".bundle"));
+  std::string const& bundle = bundleFile.path;
+  {
+    lariov::DBBundle::Writer writer;
+    for (std::size_t iov = 0; iov < niovs; ++iov) {
+      writer.Add("pedestals", "v1", MakePedestals(nch, iov, niovs));
+      writer.Add("channelstatus", "v1", MakeStatuses(nch, iov, niovs));
+    }
+    writer.Write(bundle);
+  }
+
+  {
+    lariov::DBFolder folder("pedestals", "", "", "v1", false, false, 0., false, bundle);
+    folder.UpdateData(EventTime(0));
+    bench.Run("DBFolder::GetNamedChannelData (in order)", nch, [&] {
+      double sum = 0., value = 0.;
+      for (DBChannelID_t ch = 0; ch < nch; ++ch) {
+        folder.GetNamedChannelData(ch, "mean", value);
+        sum += value;
+      }
+      return sum;
+    });
+    bench.Run("DBFolder::GetNamedChannelData (random order)", nch, [&] {
+      double sum = 0., value = 0.;
+      for (auto const ch : shuffled) {
+        folder.GetNamedChannelData(ch, "mean", value);
+        sum += value;
+      }
+      return sum;
+    });
+    bench.Run("DBFolder::UpdateData (IOV switches)", niovs, [&] {
+      double sum = 0.;
+      for (std::size_t iov = 0; iov < niovs; ++iov) {
+        folder.UpdateData(EventTime((iov + 1) % niovs));
+        sum += folder.CachedStart().Stamp() - kFIRST_IOV;
+      }
+      return sum;
+    });
+  }
+
+  // Snapshot rows.
+  std::vector<lariov::DetPedestal> rows;
+  rows.reserve(nch);
+  for (std::size_t row = 0; row < nch; ++row) {
+    lariov::DetPedestal ped(pedestals.channels()[row]);
+    ped.SetPedMean(pedestals.getRow(row).getDoubleData(1));
+    rows.push_back(ped);
+  }
+  lariov::Snapshot<lariov::DetPedestal> snapshot;
+  for (auto const& ped : rows)
+    snapshot.AddOrReplaceRow(ped);
+
+  bench.Run("Snapshot::GetRow (random order)", nch, [&] {
+    double sum = 0.;
+    for (auto const ch : shuffled)
+      sum += snapshot.GetRow(ch).PedMean();
+    return sum;
+  });
+  bench.Run("Snapshot::AddOrReplaceRow (append)", nch, [&] {
+    lariov::Snapshot<lariov::DetPedestal> s;
+    for (auto const& ped : rows)
+      s.AddOrReplaceRow(ped);
+    return double(s.NChannels());
+  });
+  bench.Run("Snapshot::AddOrReplaceRow (replace, random)", nch, [&] {
+    for (auto const ch : shuffled)
+      snapshot.AddOrReplaceRow(rows[ch]);
+    return double(snapshot.NChannels());
+  });
+
+  // Providers, reading the bundle.
+  bench.Run("DetPedestalRetrievalAlg snapshot builds", niovs, [&] {
+    lariov::DetPedestalRetrievalAlg provider(ProviderConfig("pedestals", bundle));
+    double sum = 0.;
+    for (std::size_t iov = 0; iov < niovs; ++iov)
+      sum += provider.SnapshotFor(EventTime(iov))->NChannels();
+    return sum;
+  });
+
+  lariov::DetPedestalRetrievalAlg pedestalProvider(ProviderConfig("pedestals", bundle));
+  pedestalProvider.SelectTimeStamp(EventTime(0));
+  bench.Run("DetPedestalRetrievalAlg::PedMean (random)", nch, [&] {
+    double sum = 0.;
+    for (auto const ch : shuffled)
+      sum += pedestalProvider.PedMean(ch);
+    return sum;
+  });
+
+  lariov::SIOVChannelStatusProvider statusProvider(ProviderConfig("channelstatus", bundle));
+  statusProvider.SelectTimeStamp(EventTime(0));
+  bench.Run("SIOVChannelStatusProvider::IsGood (random)", nch, [&] {
+    double good = 0.;
+    for (auto const ch : shuffled)
+      good += statusProvider.IsGood(ch);
+    return good;
+  });
+
+  std::vector<lariov::ChannelStatusProvider::ResultWord_t> words((nch + 63) / 64);
+  bench.Run("SIOVChannelStatusProvider::AreGood (batch)", nch, [&] {
+    statusProvider.AreGood(shuffled.data(), nch, words.data());
+    double good = 0.;
+    for (auto const w : words)
+      good += std::bitset<64>(w).count();
+    return good;
+  });
+
+  auto const statuses = statusProvider.SnapshotFor(EventTime(0));
+  bench.Run("ChannelStatusSnapshot::BuildIndex", nch, [&] {
+    lariov::ChannelStatusSnapshot copy(*statuses);
+    copy.BuildIndex();
+    return double(copy.ChannelsWithStatus(lariov::kGOOD).size());
+  });
+  bench.Run("ChannelStatusSnapshot::ChannelsWithStatus", nch, [&] {
+    double sum = 0.;
+    for (auto const status : {lariov::kDISCONNECTED,
+                              lariov::kDEAD,
+                              lariov::kLOWNOISE,
+                              lariov::kNOISY,
+                              lariov::kGOOD}) {
+      for (auto const ch : statuses->ChannelsWithStatus(status))
+        sum += ch;
+    }
+    return sum;
+  });
+
+  std::cout.rdbuf(out);
+  bench.Report(std::cout);
+
+  for (auto const& name : bench.Inconsistent())
+    std::cerr << "Checksum differs between the repetitions of " << name << "\n";
+  return bench.Inconsistent().empty() ? 0 : 2;
+}
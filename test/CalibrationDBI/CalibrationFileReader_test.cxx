@@ -0,0 +1,175 @@
+/**
+ * @file   CalibrationFileReader_test.cxx
+ * @brief  Test of the parsing of calibration files by CalibrationFileReader
+ * @date   October 19th, 2026
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE (calibration_file_reader_test)
+#include "boost/test/unit_test.hpp"
+
+// LArSoft libraries
+#include "larevt/CalibrationDBI/Providers/CalibrationFileReader.h"
+
+// framework libraries
+#include "cetlib_except/exception.h"
+
+// C/C++ standard library
+#include <fstream>
+#include <string>
+#include <vector>
+
+using lariov::CalibrationFileReader;
+using lariov::DBChannelID_t;
+
+namespace {
+
+  std::string const kPath = "CalibrationFileReader_test.csv";
+
+  void WriteFile(std::string const& content)
+  {
+    std::ofstream(kPath, std::ios::binary | std::ios::trunc) << content;
+  }
+
+  /// Reads kPath with value columns mean and rms
+  CalibrationFileReader Read(std::string const& content, unsigned int nChunks = 0)
+  {
+    WriteFile(content);
+    return CalibrationFileReader(kPath, {"mean", "rms"}, nChunks);
+  }
+
+  /// Returns the message of the exception thrown by reading content
+  std::string ReadError(std::string const& content, unsigned int nChunks = 0)
+  {
+    try {
+      Read(content, nChunks);
+    }
+    catch (cet::exception const& e) {
+      return e.what();
+    }
+    return "";
+  }
+
+} // local namespace
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(ShortFileTest)
+{
+  BOOST_TEST(Read("").NRows() == 0U);
+  BOOST_TEST(Read("\n\n  # only a comment\n").NRows() == 0U);
+
+  // a single line with no end of line
+  CalibrationFileReader const single = Read("7, 1.5, 0.25");
+  BOOST_TEST_REQUIRE(single.NRows() == 1U);
+  BOOST_TEST(single.NColumns() == 2U);
+  BOOST_TEST(single.Channel(0) == 7U);
+  BOOST_TEST(single.Value(0, 0) == 1.5f);
+  BOOST_TEST(single.Value(0, 1) == 0.25f);
+
+  // blank lines, comments and Windows line ends
+  CalibrationFileReader const file =
+    Read("\n# channel, mean, rms\n3,1,2 # note\r\n\n4,\t5 , 6\r\n");
+  BOOST_TEST_REQUIRE(file.NRows() == 2U);
+  BOOST_TEST(file.Channel(1) == 4U);
+  BOOST_TEST(file.Value(1, 0) == 5.f);
+  BOOST_TEST(file.Value(1, 1) == 6.f);
+} // BOOST_AUTO_TEST_CASE(ShortFileTest)
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(HeaderTest)
+{
+  // columns by name, in any order, with unknown ones ignored
+  CalibrationFileReader const file = Read("rms, extra, channel, mean\n0.5, 99, 12, 400\n");
+  BOOST_TEST_REQUIRE(file.NRows() == 1U);
+  BOOST_TEST(file.Channel(0) == 12U);
+  BOOST_TEST(file.Value(0, 0) == 400.f);
+  BOOST_TEST(file.Value(0, 1) == 0.5f);
+
+  // a header alone
+  BOOST_TEST(Read("channel, mean, rms\n").NRows() == 0U);
+
+  BOOST_TEST(ReadError("channel, mean\n1, 2\n").find("Column 'rms' is missing") !=
+             std::string::npos);
+  BOOST_TEST(ReadError("mean, rms\n1, 2\n").find("Column 'channel' is missing") !=
+             std::string::npos);
+  BOOST_TEST(ReadError("channel, mean, rms, mean\n1, 2, 3, 4\n").find("appears twice") !=
+             std::string::npos);
+} // BOOST_AUTO_TEST_CASE(HeaderTest)
+
+//------------------------------------------------------------------------------
+// Values may carry an explicit sign, but only one.
+BOOST_AUTO_TEST_CASE(SignTest)
+{
+  CalibrationFileReader const file = Read("+5, +1.5, -2\n");
+  BOOST_TEST_REQUIRE(file.NRows() == 1U);
+  BOOST_TEST(file.Channel(0) == 5U);
+  BOOST_TEST(file.Value(0, 0) == 1.5f);
+  BOOST_TEST(file.Value(0, 1) == -2.f);
+
+  BOOST_CHECK_THROW(Read("5, ++1.5, 2\n"), cet::exception);
+  BOOST_CHECK_THROW(Read("5, +-1.5, 2\n"), cet::exception);
+  BOOST_CHECK_THROW(Read("5, +, 2\n"), cet::exception);
+  BOOST_CHECK_THROW(Read("-5, 1.5, 2\n"), cet::exception); // channels are not negative
+} // BOOST_AUTO_TEST_CASE(SignTest)
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(MalformedTest)
+{
+  BOOST_CHECK_THROW(Read("5, 1.5x, 2\n"), cet::exception);
+  BOOST_CHECK_THROW(Read("5, 1.5 2, 2\n"), cet::exception);
+  BOOST_CHECK_THROW(Read("5.5, 1.5, 2\n"), cet::exception);
+  BOOST_CHECK_THROW(Read("5, , 2\n"), cet::exception);
+  BOOST_CHECK_THROW(Read("5, 1.5\n"), cet::exception); // missing column
+  BOOST_CHECK_THROW(Read("1, 2, 3\nfive, 1.5, 2\n"), cet::exception);
+
+  // extra columns of a file with no header are ignored
+  BOOST_TEST(Read("5, 1.5, 2, 3\n").NRows() == 1U);
+
+  BOOST_CHECK_THROW(CalibrationFileReader("CalibrationFileReader_test.none", {"mean"}),
+                    cet::exception);
+} // BOOST_AUTO_TEST_CASE(MalformedTest)
+
+//------------------------------------------------------------------------------
+// Errors name the line and the file, whichever chunk the line is in.
+BOOST_AUTO_TEST_CASE(ErrorReportTest)
+{
+  std::string content;
+  for (int ch = 0; ch != 100; ++ch)
+    content += std::to_string(ch) + ", 1, 2\n";
+  content += "100, 1, oops\n";
+
+  for (unsigned int nChunks : {1U, 4U}) {
+    std::string const message = ReadError(content, nChunks);
+    BOOST_TEST_CONTEXT("chunks: " << nChunks)
+    {
+      BOOST_TEST(message.find("Cannot parse line '100, 1, oops'") != std::string::npos);
+      BOOST_TEST(message.find(kPath) != std::string::npos);
+    }
+  }
+} // BOOST_AUTO_TEST_CASE(ErrorReportTest)
+
+//------------------------------------------------------------------------------
+// The chunks are cut at line boundaries, and the rows come out in file order
+// however many chunks there are, even with more chunks than lines.
+BOOST_AUTO_TEST_CASE(ChunkTest)
+{
+  std::string content = "channel, rms, mean\n";
+  for (int ch = 0; ch != 1000; ++ch) {
+    content += std::to_string(ch) + ", " + std::to_string(ch % 7) + ".25, " + std::to_string(ch);
+    if (ch % 10 == 0) content += " # comment, with a comma";
+    content += (ch % 3) ? "\n" : "\n\n";
+  }
+
+  for (unsigned int nChunks : {1U, 2U, 3U, 7U, 64U, 5000U}) {
+    BOOST_TEST_CONTEXT("chunks: " << nChunks)
+    {
+      CalibrationFileReader const file = Read(content, nChunks);
+      BOOST_TEST_REQUIRE(file.NRows() == 1000U);
+      for (DBChannelID_t ch = 0; ch != 1000; ++ch) {
+        BOOST_TEST(file.Channel(ch) == ch);
+        BOOST_TEST(file.Value(ch, 0) == float(ch));
+        BOOST_TEST(file.Value(ch, 1) == ch % 7 + 0.25f);
+      }
+    }
+  }
+} // BOOST_AUTO_TEST_CASE(ChunkTest)
@@ -0,0 +1,210 @@
+/**
+ * @file   ChannelCalibrationBundleProvider_test.cxx
+ * @brief  Test of the caching of the bundles of ChannelCalibrationBundleProvider
+ * @date   October 19th, 2026
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE (channel_calibration_bundle_provider_test)
+#include "boost/test/unit_test.hpp"
+
+// LArSoft libraries
+#include "larevt/CalibrationDBI/IOVData/ChannelCalibrationBundle.h"
+#include "larevt/CalibrationDBI/IOVData/ChannelStatus.h"
+#include "larevt/CalibrationDBI/IOVData/IOVTimeStamp.h"
+#include "larevt/CalibrationDBI/Providers/ChannelCalibrationBundleProvider.h"
+#include "larevt/CalibrationDBI/Providers/DBBundle.h"
+#include "larevt/CalibrationDBI/Providers/DBDataset.h"
+#include "larevt/CalibrationDBI/Providers/DetPedestalRetrievalAlg.h"
+#include "larevt/CalibrationDBI/Providers/SIOVChannelStatusProvider.h"
+#include "larevt/CalibrationDBI/Providers/SIOVElectronicsCalibProvider.h"
+
+// framework libraries
+#include "fhiclcpp/ParameterSet.h"
+
+// C/C++ standard library
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+using lariov::ChannelCalibrationBundleProvider;
+using lariov::DBChannelID_t;
+using lariov::DBDataset;
+using lariov::DBTimeStamp_t;
+using lariov::IOVTimeStamp;
+
+namespace {
+
+  // The three folders change at different times, in seconds from kSTART:
+  // electronics at 100, pedestals at 200 and channel status at 300.
+  constexpr unsigned long kSTART = 1600000000;
+  constexpr unsigned int kCHANNELS = 3;
+
+  /// Event time stamp t seconds after kSTART
+  DBTimeStamp_t EventTime(unsigned long t)
+  {
+    return (kSTART + t) * DBTimeStamp_t(1000000000);
+  }
+
+  IOVTimeStamp Time(unsigned long t) { return IOVTimeStamp(kSTART + t); }
+
+  /// Dataset with a row per channel, the channel column followed by the values
+  DBDataset MakeDataset(IOVTimeStamp const& begin,
+                        IOVTimeStamp const& end,
+                        std::vector<std::string> names,
+                        std::vector<std::string> types,
+                        std::vector<DBDataset::value_type> (*row)(DBChannelID_t))
+  {
+    std::vector<DBChannelID_t> channels;
+    std::vector<DBDataset::value_type> values;
+    for (DBChannelID_t ch = 0; ch != kCHANNELS; ++ch) {
+      channels.push_back(ch);
+      values.emplace_back(long(ch));
+      for (auto& value : row(ch))
+        values.push_back(std::move(value));
+    }
+    return DBDataset(
+      begin, end, std::move(names), std::move(types), std::move(channels), std::move(values));
+  }
+
+  /// Four real values, the first being Value (pedestal mean or gain)
+  template <int Value>
+  std::vector<DBDataset::value_type> RealRow(DBChannelID_t)
+  {
+    std::vector<DBDataset::value_type> row;
+    row.emplace_back(double(Value));
+    row.emplace_back(0.1);
+    row.emplace_back(2.);
+    row.emplace_back(0.1);
+    return row;
+  }
+
+  template <long Status>
+  std::vector<DBDataset::value_type> StatusRow(DBChannelID_t)
+  {
+    std::vector<DBDataset::value_type> row;
+    row.emplace_back(Status);
+    return row;
+  }
+
+  void WriteBundle(std::string const& path)
+  {
+    std::vector<std::string> const pedestalNames{"channel", "mean", "mean_err", "rms", "rms_err"};
+    std::vector<std::string> const electronicsNames{
+      "channel", "gain", "gain_err", "shaping_time", "shaping_time_err"};
+    std::vector<std::string> const reals{"integer", "real", "real", "real", "real"};
+    std::vector<std::string> const statusNames{"channel", "status"};
+    std::vector<std::string> const integers{"integer", "integer"};
+
+    lariov::DBBundle::Writer writer;
+    writer.Add("pedestals",
+               "v1",
+               MakeDataset(Time(0), Time(200), pedestalNames, reals, RealRow<400>));
+    writer.Add(
+      "pedestals",
+      "v1",
+      MakeDataset(Time(200), IOVTimeStamp::MaxTimeStamp(), pedestalNames, reals, RealRow<500>));
+    writer.Add("electronics",
+               "v1",
+               MakeDataset(Time(0), Time(100), electronicsNames, reals, RealRow<10>));
+    writer.Add("electronics",
+               "v1",
+               MakeDataset(
+                 Time(100), IOVTimeStamp::MaxTimeStamp(), electronicsNames, reals, RealRow<20>));
+    writer.Add("channelstatus",
+               "v1",
+               MakeDataset(Time(0), Time(300), statusNames, integers, StatusRow<lariov::kGOOD>));
+    writer.Add(
+      "channelstatus",
+      "v1",
+      MakeDataset(
+        Time(300), IOVTimeStamp::MaxTimeStamp(), statusNames, integers, StatusRow<lariov::kDEAD>));
+    writer.Write(path);
+  }
+
+  fhicl::ParameterSet ProviderConfig(std::string const& folder, std::string const& bundle)
+  {
+    fhicl::ParameterSet alg;
+    alg.put("DBFolderName", folder);
+    alg.put("DBUrl", std::string());
+    alg.put("DBTag", std::string("v1"));
+    alg.put("BundleFile", bundle);
+    fhicl::ParameterSet pset;
+    pset.put("DatabaseRetrievalAlg", alg);
+    pset.put("UseDB", true);
+    return pset;
+  }
+
+  /// The three providers reading the bundle file, and the bundle provider
+  struct Providers {
+    lariov::DetPedestalRetrievalAlg pedestals;
+    lariov::SIOVElectronicsCalibProvider electronics;
+    lariov::SIOVChannelStatusProvider status;
+    ChannelCalibrationBundleProvider bundles;
+
+    explicit Providers(std::string const& path)
+      : pedestals(ProviderConfig("pedestals", path))
+      , electronics(ProviderConfig("electronics", path))
+      , status(ProviderConfig("channelstatus", path))
+      , bundles(pedestals, electronics, status)
+    {}
+  };
+
+} // local namespace
+
+//------------------------------------------------------------------------------
+// A bundle is built once for each intersection of the intervals of validity of
+// the three folders, and a new one when any of them changes.
+BOOST_AUTO_TEST_CASE(RebuildTest)
+{
+  std::string const path = "ChannelCalibrationBundleProvider_test_rebuild.bundle";
+  WriteBundle(path);
+  Providers providers(path);
+  auto const& provider = providers.bundles;
+
+  auto const first = provider.BundleFor(EventTime(50));
+  BOOST_TEST_REQUIRE(first);
+  BOOST_TEST((first->Start() == Time(0)));
+  BOOST_TEST((first->End() == Time(100)));
+  BOOST_TEST(first->GetRecord(1).pedMean == 400.f);
+  BOOST_TEST(first->GetRecord(1).gain == 10.f);
+  BOOST_TEST(first->GetRecord(1).IsGood());
+  BOOST_TEST(first->GetRecord(1).IsComplete());
+  BOOST_TEST(provider.BundleFor(EventTime(0)) == first);
+  BOOST_TEST(provider.BundleFor(EventTime(99)) == first);
+
+  // electronics change
+  auto const second = provider.BundleFor(EventTime(100));
+  BOOST_TEST(second != first);
+  BOOST_TEST((second->Start() == Time(100)));
+  BOOST_TEST((second->End() == Time(200)));
+  BOOST_TEST(second->GetRecord(1).pedMean == 400.f);
+  BOOST_TEST(second->GetRecord(1).gain == 20.f);
+  BOOST_TEST(provider.BundleFor(EventTime(199)) == second);
+
+  // pedestals change
+  auto const third = provider.BundleFor(EventTime(250));
+  BOOST_TEST(third != second);
+  BOOST_TEST((third->Start() == Time(200)));
+  BOOST_TEST((third->End() == Time(300)));
+  BOOST_TEST(third->GetRecord(1).pedMean == 500.f);
+  BOOST_TEST(third->GetRecord(1).IsGood());
+  BOOST_TEST(provider.BundleFor(EventTime(200)) == third);
+
+  // channel status changes
+  auto const fourth = provider.BundleFor(EventTime(300));
+  BOOST_TEST(fourth != third);
+  BOOST_TEST((fourth->Start() == Time(300)));
+  BOOST_TEST((fourth->End() == IOVTimeStamp::MaxTimeStamp()));
+  BOOST_TEST(fourth->GetRecord(1).status == lariov::kDEAD);
+  BOOST_TEST(provider.BundleFor(EventTime(100000)) == fourth);
+
+  // the bundles of the earlier intervals are still cached
+  BOOST_TEST(provider.BundleFor(EventTime(50)) == first);
+  BOOST_TEST(provider.BundleFor(EventTime(150)) == second);
+  BOOST_TEST(provider.BundleFor(EventTime(299)) == third);
+
+  std::remove(path.c_str());
+} // BOOST_AUTO_TEST_CASE(RebuildTest)
@@ -0,0 +1,148 @@
+/**
+ * @file   ChannelStatusSnapshot_test.cxx
+ * @brief  Test of the indexes of ChannelStatusSnapshot
+ * @date   October 19th, 2026
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE (channel_status_snapshot_test)
+#include "boost/test/unit_test.hpp"
+
+// LArSoft libraries
+#include "larevt/CalibrationDBI/IOVData/ChannelStatusSnapshot.h"
+#include "larevt/CalibrationDBI/IOVData/SnapshotBuilder.h"
+
+// C/C++ standard library
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+using lariov::ChannelStatusSnapshot;
+
+namespace {
+
+  /// Snapshot with the specified (channel, status) rows, in any order
+  ChannelStatusSnapshot MakeSnapshot(
+    std::vector<std::pair<lariov::DBChannelID_t, lariov::chStatus>> const& rows)
+  {
+    ChannelStatusSnapshot snapshot;
+    lariov::SnapshotBuilder<ChannelStatusSnapshot> builder;
+    for (auto const& [channel, status] : rows) {
+      lariov::ChannelStatus cs(channel);
+      cs.SetStatus(status);
+      builder.Add(cs);
+    }
+    builder.Fill(snapshot);
+    snapshot.BuildIndex();
+    return snapshot;
+  }
+
+  bool Bit(std::vector<std::uint64_t> const& words, std::size_t i)
+  {
+    return (words[i / 64] >> (i % 64)) & 1;
+  }
+
+} // local namespace
+
+//------------------------------------------------------------------------------
+// Channel 2 has no row, and channel 70 is in the second word of the masks.
+BOOST_AUTO_TEST_CASE(IndexTest)
+{
+  ChannelStatusSnapshot const snapshot = MakeSnapshot({{70, lariov::kNOISY},
+                                                       {0, lariov::kGOOD},
+                                                       {1, lariov::kDEAD},
+                                                       {3, lariov::kLOWNOISE},
+                                                       {4, lariov::kGOOD},
+                                                       {5, lariov::kDISCONNECTED}});
+
+  BOOST_TEST(snapshot.NChannels() == 6U);
+  BOOST_TEST(snapshot.ChannelLimit() == 71U);
+
+  auto const& packed = snapshot.PackedStatus();
+  BOOST_TEST(packed.size() == 71U);
+  BOOST_TEST(packed[0] == lariov::kGOOD);
+  BOOST_TEST(packed[2] == ChannelStatusSnapshot::kNoStatus);
+  BOOST_TEST(packed[69] == ChannelStatusSnapshot::kNoStatus);
+  BOOST_TEST(packed[70] == lariov::kNOISY);
+
+  using List_t = ChannelStatusSnapshot::ChannelList_t;
+  BOOST_TEST(snapshot.ChannelsWithStatus(lariov::kGOOD) == List_t({0, 4}),
+             boost::test_tools::per_element());
+  BOOST_TEST(snapshot.ChannelsWithStatus(lariov::kNOISY) == List_t({70}),
+             boost::test_tools::per_element());
+  BOOST_TEST(snapshot.ChannelsWithStatus(lariov::kUNKNOWN).empty());
+  BOOST_TEST(snapshot.BadChannels() == List_t({1, 3}), boost::test_tools::per_element());
+
+  auto const& good = snapshot.StatusBits(lariov::kGOOD);
+  BOOST_TEST(good.size() == 2U);
+  BOOST_TEST(good[0] == 0x11U);
+  BOOST_TEST(good[1] == 0U);
+  BOOST_TEST(Bit(snapshot.StatusBits(lariov::kNOISY), 70));
+  BOOST_TEST(snapshot.BadBits()[0] == 0xAU);
+} // BOOST_AUTO_TEST_CASE(IndexTest)
+
+//------------------------------------------------------------------------------
+// Rebuilding the index after replacing a row moves the channel between lists.
+BOOST_AUTO_TEST_CASE(RebuildIndexTest)
+{
+  ChannelStatusSnapshot snapshot = MakeSnapshot({{0, lariov::kGOOD}, {1, lariov::kGOOD}});
+
+  lariov::ChannelStatus dead(1);
+  dead.SetStatus(lariov::kDEAD);
+  snapshot.AddOrReplaceRow(dead);
+  snapshot.BuildIndex();
+
+  BOOST_TEST(snapshot.ChannelsWithStatus(lariov::kGOOD) == ChannelStatusSnapshot::ChannelList_t{0},
+             boost::test_tools::per_element());
+  BOOST_TEST(snapshot.BadChannels() == ChannelStatusSnapshot::ChannelList_t{1},
+             boost::test_tools::per_element());
+  BOOST_TEST(snapshot.PackedStatus()[1] == lariov::kDEAD);
+} // BOOST_AUTO_TEST_CASE(RebuildIndexTest)
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(MatchStatusTest)
+{
+  ChannelStatusSnapshot const snapshot =
+    MakeSnapshot({{0, lariov::kGOOD}, {1, lariov::kDEAD}, {3, lariov::kGOOD}});
+  unsigned int const goodMask = ChannelStatusSnapshot::StatusMaskBit(lariov::kGOOD);
+
+  // 65 queries, so that the result spans two words; the last one is channel 3
+  std::vector<lariov::DBChannelID_t> channels(65, 0);
+  channels[1] = 1;
+  channels[2] = 3;
+  channels[64] = 3;
+  std::vector<std::uint64_t> result(2, ~std::uint64_t(0));
+  BOOST_TEST(snapshot.MatchStatus(channels.data(), channels.size(), goodMask, result.data()));
+  BOOST_TEST(result[0] == ~std::uint64_t(2));
+  BOOST_TEST(result[1] == 1U);
+
+  // channel 2 has no row and channel 1000 is past the limit: their bits are cleared
+  std::vector<lariov::DBChannelID_t> const missing{0, 2, 1000, 3};
+  std::uint64_t word = ~std::uint64_t(0);
+  BOOST_TEST(!snapshot.MatchStatus(missing.data(), missing.size(), goodMask, &word));
+  BOOST_TEST(word == 0x9U);
+
+  // all statuses: only the channels with a row match
+  unsigned int const all = ChannelStatusSnapshot::StatusMaskBit(lariov::kUNKNOWN) * 2 - 1;
+  BOOST_TEST(!snapshot.MatchStatus(missing.data(), missing.size(), all, &word));
+  BOOST_TEST(word == 0x9U);
+
+  // no channel at all
+  BOOST_TEST(snapshot.MatchStatus(nullptr, 0, goodMask, nullptr));
+} // BOOST_AUTO_TEST_CASE(MatchStatusTest)
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(EmptySnapshotTest)
+{
+  ChannelStatusSnapshot snapshot;
+  snapshot.BuildIndex();
+
+  BOOST_TEST(snapshot.PackedStatus().empty());
+  BOOST_TEST(snapshot.BadChannels().empty());
+
+  lariov::DBChannelID_t const channel = 0;
+  std::uint64_t word = ~std::uint64_t(0);
+  BOOST_TEST(!snapshot.MatchStatus(
+    &channel, 1, ChannelStatusSnapshot::StatusMaskBit(lariov::kGOOD), &word));
+  BOOST_TEST(word == 0U);
+} // BOOST_AUTO_TEST_CASE(EmptySnapshotTest)
@@ -0,0 +1,149 @@
+/**
+ * @file   ConditionsTrace_test.cxx
+ * @brief  Test of the writing and reading of conditions traces
+ * @date   October 19th, 2026
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE (conditions_trace_test)
+#include "boost/test/unit_test.hpp"
+
+// LArSoft libraries
+#include "larevt/CalibrationDBI/Providers/ConditionsTrace.h"
+
+// framework libraries
+#include "cetlib_except/exception.h"
+
+// C/C++ standard library
+#include <cstdint>
+#include <fstream>
+#include <set>
+#include <string>
+#include <vector>
+
+using lariov::ConditionsTrace;
+
+namespace {
+
+  /// Writes a trace file made of the header followed by records
+  void WriteTrace(std::string const& path, std::string const& records)
+  {
+    std::string content(ConditionsTrace::kMagic, sizeof(ConditionsTrace::kMagic));
+    content.push_back(char(ConditionsTrace::kVersion));
+    content += records;
+    std::ofstream(path, std::ios::binary | std::ios::trunc).write(content.data(), content.size());
+  }
+
+  /// Unsigned LEB128 encoding of value
+  std::string Number(std::uint64_t value)
+  {
+    std::string bytes;
+    for (; value >= 0x80; value >>= 7)
+      bytes.push_back(char(value | 0x80));
+    bytes.push_back(char(value));
+    return bytes;
+  }
+
+} // local namespace
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(RoundTripTest)
+{
+  std::string const path = "ConditionsTrace_test_roundtrip.trace";
+  auto& trace = ConditionsTrace::Instance();
+
+  BOOST_TEST(!ConditionsTrace::Enabled());
+  trace.Start(path);
+  BOOST_TEST(ConditionsTrace::Enabled());
+
+  std::uint32_t const folder = trace.SourceID(ConditionsTrace::kFolder, "pedestals", "v1");
+  std::uint32_t const status = trace.SourceID(ConditionsTrace::kChannelStatus, "status", "v2");
+  BOOST_TEST(trace.SourceID(ConditionsTrace::kFolder, "pedestals", "v1") == folder);
+
+  std::string const column = "mean";
+  std::vector<std::uint32_t> const channels{3, 200, 70000};
+  trace.Record(folder, ConditionsTrace::kUpdateData, 1600000000, 0);
+  trace.Record(folder, ConditionsTrace::kNamedData, 1600000000, 12, &column);
+  trace.Record(status, ConditionsTrace::kAreGood, 1600000001, channels.data(), channels.size());
+  trace.Record(status, ConditionsTrace::kIsBad, 1600000001, 300);
+  BOOST_TEST(trace.Stop() == 4U);
+  BOOST_TEST(!ConditionsTrace::Enabled());
+
+  // calls after Stop() are not recorded
+  trace.Record(folder, ConditionsTrace::kUpdateData, 1600000002, 0);
+
+  ConditionsTrace::Reader reader(path);
+  ConditionsTrace::Reader::Call call;
+
+  BOOST_TEST_REQUIRE(reader.Next(call));
+  BOOST_TEST(call.source == folder);
+  BOOST_TEST(call.accessor == ConditionsTrace::kUpdateData);
+  BOOST_TEST(call.time == 1600000000U);
+
+  BOOST_TEST_REQUIRE(reader.Next(call));
+  BOOST_TEST(call.accessor == ConditionsTrace::kNamedData);
+  BOOST_TEST(call.value == 12U);
+  BOOST_TEST(call.column == "mean");
+
+  BOOST_TEST_REQUIRE(reader.Next(call));
+  BOOST_TEST(call.source == status);
+  BOOST_TEST(call.accessor == ConditionsTrace::kAreGood);
+  BOOST_TEST(call.time == 1600000001U);
+  BOOST_TEST(call.value == 3U);
+  BOOST_TEST(call.values == channels, boost::test_tools::per_element());
+  BOOST_TEST(call.column.empty());
+
+  BOOST_TEST_REQUIRE(reader.Next(call));
+  BOOST_TEST(call.accessor == ConditionsTrace::kIsBad);
+  BOOST_TEST(call.value == 300U);
+  BOOST_TEST(call.values.empty());
+
+  BOOST_TEST(!reader.Next(call));
+
+  BOOST_TEST_REQUIRE(reader.Sources().size() == 2U);
+  BOOST_TEST(reader.Sources()[status].type == ConditionsTrace::kChannelStatus);
+  BOOST_TEST(reader.Sources()[status].folder == "status");
+  BOOST_TEST(reader.Sources()[status].tag == "v2");
+} // BOOST_AUTO_TEST_CASE(RoundTripTest)
+
+//------------------------------------------------------------------------------
+// The replay reports calls by accessor name.
+BOOST_AUTO_TEST_CASE(AccessorNameTest)
+{
+  std::set<std::string> names;
+  for (unsigned int a = 0; a != ConditionsTrace::kNAccessors; ++a)
+    names.insert(ConditionsTrace::AccessorName(ConditionsTrace::Accessor_t(a)));
+  BOOST_TEST(names.size() == std::size_t(ConditionsTrace::kNAccessors));
+  BOOST_TEST(names.count("unknown") == 0U);
+} // BOOST_AUTO_TEST_CASE(AccessorNameTest)
+
+//------------------------------------------------------------------------------
+// Lengths are checked against the size of the file before allocating.
+BOOST_AUTO_TEST_CASE(CorruptedTraceTest)
+{
+  std::string const path = "ConditionsTrace_test_corrupted.trace";
+  ConditionsTrace::Reader::Call call;
+
+  WriteTrace(path, "");
+  BOOST_TEST(!ConditionsTrace::Reader(path).Next(call));
+
+  // column name of 2^40 bytes
+  WriteTrace(path, char(ConditionsTrace::kDefineColumn) + Number(0) + Number(1ULL << 40) + "mean");
+  BOOST_CHECK_THROW(ConditionsTrace::Reader(path).Next(call), cet::exception);
+
+  // string one byte longer than the rest of the file
+  std::string const source = char(ConditionsTrace::kDefineSource) + Number(0) +
+                             char(ConditionsTrace::kFolder) + Number(4) + "peds" + Number(3);
+  WriteTrace(path, source + "v1");
+  BOOST_CHECK_THROW(ConditionsTrace::Reader(path).Next(call), cet::exception);
+
+  // list of 2^32 - 1 channels
+  WriteTrace(path,
+             source + "v10" + char(ConditionsTrace::kCall + ConditionsTrace::kAreGood) +
+               Number(0) + Number(0xFFFFFFFF) + Number(5));
+  BOOST_CHECK_THROW(ConditionsTrace::Reader(path).Next(call), cet::exception);
+
+  // not a trace
+  std::ofstream(path, std::ios::trunc) << "LARIOVBN";
+  BOOST_CHECK_THROW(ConditionsTrace::Reader{path}, cet::exception);
+} // BOOST_AUTO_TEST_CASE(CorruptedTraceTest)
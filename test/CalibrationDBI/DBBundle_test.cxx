@@ -0,0 +1,155 @@
+/**
+ * @file   DBBundle_test.cxx
+ * @brief  Test of the encoding and decoding of DBBundle files
+ * @date   October 19th, 2026
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE (db_bundle_test)
+#include "boost/test/unit_test.hpp"
+
+// LArSoft libraries
+#include "larevt/CalibrationDBI/IOVData/IOVTimeStamp.h"
+#include "larevt/CalibrationDBI/Providers/DBBundle.h"
+#include "larevt/CalibrationDBI/Providers/DBDataset.h"
+
+// framework libraries
+#include "cetlib_except/exception.h"
+
+// C/C++ standard library
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+using lariov::DBBundle;
+using lariov::DBDataset;
+using lariov::IOVTimeStamp;
+
+namespace {
+
+  /// Dataset with columns channel (integer), gain (real), label (text)
+  DBDataset MakeDataset(IOVTimeStamp const& begin, IOVTimeStamp const& end, double gain)
+  {
+    std::vector<lariov::DBChannelID_t> channels{4, 7};
+    std::vector<DBDataset::value_type> data;
+    for (lariov::DBChannelID_t const ch : channels) {
+      data.emplace_back(long(ch));
+      data.emplace_back(gain + ch);
+      data.emplace_back(std::make_unique<std::string>("ch" + std::to_string(ch)));
+    }
+    return DBDataset(begin,
+                     end,
+                     {"channel", "gain", "label"},
+                     {"integer", "real", "text"},
+                     std::move(channels),
+                     std::move(data));
+  }
+
+  std::string ReadFile(std::string const& path)
+  {
+    std::ifstream in(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  }
+
+  void WriteFile(std::string const& path, std::string const& content)
+  {
+    std::ofstream(path, std::ios::binary | std::ios::trunc).write(content.data(), content.size());
+  }
+
+} // local namespace
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(RoundTripTest)
+{
+  std::string const path = "DBBundle_test_roundtrip.bundle";
+
+  DBBundle::Writer writer;
+  BOOST_TEST(writer.Add("pedestals", "v1", MakeDataset(IOVTimeStamp(100), IOVTimeStamp(200), 1.)));
+  BOOST_TEST(writer.Add("pedestals", "v1", MakeDataset(IOVTimeStamp(200), IOVTimeStamp(300), 2.)));
+  BOOST_TEST(writer.Add("pedestals", "v2", MakeDataset(IOVTimeStamp(100), IOVTimeStamp(300), 1.)));
+  BOOST_TEST(!writer.Add("pedestals", "v1", MakeDataset(IOVTimeStamp(100), IOVTimeStamp(150), 3.)));
+  BOOST_TEST(writer.NEntries() == 3U);
+
+  // v2 has the same content as the first interval of v1, but not the same end
+  BOOST_TEST(writer.NPayloads() == 2U);
+  writer.Write(path);
+
+  DBBundle const bundle(path);
+  BOOST_TEST(bundle.NEntries() == 3U);
+
+  auto const data = bundle.Find("pedestals", "v1", IOVTimeStamp(250, 7));
+  BOOST_TEST_REQUIRE(data);
+  BOOST_TEST((data->beginTime() == IOVTimeStamp(200)));
+  BOOST_TEST((data->endTime() == IOVTimeStamp(300)));
+  BOOST_TEST(data->colNames() == std::vector<std::string>({"channel", "gain", "label"}),
+             boost::test_tools::per_element());
+  BOOST_TEST(data->colTypes() == std::vector<std::string>({"integer", "real", "text"}),
+             boost::test_tools::per_element());
+  BOOST_TEST(data->channels() == std::vector<lariov::DBChannelID_t>({4, 7}),
+             boost::test_tools::per_element());
+  BOOST_TEST(data->getRow(1).getLongData(0) == 7);
+  BOOST_TEST(data->getRow(1).getDoubleData(1) == 9.);
+  BOOST_TEST(data->getRow(0).getStringData(2) == "ch4");
+
+  // the begin of an interval is in it, the end is not
+  BOOST_TEST((bundle.Find("pedestals", "v1", IOVTimeStamp(100))->endTime() == IOVTimeStamp(200)));
+  BOOST_TEST(!bundle.Find("pedestals", "v1", IOVTimeStamp(300)));
+  BOOST_TEST(!bundle.Find("pedestals", "v1", IOVTimeStamp(99, 999999)));
+  BOOST_TEST(!bundle.Find("pedestals", "v3", IOVTimeStamp(150)));
+  BOOST_TEST(!bundle.Find("gains", "v1", IOVTimeStamp(150)));
+  BOOST_TEST(bundle.Find("pedestals", "v2", IOVTimeStamp(250))->getRow(0).getDoubleData(1) == 5.);
+} // BOOST_AUTO_TEST_CASE(RoundTripTest)
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(TruncatedFileTest)
+{
+  std::string const path = "DBBundle_test_truncated.bundle";
+
+  DBBundle::Writer writer;
+  writer.Add("pedestals", "v1", MakeDataset(IOVTimeStamp(100), IOVTimeStamp(200), 1.));
+  writer.Write(path);
+
+  std::string const content = ReadFile(path);
+  WriteFile(path, content.substr(0, content.size() - 8));
+  BOOST_CHECK_THROW(DBBundle{path}, cet::exception);
+
+  WriteFile(path, content.substr(0, 16));
+  BOOST_CHECK_THROW(DBBundle{path}, cet::exception);
+} // BOOST_AUTO_TEST_CASE(TruncatedFileTest)
+
+//------------------------------------------------------------------------------
+// A corrupted payload is reported when decoded, before allocating for its sizes.
+BOOST_AUTO_TEST_CASE(CorruptedPayloadTest)
+{
+  std::string const path = "DBBundle_test_corrupted.bundle";
+
+  // The only payload follows the 64-byte header: number of rows, then of columns.
+  DBBundle::Writer writer;
+  writer.Add("empty", "v1", DBDataset(IOVTimeStamp(100), IOVTimeStamp(200), {}, {}, {}, {}));
+  writer.Add("full", "v1", MakeDataset(IOVTimeStamp(100), IOVTimeStamp(200), 1.));
+  writer.Write(path);
+  BOOST_TEST(DBBundle(path).Find("empty", "v1", IOVTimeStamp(150))->nrows() == 0U);
+
+  std::string const content = ReadFile(path);
+  auto const patched = [&content](std::uint32_t nrows, std::uint32_t ncols) {
+    std::string bytes = content;
+    bytes.replace(64, 4, reinterpret_cast<const char*>(&nrows), 4);
+    bytes.replace(68, 4, reinterpret_cast<const char*>(&ncols), 4);
+    return bytes;
+  };
+
+  // many rows and no column
+  WriteFile(path, patched(0xFFFFFFFF, 0));
+  BOOST_CHECK_THROW(DBBundle(path).Find("empty", "v1", IOVTimeStamp(150)), cet::exception);
+
+  // many columns and no row
+  WriteFile(path, patched(0, 0xFFFFFFFF));
+  BOOST_CHECK_THROW(DBBundle(path).Find("empty", "v1", IOVTimeStamp(150)), cet::exception);
+
+  // the other payloads are still readable
+  BOOST_TEST(DBBundle(path).Find("full", "v1", IOVTimeStamp(150))->nrows() == 2U);
+} // BOOST_AUTO_TEST_CASE(CorruptedPayloadTest)
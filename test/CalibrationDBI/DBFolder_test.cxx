@@ -0,0 +1,89 @@
+/**
+ * @file   DBFolder_test.cxx
+ * @brief  Test of DBFolder::MatchDatasets(), used by the shadow comparisons
+ * @date   October 19th, 2026
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE (db_folder_test)
+#include "boost/test/unit_test.hpp"
+
+// LArSoft libraries
+#include "larevt/CalibrationDBI/IOVData/IOVTimeStamp.h"
+#include "larevt/CalibrationDBI/Providers/DBDataset.h"
+#include "larevt/CalibrationDBI/Providers/DBFolder.h"
+
+// C/C++ standard library
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using lariov::DBDataset;
+using lariov::DBFolder;
+using lariov::IOVTimeStamp;
+
+namespace {
+
+  /// Dataset with columns channel, gain (real), label (text) and one row per channel
+  DBDataset MakeDataset(IOVTimeStamp const& end, std::string const& label = "ch")
+  {
+    std::vector<lariov::DBChannelID_t> channels{0, 1, 2};
+    std::vector<DBDataset::value_type> data;
+    for (lariov::DBChannelID_t const ch : channels) {
+      data.emplace_back(long(ch));
+      data.emplace_back(ch + 0.5);
+      data.emplace_back(std::make_unique<std::string>(label + std::to_string(ch)));
+    }
+    return DBDataset(IOVTimeStamp(1600000000),
+                     end,
+                     {"channel", "gain", "label"},
+                     {"integer", "real", "text"},
+                     std::move(channels),
+                     std::move(data));
+  }
+
+} // local namespace
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(IdenticalTest)
+{
+  DBDataset const data1 = MakeDataset(IOVTimeStamp(1600003600));
+  DBDataset const data2 = MakeDataset(IOVTimeStamp(1600003600));
+
+  std::ostringstream report;
+  BOOST_TEST(DBFolder::MatchDatasets(data1, data2, &report));
+  BOOST_TEST(report.str().empty());
+  BOOST_TEST(DBFolder::MatchDatasets(data1, data1));
+
+  // two empty datasets match too
+  BOOST_TEST(DBFolder::MatchDatasets(DBDataset(), DBDataset()));
+} // BOOST_AUTO_TEST_CASE(IdenticalTest)
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(EndTimeTest)
+{
+  DBDataset const data1 = MakeDataset(IOVTimeStamp(1600003600));
+  DBDataset const data2 = MakeDataset(IOVTimeStamp(1600007200));
+
+  std::ostringstream report;
+  BOOST_TEST(!DBFolder::MatchDatasets(data1, data2, &report));
+  BOOST_TEST(report.str().find("End time mismatch") != std::string::npos);
+  BOOST_TEST(report.str().find("Value mismatch") == std::string::npos);
+
+  // an open-ended interval is not the same as a closed one
+  BOOST_TEST(!DBFolder::MatchDatasets(data1, MakeDataset(IOVTimeStamp::MaxTimeStamp())));
+} // BOOST_AUTO_TEST_CASE(EndTimeTest)
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(TextValueTest)
+{
+  DBDataset const data1 = MakeDataset(IOVTimeStamp(1600003600), "ch");
+  DBDataset const data2 = MakeDataset(IOVTimeStamp(1600003600), "channel");
+
+  std::ostringstream report;
+  BOOST_TEST(!DBFolder::MatchDatasets(data1, data2, &report));
+  BOOST_TEST(report.str().find("Value mismatch ch0 vs. channel0") != std::string::npos);
+  BOOST_TEST(report.str().find("time mismatch") == std::string::npos);
+} // BOOST_AUTO_TEST_CASE(TextValueTest)
@@ -0,0 +1,323 @@
+/**
+ * @file   DBHttpClient_test.cxx
+ * @brief  Test of DBHttpClient against an HTTP server on the loopback interface
+ * @date   October 19th, 2026
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE (db_http_client_test)
+#include "boost/test/unit_test.hpp"
+
+// LArSoft libraries
+#include "larevt/CalibrationDBI/IOVData/IOVTimeStamp.h"
+#include "larevt/CalibrationDBI/Providers/DBDataset.h"
+#include "larevt/CalibrationDBI/Providers/DBDatasetParser.h"
+#include "larevt/CalibrationDBI/Providers/DBFolder.h"
+#include "larevt/CalibrationDBI/Providers/DBHttpClient.h"
+#include "larevt/CalibrationDBI/Providers/WebError.h"
+
+// C/C++ standard library
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <zlib.h>
+
+using lariov::DBDataset;
+using lariov::DBDatasetParser;
+using lariov::DBHttpClient;
+using lariov::IOVTimeStamp;
+
+namespace {
+
+  /**
+   * @brief HTTP/1.1 server on the loopback interface, for the duration of a test
+   *
+   * Each request gets the reply of the handler, and connections stay open
+   * until the client closes them, so that the ones reused can be counted.
+   * Each connection is served by a thread of its own.
+   */
+  class LoopbackServer {
+
+  public:
+    struct Reply {
+      int status = 200;
+      std::string body;
+      bool gzip = false;                  ///< Whether to send the body compressed
+      std::chrono::milliseconds delay{0}; ///< Wait before replying
+    };
+
+    /// Returns the reply to a request, given its line and headers
+    using Handler_t = std::function<Reply(std::string const&)>;
+
+    explicit LoopbackServer(Handler_t handler) : fHandler(std::move(handler))
+    {
+      fSocket = socket(AF_INET, SOCK_STREAM, 0);
+      sockaddr_in address{};
+      address.sin_family = AF_INET;
+      address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+      address.sin_port = 0; // Any free port.
+      socklen_t length = sizeof(address);
+      if (fSocket < 0 || bind(fSocket, reinterpret_cast<sockaddr*>(&address), length) != 0 ||
+          listen(fSocket, 8) != 0 ||
+          getsockname(fSocket, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+        throw std::runtime_error("Could not open a socket on the loopback interface");
+      }
+      fURL = "http://127.0.0.1:" + std::to_string(ntohs(address.sin_port));
+      fAcceptThread = std::thread(&LoopbackServer::Accept, this);
+    }
+
+    ~LoopbackServer()
+    {
+      {
+        std::lock_guard<std::mutex> lock(fMutex);
+        fStop = true;
+      }
+      fWakeUp.notify_all();
+      shutdown(fSocket, SHUT_RDWR); // Interrupts accept().
+      fAcceptThread.join();
+      close(fSocket);
+      for (int const connection : fConnections)
+        shutdown(connection, SHUT_RDWR);
+      for (auto& thread : fConnectionThreads)
+        thread.join();
+      for (int const connection : fConnections)
+        close(connection);
+    }
+
+    std::string const& URL() const { return fURL; }
+
+    /// Number of connections opened by clients
+    unsigned int Connections() const { return fNConnections; }
+
+    /// Number of requests received
+    unsigned int Requests() const { return fNRequests; }
+
+  private:
+    void Accept()
+    {
+      int connection;
+      while ((connection = accept(fSocket, nullptr, nullptr)) >= 0) {
+        ++fNConnections;
+        fConnections.push_back(connection);
+        fConnectionThreads.emplace_back(&LoopbackServer::Serve, this, connection);
+      }
+    }
+
+    void Serve(int connection)
+    {
+      std::string received;
+      char buffer[4096];
+      while (true) {
+        auto const end = received.find("\r\n\r\n");
+        if (end == std::string::npos) {
+          ssize_t const n = recv(connection, buffer, sizeof(buffer), 0);
+          if (n <= 0) return; // Closed by the client or by the destructor.
+          received.append(buffer, n);
+          continue;
+        }
+        std::string const request = received.substr(0, end);
+        received.erase(0, end + 4);
+        ++fNRequests;
+
+        Reply const reply = fHandler(request);
+        {
+          std::unique_lock<std::mutex> lock(fMutex);
+          if (fWakeUp.wait_for(lock, reply.delay, [this] { return fStop; })) return;
+        }
+
+        std::string const body = reply.gzip ? Gzip(reply.body) : reply.body;
+        std::string response = "HTTP/1.1 " + std::to_string(reply.status) + " Status\r\n";
+        if (reply.gzip) response += "Content-Encoding: gzip\r\n";
+        response += "Content-Length: " + std::to_string(body.size()) + "\r\n\r\n" + body;
+        for (std::size_t sent = 0; sent < response.size();) {
+          ssize_t const n =
+            send(connection, response.data() + sent, response.size() - sent, MSG_NOSIGNAL);
+          if (n <= 0) return;
+          sent += n;
+        }
+      }
+    }
+
+    static std::string Gzip(std::string const& data)
+    {
+      z_stream stream{};
+      deflateInit2(&stream, Z_BEST_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY);
+      std::string compressed(deflateBound(&stream, data.size()), '\0');
+      stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+      stream.avail_in = data.size();
+      stream.next_out = reinterpret_cast<Bytef*>(&compressed[0]);
+      stream.avail_out = compressed.size();
+      deflate(&stream, Z_FINISH);
+      compressed.resize(stream.total_out);
+      deflateEnd(&stream);
+      return compressed;
+    }
+
+    Handler_t fHandler;
+    std::string fURL;
+    int fSocket;
+    std::thread fAcceptThread;
+    std::vector<int> fConnections; // Written by the accept thread only.
+    std::vector<std::thread> fConnectionThreads;
+    std::atomic<unsigned int> fNConnections{0};
+    std::atomic<unsigned int> fNRequests{0};
+    std::mutex fMutex;
+    std::condition_variable fWakeUp; // Interrupts the delays of the replies.
+    bool fStop = false;
+  };
+
+  /// Body of a conditions server response with a gain for each of nchannels
+  std::string DatasetBody(unsigned int nchannels)
+  {
+    std::string body = "1600000000\n-\nchannel,gain\ninteger,real\n";
+    for (unsigned int ch = 0; ch != nchannels; ++ch)
+      body += std::to_string(ch) + "," + std::to_string(ch % 10) + ".5\n";
+    return body;
+  }
+
+  bool AcceptsGzip(std::string const& request)
+  {
+    auto const header = request.find("Accept-Encoding:");
+    return header != std::string::npos &&
+           request.find("gzip", header) < request.find("\r\n", header);
+  }
+
+} // local namespace
+
+//------------------------------------------------------------------------------
+// Successive queries to a server go through the same connection.
+BOOST_AUTO_TEST_CASE(KeepAliveTest)
+{
+  LoopbackServer server([](std::string const&) {
+    LoopbackServer::Reply reply;
+    reply.body = DatasetBody(3);
+    return reply;
+  });
+
+  for (int query = 0; query != 3; ++query) {
+    DBDatasetParser parser;
+    auto const response = DBHttpClient::Instance().Get(server.URL() + "/data", 10, parser);
+    BOOST_TEST(response.status == 200);
+    BOOST_TEST(response.message.empty());
+    DBDataset const data = parser.Finish();
+    BOOST_TEST(data.nrows() == 3U);
+    BOOST_TEST((data.beginTime() == IOVTimeStamp(1600000000)));
+    BOOST_TEST((data.endTime() == IOVTimeStamp::MaxTimeStamp()));
+  }
+  BOOST_TEST(server.Requests() == 3U);
+  BOOST_TEST(server.Connections() == 1U);
+} // BOOST_AUTO_TEST_CASE(KeepAliveTest)
+
+//------------------------------------------------------------------------------
+// A compressed response is decompressed on the way to the parser.
+BOOST_AUTO_TEST_CASE(GzipTest)
+{
+  std::string const body = DatasetBody(2000);
+  std::atomic<bool> compressed{false};
+  LoopbackServer server([&body, &compressed](std::string const& request) {
+    LoopbackServer::Reply reply;
+    reply.body = body;
+    reply.gzip = AcceptsGzip(request);
+    compressed = reply.gzip;
+    return reply;
+  });
+
+  DBDatasetParser parser;
+  auto const response = DBHttpClient::Instance().Get(server.URL() + "/data", 10, parser);
+  BOOST_TEST_REQUIRE(compressed.load());
+  BOOST_TEST(response.status == 200);
+  BOOST_TEST(response.transferBytes < body.size() / 2);
+
+  DBDataset const data = parser.Finish();
+  BOOST_TEST_REQUIRE(data.nrows() == 2000U);
+  BOOST_TEST(data.getRow(1999).getLongData(0) == 1999);
+  BOOST_TEST(data.getRow(1999).getDoubleData(1) == 9.5);
+} // BOOST_AUTO_TEST_CASE(GzipTest)
+
+//------------------------------------------------------------------------------
+// A client error is returned at once, and DBFolder turns it into a WebError.
+BOOST_AUTO_TEST_CASE(ClientErrorTest)
+{
+  std::string lastRequest;
+  std::mutex requestMutex;
+  LoopbackServer server([&lastRequest, &requestMutex](std::string const& request) {
+    std::lock_guard<std::mutex> lock(requestMutex);
+    lastRequest = request;
+    LoopbackServer::Reply reply;
+    reply.status = 404;
+    reply.body = "No such folder";
+    return reply;
+  });
+
+  DBDatasetParser parser;
+  auto const response = DBHttpClient::Instance().Get(server.URL() + "/data", 10, parser);
+  BOOST_TEST(response.status == 404);
+  BOOST_TEST(response.message == "No such folder");
+  BOOST_TEST(server.Requests() == 1U);
+
+  lariov::DBFolder folder("pedestals", server.URL(), "", "v1", false, false, 0., false, "", false);
+  try {
+    folder.UpdateData(1600000100 * lariov::DBTimeStamp_t(1000000000));
+    BOOST_ERROR("No WebError thrown");
+  }
+  catch (lariov::WebError const& e) {
+    std::string const what = e.what();
+    BOOST_TEST(what.find("status: 404") != std::string::npos);
+    BOOST_TEST(what.find("No such folder") != std::string::npos);
+  }
+  std::lock_guard<std::mutex> lock(requestMutex);
+  BOOST_TEST(lastRequest.find("f=pedestals") != std::string::npos);
+  BOOST_TEST(lastRequest.find("tag=v1") != std::string::npos);
+} // BOOST_AUTO_TEST_CASE(ClientErrorTest)
+
+//------------------------------------------------------------------------------
+// A server error is retried while the timeout allows.
+BOOST_AUTO_TEST_CASE(ServerErrorTest)
+{
+  LoopbackServer server([](std::string const&) {
+    LoopbackServer::Reply reply;
+    reply.status = 503;
+    reply.body = "Try again";
+    return reply;
+  });
+
+  // The first retry comes after 1 s, the next one would come after 3 s.
+  DBDatasetParser parser;
+  auto const response = DBHttpClient::Instance().Get(server.URL() + "/data", 3, parser);
+  BOOST_TEST(response.status == 503);
+  BOOST_TEST(response.message == "Try again");
+  BOOST_TEST(server.Requests() == 2U);
+} // BOOST_AUTO_TEST_CASE(ServerErrorTest)
+
+//------------------------------------------------------------------------------
+// A server not answering in time gives a response with no status.
+BOOST_AUTO_TEST_CASE(TimeoutTest)
+{
+  LoopbackServer server([](std::string const&) {
+    LoopbackServer::Reply reply;
+    reply.body = DatasetBody(3);
+    reply.delay = std::chrono::seconds(10);
+    return reply;
+  });
+
+  auto const start = std::chrono::steady_clock::now();
+  DBDatasetParser parser;
+  auto const response = DBHttpClient::Instance().Get(server.URL() + "/data", 1, parser);
+  auto const elapsed = std::chrono::steady_clock::now() - start;
+  BOOST_TEST(response.status == 0);
+  BOOST_TEST(!response.message.empty());
+  BOOST_TEST(server.Requests() == 1U);
+  BOOST_TEST((elapsed < std::chrono::seconds(3)));
+} // BOOST_AUTO_TEST_CASE(TimeoutTest)
@@ -0,0 +1,128 @@
+/**
+ * @file   DBPayloadStore_test.cxx
+ * @brief  Test of the recording periods of DBPayloadStore
+ * @date   October 19th, 2026
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE (db_payload_store_test)
+#include "boost/test/unit_test.hpp"
+
+// LArSoft libraries
+#include "larevt/CalibrationDBI/IOVData/IOVTimeStamp.h"
+#include "larevt/CalibrationDBI/Providers/DBDataset.h"
+#include "larevt/CalibrationDBI/Providers/DBPayloadStore.h"
+
+// C/C++ standard library
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+using lariov::DBDataset;
+using lariov::DBPayload;
+using lariov::DBPayloadStore;
+using lariov::IOVTimeStamp;
+
+namespace {
+
+  /// Dataset valid in [ begin, end ) with one gain per channel
+  DBPayloadStore::DatasetPtr_t MakeDataset(unsigned long begin, unsigned long end)
+  {
+    std::vector<lariov::DBChannelID_t> channels{0, 1};
+    std::vector<DBDataset::value_type> data;
+    for (lariov::DBChannelID_t const ch : channels) {
+      data.emplace_back(long(ch));
+      data.emplace_back(ch + 0.5);
+    }
+    return std::make_shared<DBDataset const>(IOVTimeStamp(begin),
+                                             IOVTimeStamp(end),
+                                             std::vector<std::string>{"channel", "gain"},
+                                             std::vector<std::string>{"integer", "real"},
+                                             std::move(channels),
+                                             std::move(data));
+  }
+
+  /// Begin times of the payloads
+  std::vector<unsigned long> Begins(std::vector<DBPayload> const& payloads)
+  {
+    std::vector<unsigned long> begins;
+    for (DBPayload const& payload : payloads)
+      begins.push_back(payload.beginStamp);
+    return begins;
+  }
+
+} // local namespace
+
+//------------------------------------------------------------------------------
+// Two runs share the first interval of validity, whose snapshot stays cached: it is
+// fetched only in the first run, but used, and then written, in both.
+BOOST_AUTO_TEST_CASE(SharedIntervalTest)
+{
+  DBPayloadStore& store = DBPayloadStore::Instance();
+  store.SetRecording(true);
+
+  // run 1: the folder fetches the first interval
+  auto shared = store.Use("pedestals", "v1", MakeDataset(100, 300));
+  BOOST_TEST(Begins(store.TakeRecordedPayloads()) == std::vector<unsigned long>({100}),
+             boost::test_tools::per_element());
+
+  // run 2: the cached data are used again, then the second interval is fetched
+  // and the first one evicted
+  auto second = store.Use("pedestals", "v1", MakeDataset(300, 400));
+  shared.reset();
+  BOOST_TEST(Begins(store.TakeRecordedPayloads()) == std::vector<unsigned long>({100, 300}),
+             boost::test_tools::per_element());
+
+  // run 3: only the second interval is still held
+  auto const payloads = store.TakeRecordedPayloads();
+  BOOST_TEST(Begins(payloads) == std::vector<unsigned long>({300}),
+             boost::test_tools::per_element());
+  BOOST_TEST_REQUIRE(payloads.size() == 1U);
+  BOOST_TEST(payloads[0].folder == "pedestals");
+  BOOST_TEST(payloads[0].tag == "v1");
+  BOOST_TEST(payloads[0].endStamp == 400U);
+
+  // run 4 still starts with the second interval; run 5, with nothing
+  second.reset();
+  BOOST_TEST(store.TakeRecordedPayloads().size() == 1U);
+  BOOST_TEST(store.TakeRecordedPayloads().empty());
+} // BOOST_AUTO_TEST_CASE(SharedIntervalTest)
+
+//------------------------------------------------------------------------------
+// Data recorded with no handle belong only to the period they were recorded in.
+BOOST_AUTO_TEST_CASE(RecordTest)
+{
+  DBPayloadStore& store = DBPayloadStore::Instance();
+  store.TakeRecordedPayloads();
+
+  store.Record("status", "v2", MakeDataset(100, 200));
+  store.Record("status", "v2", MakeDataset(100, 200)); // once per interval
+  auto const use = store.Use("gains", "v1", MakeDataset(50, 150));
+
+  auto const payloads = store.RecordedPayloads();
+  BOOST_TEST_REQUIRE(payloads.size() == 2U);
+  BOOST_TEST(payloads[0].folder == "gains");
+  BOOST_TEST(payloads[1].folder == "status");
+
+  BOOST_TEST(store.TakeRecordedPayloads().size() == 2U);
+  auto const next = store.TakeRecordedPayloads();
+  BOOST_TEST_REQUIRE(next.size() == 1U);
+  BOOST_TEST(next[0].folder == "gains");
+} // BOOST_AUTO_TEST_CASE(RecordTest)
+
+//------------------------------------------------------------------------------
+// A payload converts back to the dataset it was made from.
+BOOST_AUTO_TEST_CASE(LoadTest)
+{
+  DBPayloadStore& store = DBPayloadStore::Instance();
+  store.Load({DBPayloadStore::ToPayload("pedestals", "v3", *MakeDataset(100, 300))});
+
+  auto const data = store.Find("pedestals", "v3", IOVTimeStamp(299, 999999));
+  BOOST_TEST_REQUIRE(data);
+  BOOST_TEST((data->beginTime() == IOVTimeStamp(100)));
+  BOOST_TEST(data->getRow(1).getDoubleData(1) == 1.5);
+  BOOST_TEST(!store.Find("pedestals", "v3", IOVTimeStamp(300)));
+  BOOST_TEST(!store.Find("pedestals", "v3", IOVTimeStamp(99)));
+  BOOST_TEST(!store.Find("pedestals", "v1", IOVTimeStamp(150)));
+} // BOOST_AUTO_TEST_CASE(LoadTest)
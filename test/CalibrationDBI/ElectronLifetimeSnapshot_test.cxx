@@ -0,0 +1,105 @@
+/**
+ * @file   ElectronLifetimeSnapshot_test.cxx
+ * @brief  Test of the attenuation table of ElectronLifetimeSnapshot
+ * @date   October 19th, 2026
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE (electron_lifetime_snapshot_test)
+#include "boost/test/unit_test.hpp"
+
+// LArSoft libraries
+#include "larevt/CalibrationDBI/IOVData/ElectronLifetimeSnapshot.h"
+#include "larevt/CalibrationDBI/IOVData/IOVDataError.h"
+
+// C/C++ standard library
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+using lariov::ElectronLifetimeSnapshot;
+
+namespace {
+
+  constexpr unsigned int kChannel = 3;
+  constexpr float kLifetime = 1000.f;
+
+  /// Snapshot with the lifetime in the row of kChannel and a decoy row before it
+  ElectronLifetimeSnapshot MakeSnapshot(float lifetime = kLifetime)
+  {
+    ElectronLifetimeSnapshot snapshot;
+    lariov::ElectronLifetimeContainer row(0);
+    row.SetTimeConstant(1.f);
+    snapshot.AddOrReplaceRow(row);
+    row.SetChannel(kChannel);
+    row.SetTimeConstant(lifetime);
+    snapshot.AddOrReplaceRow(row);
+    return snapshot;
+  }
+
+  double Exact(float t) { return std::exp(-double(t) / kLifetime); }
+
+} // local namespace
+
+//------------------------------------------------------------------------------
+// Linear interpolation errs by at most (step / lifetime)^2 / 8, here 7.5e-7.
+BOOST_AUTO_TEST_CASE(InterpolationTest)
+{
+  ElectronLifetimeSnapshot snapshot = MakeSnapshot();
+  snapshot.BuildAttenuationTable(kChannel, 10000.f, 4096);
+  BOOST_TEST(snapshot.Lifetime() == kLifetime);
+  BOOST_TEST(snapshot.MaxDriftTime() == 10000.f);
+
+  BOOST_TEST(snapshot.Attenuation(0.f) == 1.f);
+
+  double maxError = 0.;
+  for (float t = 0.f; t <= 10000.f; t += 0.37f)
+    maxError = std::max(maxError, std::abs(snapshot.Attenuation(t) - Exact(t)));
+  BOOST_TEST(maxError < 1e-6);
+
+  // the batch version gives the same answers
+  std::vector<float> const times{0.f, 1.5f, 2000.f, 9999.9f, 10000.f};
+  std::vector<float> attenuation(times.size());
+  snapshot.Attenuation(times.data(), times.size(), attenuation.data());
+  for (std::size_t i = 0; i != times.size(); ++i)
+    BOOST_TEST(attenuation[i] == snapshot.Attenuation(times[i]));
+} // BOOST_AUTO_TEST_CASE(InterpolationTest)
+
+//------------------------------------------------------------------------------
+// Drift times out of the table are computed exactly.
+BOOST_AUTO_TEST_CASE(OutOfRangeTest)
+{
+  ElectronLifetimeSnapshot snapshot = MakeSnapshot();
+  snapshot.BuildAttenuationTable(kChannel, 100.f, 4);
+
+  std::vector<float> const times{-50.f, 100.5f, 3000.f, 1e6f};
+  std::vector<float> attenuation(times.size());
+  snapshot.Attenuation(times.data(), times.size(), attenuation.data());
+  for (std::size_t i = 0; i != times.size(); ++i)
+    BOOST_TEST(attenuation[i] == std::exp(-times[i] * (1.f / kLifetime)));
+  BOOST_TEST(attenuation[3] == 0.f);
+
+  // NaN is not in the table either
+  BOOST_TEST(std::isnan(snapshot.Attenuation(std::nanf(""))));
+} // BOOST_AUTO_TEST_CASE(OutOfRangeTest)
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(ErrorTest)
+{
+  // the table must be built before use
+  ElectronLifetimeSnapshot snapshot = MakeSnapshot();
+  BOOST_CHECK_THROW(snapshot.Attenuation(10.f), lariov::IOVDataError);
+
+  // the lifetime must be positive, and the table not empty
+  BOOST_CHECK_THROW(MakeSnapshot(0.f).BuildAttenuationTable(kChannel, 100.f, 4),
+                    lariov::IOVDataError);
+  BOOST_CHECK_THROW(MakeSnapshot(-1.f).BuildAttenuationTable(kChannel, 100.f, 4),
+                    lariov::IOVDataError);
+  BOOST_CHECK_THROW(snapshot.BuildAttenuationTable(kChannel, 0.f, 4), lariov::IOVDataError);
+  BOOST_CHECK_THROW(snapshot.BuildAttenuationTable(kChannel, 100.f, 0), lariov::IOVDataError);
+
+  // a channel with no row
+  BOOST_CHECK_THROW(snapshot.BuildAttenuationTable(7, 100.f, 4), lariov::IOVDataError);
+  BOOST_CHECK_THROW(snapshot.Attenuation(10.f), lariov::IOVDataError);
+} // BOOST_AUTO_TEST_CASE(ErrorTest)
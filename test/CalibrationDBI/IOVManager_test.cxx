@@ -0,0 +1,208 @@
+/**
+ * @file   IOVManager_test.cxx
+ * @brief  Test of the time stamp range of IOVManager
+ * @date   October 19th, 2026
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE (iov_manager_test)
+#include "boost/test/unit_test.hpp"
+
+// LArSoft libraries
+#include "larevt/CalibrationDBI/IOVData/IOVTimeStamp.h"
+#include "larevt/CalibrationDBI/Providers/DatabaseRetrievalAlg.h"
+#include "larevt/CalibrationDBI/Providers/IOVManager.h"
+
+// C/C++ standard library
+#include <atomic>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using lariov::DBTimeStamp_t;
+using lariov::IOVManager;
+using lariov::IOVTimeStamp;
+
+namespace {
+
+  /// Provider with fixed intervals of validity, [ boundaries[i], boundaries[i+1] )
+  class FakeProvider : public lariov::DatabaseRetrievalAlg {
+  public:
+    explicit FakeProvider(std::vector<unsigned long> boundaries)
+      : lariov::DatabaseRetrievalAlg("fake", "")
+      , fBoundaries(std::move(boundaries))
+    {}
+
+    IOVRange_t SelectTimeStamp(DBTimeStamp_t ts) override
+    {
+      ++fNSelected;
+      if (ts == fFailAt) throw std::runtime_error("failed to load");
+      for (std::size_t i = 1; i < fBoundaries.size(); ++i) {
+        if (ts < fBoundaries[i])
+          return {IOVTimeStamp(fBoundaries[i - 1]), IOVTimeStamp(fBoundaries[i])};
+      }
+      return {IOVTimeStamp(fBoundaries.back()), IOVTimeStamp::MaxTimeStamp()};
+    }
+
+    unsigned int NSelected() const { return fNSelected; }
+    void FailAt(DBTimeStamp_t ts) { fFailAt = ts; }
+
+  private:
+    std::vector<unsigned long> fBoundaries;
+    std::atomic<unsigned int> fNSelected{0};
+    DBTimeStamp_t fFailAt = 0;
+  };
+
+} // local namespace
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(EmptyRangeTest)
+{
+  IOVManager manager;
+  FakeProvider provider({1, 100, 200});
+
+  // nothing is in range before the first update, not even 0
+  BOOST_TEST(!manager.InRange(0));
+  BOOST_TEST(!manager.InRange(1));
+  BOOST_TEST(!manager.InRange(std::numeric_limits<DBTimeStamp_t>::max()));
+
+  manager.Register(provider, "fake");
+  BOOST_TEST(manager.NProviders() == 1U);
+  BOOST_TEST(manager.Update(150));
+  BOOST_TEST(provider.NSelected() == 1U);
+
+  // registering another provider empties the range again
+  FakeProvider other({1, 120});
+  manager.Register(other, "other");
+  BOOST_TEST(!manager.InRange(150));
+  BOOST_TEST(manager.Update(150));
+  BOOST_TEST(manager.RangeBegin() == 120U);
+  BOOST_TEST(manager.RangeEnd() == 200U);
+} // BOOST_AUTO_TEST_CASE(EmptyRangeTest)
+
+//------------------------------------------------------------------------------
+// The range check is `ts - begin < width` on unsigned values: the begin is in
+// the range, the end is not, and time stamps before the begin wrap around.
+BOOST_AUTO_TEST_CASE(BoundaryTest)
+{
+  IOVManager manager;
+  FakeProvider provider({1, 100, 200, 300});
+  manager.Register(provider, "fake");
+
+  BOOST_TEST(manager.Update(150));
+  BOOST_TEST(manager.RangeBegin() == 100U);
+  BOOST_TEST(manager.RangeEnd() == 200U);
+
+  BOOST_TEST(manager.InRange(100));
+  BOOST_TEST(manager.InRange(199));
+  BOOST_TEST(!manager.InRange(99));
+  BOOST_TEST(!manager.InRange(200));
+  BOOST_TEST(!manager.InRange(0));
+  BOOST_TEST(!manager.InRange(std::numeric_limits<DBTimeStamp_t>::max()));
+
+  // updates within the range do not move the provider
+  BOOST_TEST(!manager.Update(100));
+  BOOST_TEST(!manager.Update(199));
+  BOOST_TEST(provider.NSelected() == 1U);
+  BOOST_TEST(manager.NRefreshes() == 1U);
+
+  // the end of a range is the begin of the next one
+  BOOST_TEST(manager.Update(200));
+  BOOST_TEST(manager.RangeBegin() == 200U);
+  BOOST_TEST(manager.RangeEnd() == 300U);
+  BOOST_TEST(!manager.InRange(199));
+
+  // going back in time
+  BOOST_TEST(manager.Update(99));
+  BOOST_TEST(manager.RangeBegin() == 1U);
+  BOOST_TEST(manager.RangeEnd() == 100U);
+  BOOST_TEST(provider.NSelected() == 3U);
+} // BOOST_AUTO_TEST_CASE(BoundaryTest)
+
+//------------------------------------------------------------------------------
+// The last interval never ends: its end is the largest time stamp, excluded.
+BOOST_AUTO_TEST_CASE(OpenEndedTest)
+{
+  IOVManager manager;
+  FakeProvider provider({1, 100});
+  manager.Register(provider, "fake");
+
+  DBTimeStamp_t const ns = 1600000000000000000ULL;
+  BOOST_TEST(manager.Update(ns));
+  BOOST_TEST(manager.RangeBegin() == 100U);
+  BOOST_TEST(manager.RangeEnd() == std::numeric_limits<DBTimeStamp_t>::max());
+  BOOST_TEST(manager.InRange(100));
+  BOOST_TEST(manager.InRange(std::numeric_limits<DBTimeStamp_t>::max() - 1));
+  BOOST_TEST(!manager.InRange(std::numeric_limits<DBTimeStamp_t>::max()));
+  BOOST_TEST(!manager.InRange(99));
+} // BOOST_AUTO_TEST_CASE(OpenEndedTest)
+
+//------------------------------------------------------------------------------
+// The range is the intersection of the intervals of all the providers.
+BOOST_AUTO_TEST_CASE(IntersectionTest)
+{
+  for (bool const parallel : {false, true}) {
+    IOVManager manager;
+    manager.SetParallel(parallel);
+    FakeProvider a({1, 100, 200});
+    FakeProvider b({1, 50, 150, 400});
+    FakeProvider c({1, 120});
+    manager.Register(a, "a");
+    manager.Register(b, "b");
+    manager.Register(c, "c");
+
+    BOOST_TEST(manager.Update(130));
+    BOOST_TEST(manager.RangeBegin() == 120U);
+    BOOST_TEST(manager.RangeEnd() == 150U);
+    BOOST_TEST(!manager.InRange(119));
+    BOOST_TEST(manager.InRange(149));
+    BOOST_TEST(!manager.InRange(150));
+    BOOST_TEST(a.NSelected() == 1U);
+    BOOST_TEST(b.NSelected() == 1U);
+    BOOST_TEST(c.NSelected() == 1U);
+  }
+} // BOOST_AUTO_TEST_CASE(IntersectionTest)
+
+//------------------------------------------------------------------------------
+// A provider failing to load leaves the range empty, after all the others ran.
+BOOST_AUTO_TEST_CASE(FailureTest)
+{
+  for (bool const parallel : {false, true}) {
+    IOVManager manager;
+    manager.SetParallel(parallel);
+    FakeProvider a({1, 100});
+    FakeProvider b({1, 100});
+    b.FailAt(150);
+    manager.Register(a, "a");
+    manager.Register(b, "b");
+
+    BOOST_CHECK_THROW(manager.Update(150), std::runtime_error);
+    BOOST_TEST(a.NSelected() == 1U);
+    BOOST_TEST(!manager.InRange(150));
+    BOOST_TEST(manager.Update(160));
+    BOOST_TEST(manager.InRange(150));
+  }
+} // BOOST_AUTO_TEST_CASE(FailureTest)
+
+//------------------------------------------------------------------------------
+// Threads updating to time stamps of the same interval move the providers once.
+BOOST_AUTO_TEST_CASE(ConcurrentUpdateTest)
+{
+  IOVManager manager;
+  FakeProvider provider({1, 100, 200});
+  manager.Register(provider, "fake");
+
+  std::vector<std::thread> threads;
+  for (unsigned int t = 0; t != 8; ++t)
+    threads.emplace_back([&manager, t]() {
+      for (DBTimeStamp_t ts = 100 + t; ts < 200; ts += 8)
+        manager.Update(ts);
+    });
+  for (std::thread& thread : threads)
+    thread.join();
+
+  BOOST_TEST(provider.NSelected() == 1U);
+  BOOST_TEST(manager.NRefreshes() == 1U);
+} // BOOST_AUTO_TEST_CASE(ConcurrentUpdateTest)
@@ -0,0 +1,161 @@
+/**
+ * @file   NoisyChannelOverlay_test.cxx
+ * @brief  Test of NoisyChannelOverlay
+ * @date   October 19th, 2026
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE (noisy_channel_overlay_test)
+#include "boost/test/unit_test.hpp"
+
+// LArSoft libraries
+#include "larevt/CalibrationDBI/Providers/NoisyChannelOverlay.h"
+
+// C/C++ standard library
+#include <algorithm>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+using lariov::DBChannelID_t;
+using lariov::NoisyChannelOverlay;
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(AddAndClearTest)
+{
+  NoisyChannelOverlay overlay;
+  BOOST_TEST(overlay.Size() == 0U);
+  BOOST_TEST(!overlay.Add(0));
+
+  overlay.Resize(130);
+  BOOST_TEST(overlay.Size() == 130U);
+  BOOST_TEST(overlay.Empty());
+
+  BOOST_TEST(overlay.Add(129));
+  BOOST_TEST(overlay.Add(3));
+  BOOST_TEST(overlay.Add(64));
+  BOOST_TEST(overlay.Add(3)); // twice in the same word
+  BOOST_TEST(overlay.Add(5));
+  BOOST_TEST(!overlay.Add(130)); // out of range
+
+  BOOST_TEST(!overlay.Empty());
+  BOOST_TEST(overlay.Test(3));
+  BOOST_TEST(overlay.Test(129));
+  BOOST_TEST(!overlay.Test(4));
+  BOOST_TEST(!overlay.Test(130));
+  BOOST_TEST(overlay.Channels() == std::vector<DBChannelID_t>({3, 5, 64, 129}),
+             boost::test_tools::per_element());
+
+  overlay.Clear();
+  BOOST_TEST(overlay.Empty());
+  BOOST_TEST(!overlay.Test(3));
+  BOOST_TEST(!overlay.Test(129));
+  BOOST_TEST(overlay.Channels().empty());
+
+  // the overlay is usable again after Clear()
+  BOOST_TEST(overlay.Add(64));
+  BOOST_TEST(overlay.Channels() == std::vector<DBChannelID_t>({64}),
+             boost::test_tools::per_element());
+} // BOOST_AUTO_TEST_CASE(AddAndClearTest)
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(ResizeTest)
+{
+  NoisyChannelOverlay overlay;
+  overlay.Resize(64);
+  BOOST_TEST(overlay.Add(63));
+  BOOST_TEST(!overlay.Add(64));
+
+  overlay.Resize(65);
+  BOOST_TEST(overlay.Empty());
+  BOOST_TEST(!overlay.Test(63));
+  BOOST_TEST(overlay.Add(64));
+  BOOST_TEST(overlay.Channels() == std::vector<DBChannelID_t>({64}),
+             boost::test_tools::per_element());
+} // BOOST_AUTO_TEST_CASE(ResizeTest)
+
+//------------------------------------------------------------------------------
+// Threads flag interleaved channels, so that they share all the words.
+BOOST_AUTO_TEST_CASE(ConcurrentAddTest)
+{
+  constexpr unsigned int nThreads = 4;
+  constexpr DBChannelID_t nChannels = 4096;
+
+  NoisyChannelOverlay overlay;
+  overlay.Resize(nChannels);
+
+  std::vector<std::thread> threads;
+  for (unsigned int t = 0; t != nThreads; ++t) {
+    threads.emplace_back([&overlay, t]() {
+      for (DBChannelID_t ch = t; ch < nChannels; ch += nThreads)
+        overlay.Add(ch);
+    });
+  }
+  for (std::thread& thread : threads)
+    thread.join();
+
+  std::vector<DBChannelID_t> const channels = overlay.Channels();
+  BOOST_TEST(channels.size() == nChannels);
+  for (DBChannelID_t ch = 0; ch != nChannels; ++ch)
+    BOOST_TEST(overlay.Test(ch));
+
+  // Clear() resets every word, whichever thread recorded it
+  overlay.Clear();
+  BOOST_TEST(overlay.Empty());
+  BOOST_TEST(overlay.Channels().empty());
+  for (DBChannelID_t ch = 0; ch != nChannels; ++ch)
+    BOOST_TEST(!overlay.Test(ch));
+} // BOOST_AUTO_TEST_CASE(ConcurrentAddTest)
+
+//------------------------------------------------------------------------------
+// The same overlay applies to the snapshot views and to the default ones, where
+// either all or none of the channels have the status.
+BOOST_AUTO_TEST_CASE(ApplyTest)
+{
+  constexpr DBChannelID_t nChannels = 70;
+
+  NoisyChannelOverlay overlay;
+  overlay.Resize(nChannels);
+  overlay.Add(2);
+  overlay.Add(65);
+
+  std::vector<DBChannelID_t> all(nChannels);
+  std::iota(all.begin(), all.end(), DBChannelID_t(0));
+  std::vector<DBChannelID_t> const none;
+  std::vector<DBChannelID_t> const some{1, 2, 3};
+
+  // channel lists
+  BOOST_TEST(overlay.Apply(none.data(), none.data(), true) == std::vector<DBChannelID_t>({2, 65}),
+             boost::test_tools::per_element());
+  BOOST_TEST(overlay.Apply(none.data(), none.data(), false).empty());
+  BOOST_TEST(overlay.Apply(some.data(), some.data() + some.size(), true) ==
+               std::vector<DBChannelID_t>({1, 2, 3, 65}),
+             boost::test_tools::per_element());
+  std::vector<DBChannelID_t> const good = overlay.Apply(all.data(), all.data() + all.size(), false);
+  BOOST_TEST(good.size() == nChannels - 2U);
+  BOOST_TEST(std::count(good.begin(), good.end(), 2U) == 0);
+  BOOST_TEST(std::count(good.begin(), good.end(), 65U) == 0);
+
+  // channel masks
+  using word_t = NoisyChannelOverlay::word_t;
+  std::vector<word_t> words(2, 0);
+  overlay.Apply(words, nChannels, true);
+  BOOST_TEST(words[0] == word_t(1) << 2);
+  BOOST_TEST(words[1] == word_t(1) << 1);
+  words.assign(2, ~word_t(0));
+  overlay.Apply(words, nChannels, false);
+  BOOST_TEST(words[0] == ~(word_t(1) << 2));
+  BOOST_TEST(words[1] == ~(word_t(1) << 1));
+  words.assign(2, 0);
+  overlay.Apply(words, 64, true); // channel 65 is past the mask
+  BOOST_TEST(words[1] == 0U);
+
+  // batch query results, on channels in any order
+  std::vector<DBChannelID_t> const channels{65, 0, 2, 3};
+  word_t result = 0;
+  overlay.Apply(channels.data(), channels.size(), true, &result);
+  BOOST_TEST(result == 0x5U);
+  result = 0xF;
+  overlay.Apply(channels.data(), channels.size(), false, &result);
+  BOOST_TEST(result == 0xAU);
+} // BOOST_AUTO_TEST_CASE(ApplyTest)
@@ -0,0 +1,185 @@
+/**
+ * @file   ProviderSnapshot_test.cxx
+ * @brief  Test of the row lookups of UniformSnapshot and ProviderSnapshot
+ * @date   October 19th, 2026
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE (provider_snapshot_test)
+#include "boost/test/unit_test.hpp"
+
+// LArSoft libraries
+#include "larevt/CalibrationDBI/IOVData/DenseSnapshot.h"
+#include "larevt/CalibrationDBI/IOVData/DetPedestal.h"
+#include "larevt/CalibrationDBI/IOVData/ElectronicsCalib.h"
+#include "larevt/CalibrationDBI/IOVData/IOVDataError.h"
+#include "larevt/CalibrationDBI/IOVData/IOVTimeStamp.h"
+#include "larevt/CalibrationDBI/IOVData/ProviderSnapshot.h"
+#include "larevt/CalibrationDBI/IOVData/Snapshot.h"
+#include "larevt/CalibrationDBI/IOVData/UniformSnapshot.h"
+
+// C/C++ standard library
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+using lariov::DetPedestal;
+using lariov::IOVTimeStamp;
+
+namespace {
+
+  using Uniform_t = lariov::UniformSnapshot<DetPedestal>;
+  using Dense_t = lariov::DenseSnapshot<DetPedestal>;
+
+  DetPedestal Pedestal(unsigned int ch, float mean)
+  {
+    DetPedestal pd(ch);
+    pd.SetPedMean(mean);
+    pd.SetPedRms(mean / 100.f);
+    pd.SetPedMeanErr(0.f);
+    pd.SetPedRmsErr(0.f);
+    return pd;
+  }
+
+  /// Channels of the rows visited by ForEachRow()
+  template <class S>
+  std::vector<unsigned int> VisitedChannels(S const& snapshot)
+  {
+    std::vector<unsigned int> channels;
+    snapshot.ForEachRow([&channels](auto const& row) { channels.push_back(row.Channel()); });
+    return channels;
+  }
+
+} // local namespace
+
+//------------------------------------------------------------------------------
+// A single record for all the channels below the limit.
+BOOST_AUTO_TEST_CASE(UniformAllChannelsTest)
+{
+  Uniform_t uniform;
+  BOOST_CHECK_THROW(uniform.SetAllChannels(100), lariov::IOVDataError);
+
+  BOOST_TEST(uniform.AddRecord(Pedestal(0, 400.f)) == 0U);
+  uniform.SetAllChannels(100);
+  BOOST_TEST(uniform.NChannels() == 100U);
+  BOOST_TEST(uniform.ChannelLimit() == 100U);
+
+  BOOST_TEST(uniform.HasChannel(0));
+  BOOST_TEST(uniform.HasChannel(99));
+  BOOST_TEST(!uniform.HasChannel(100));
+
+  // each row is a copy of the record, with the requested channel
+  DetPedestal const row = uniform.GetRow(42);
+  BOOST_TEST(row.Channel() == 42U);
+  BOOST_TEST(row.PedMean() == 400.f);
+  BOOST_TEST(uniform.GetRow(99).Channel() == 99U);
+  BOOST_CHECK_THROW(uniform.GetRow(100), lariov::IOVDataError);
+} // BOOST_AUTO_TEST_CASE(UniformAllChannelsTest)
+
+//------------------------------------------------------------------------------
+// Records chosen per channel, after a uniform start.
+BOOST_AUTO_TEST_CASE(UniformChannelTableTest)
+{
+  Uniform_t uniform;
+  std::uint8_t const induction = uniform.AddRecord(Pedestal(0, 2048.f));
+  std::uint8_t const collection = uniform.AddRecord(Pedestal(0, 400.f));
+  uniform.SetAllChannels(4);
+
+  uniform.SetChannelRecord(2, collection);
+  uniform.SetChannelRecord(10, collection);
+  BOOST_CHECK_THROW(uniform.SetChannelRecord(11, 2), lariov::IOVDataError);
+
+  BOOST_TEST(uniform.NChannels() == 5U);
+  BOOST_TEST(uniform.ChannelLimit() == 11U);
+  BOOST_TEST(!uniform.HasChannel(4));
+  BOOST_TEST(!uniform.HasChannel(9));
+  BOOST_TEST(!uniform.HasChannel(11));
+  BOOST_CHECK_THROW(uniform.GetRow(5), lariov::IOVDataError);
+
+  BOOST_TEST(uniform.GetRow(1).PedMean() == 2048.f);
+  BOOST_TEST(uniform.GetRow(1).Channel() == 1U);
+  BOOST_TEST(uniform.GetRow(2).PedMean() == 400.f);
+  BOOST_TEST(uniform.GetRow(2).Channel() == 2U);
+  BOOST_TEST(uniform.GetRow(10).PedMean() == 400.f);
+  BOOST_TEST(uniform.GetRow(10).Channel() == 10U);
+
+  // a channel record may be replaced
+  uniform.SetChannelRecord(10, induction);
+  BOOST_TEST(uniform.NChannels() == 5U);
+  BOOST_TEST(uniform.GetRow(10).PedMean() == 2048.f);
+} // BOOST_AUTO_TEST_CASE(UniformChannelTableTest)
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(ProviderDenseRowsTest)
+{
+  Dense_t rows;
+  rows.SetIoV(IOVTimeStamp(100), IOVTimeStamp(200));
+  rows.AddOrReplaceRow(Pedestal(5, 410.f));
+  rows.AddOrReplaceRow(Pedestal(3, 420.f));
+
+  lariov::ProviderSnapshot<Dense_t> const snapshot(std::move(rows));
+  BOOST_TEST(!snapshot.IsUniform());
+  BOOST_TEST(!snapshot.Uniform());
+  BOOST_TEST((snapshot.Start() == IOVTimeStamp(100)));
+  BOOST_TEST((snapshot.End() == IOVTimeStamp(200)));
+  BOOST_TEST(snapshot.NChannels() == 2U);
+  BOOST_TEST(snapshot.ChannelLimit() == 6U);
+
+  BOOST_TEST(snapshot.HasChannel(3));
+  BOOST_TEST(!snapshot.HasChannel(4));
+  BOOST_TEST(snapshot.GetRow(5).Channel() == 5U);
+  BOOST_TEST(snapshot.GetRow(5).PedMean() == 410.f);
+  BOOST_TEST(snapshot.GetRow(3).PedMean() == 420.f);
+  BOOST_CHECK_THROW(snapshot.GetRow(4), lariov::IOVDataError);
+
+  BOOST_TEST(VisitedChannels(snapshot) == std::vector<unsigned int>({3, 5}),
+             boost::test_tools::per_element());
+} // BOOST_AUTO_TEST_CASE(ProviderDenseRowsTest)
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(ProviderSparseRowsTest)
+{
+  lariov::Snapshot<lariov::ElectronicsCalib> rows;
+  rows.SetIoV(IOVTimeStamp(100), IOVTimeStamp(200));
+  for (unsigned int ch : {70000U, 8U}) {
+    lariov::ElectronicsCalib calib(ch);
+    calib.SetGain(ch + 0.5f);
+    rows.AddOrReplaceRow(calib);
+  }
+
+  lariov::ProviderSnapshot<lariov::Snapshot<lariov::ElectronicsCalib>> const snapshot(
+    std::move(rows));
+  BOOST_TEST(snapshot.NChannels() == 2U);
+  BOOST_TEST(snapshot.ChannelLimit() == 70001U);
+  BOOST_TEST(snapshot.GetRow(70000).Channel() == 70000U);
+  BOOST_TEST(snapshot.GetRow(70000).Gain() == 70000.5f);
+  BOOST_TEST(snapshot.GetRow(8).Gain() == 8.5f);
+  BOOST_CHECK_THROW(snapshot.GetRow(9), lariov::IOVDataError);
+  BOOST_TEST(VisitedChannels(snapshot) == std::vector<unsigned int>({8, 70000}),
+             boost::test_tools::per_element());
+} // BOOST_AUTO_TEST_CASE(ProviderSparseRowsTest)
+
+//------------------------------------------------------------------------------
+// Uniform data keep their constant size, and rows still get their channel.
+BOOST_AUTO_TEST_CASE(ProviderUniformTest)
+{
+  auto uniform = std::make_shared<Uniform_t>();
+  uniform->SetIoV(IOVTimeStamp(300), IOVTimeStamp::MaxTimeStamp());
+  uniform->AddRecord(Pedestal(0, 2048.f));
+  uniform->SetAllChannels(3);
+
+  lariov::ProviderSnapshot<Dense_t> const snapshot(uniform);
+  BOOST_TEST(snapshot.IsUniform());
+  BOOST_TEST(snapshot.Uniform() == uniform.get());
+  BOOST_TEST(snapshot.Rows().NChannels() == 0U);
+  BOOST_TEST((snapshot.Start() == IOVTimeStamp(300)));
+  BOOST_TEST((snapshot.End() == IOVTimeStamp::MaxTimeStamp()));
+  BOOST_TEST(snapshot.NChannels() == 3U);
+  BOOST_TEST(snapshot.ChannelLimit() == 3U);
+
+  BOOST_TEST(snapshot.GetRow(2).Channel() == 2U);
+  BOOST_TEST(snapshot.GetRow(2).PedMean() == 2048.f);
+  BOOST_CHECK_THROW(snapshot.GetRow(3), lariov::IOVDataError);
+  BOOST_TEST(VisitedChannels(snapshot) == std::vector<unsigned int>({0, 1, 2}),
+             boost::test_tools::per_element());
+} // BOOST_AUTO_TEST_CASE(ProviderUniformTest)
@@ -0,0 +1,159 @@
+/**
+ * @file   SIOVColumns_test.cxx
+ * @brief  Test of SIOVColumns and FindSIOVColumn()
+ * @date   October 19th, 2026
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE (siov_columns_test)
+#include "boost/test/unit_test.hpp"
+
+// LArSoft libraries
+#include "larevt/CalibrationDBI/IOVData/ChData.h"
+#include "larevt/CalibrationDBI/IOVData/IOVTimeStamp.h"
+#include "larevt/CalibrationDBI/IOVData/Snapshot.h"
+#include "larevt/CalibrationDBI/IOVData/SnapshotBuilder.h"
+#include "larevt/CalibrationDBI/Providers/DBDataset.h"
+#include "larevt/CalibrationDBI/Providers/SIOVColumns.h"
+#include "larevt/CalibrationDBI/Providers/WebError.h"
+
+// C/C++ standard library
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+  enum class Quality { Bad, Good };
+
+  struct Record : lariov::ChData {
+    Record() : lariov::ChData(0) {}
+
+    void SetGain(float gain) { fGain = gain; }
+    void SetQuality(Quality quality) { fQuality = quality; }
+    void SetLabel(std::string const& label) { fLabel = label; }
+
+    float fGain = 0.f;
+    Quality fQuality = Quality::Bad;
+    std::string fLabel;
+    long fRaw = -1;
+  };
+
+  void SetRaw(Record& record, long raw)
+  {
+    record.fRaw = raw;
+  }
+
+  using Columns_t = lariov::SIOVColumns<Record,
+                                        lariov::SIOVField<&Record::SetGain>,
+                                        lariov::SIOVField<&Record::SetQuality>,
+                                        lariov::SIOVField<&Record::SetLabel>,
+                                        lariov::SIOVField<&SetRaw>>;
+
+  static_assert(lariov::SIOVField<&Record::SetGain>::Kind == lariov::SIOVColumnKind::Real);
+  static_assert(lariov::SIOVField<&Record::SetQuality>::Kind == lariov::SIOVColumnKind::Integer);
+  static_assert(lariov::SIOVField<&Record::SetLabel>::Kind == lariov::SIOVColumnKind::Text);
+  static_assert(lariov::SIOVField<&SetRaw>::Kind == lariov::SIOVColumnKind::Integer);
+
+  lariov::DBDataset::value_type Text(const char* text)
+  {
+    return std::make_unique<std::string>(text);
+  }
+
+  /// Dataset with columns channel, gain (real), quality (boolean), label (text), raw (bigint)
+  lariov::DBDataset MakeDataset(std::vector<lariov::DBChannelID_t> channels)
+  {
+    std::vector<lariov::DBDataset::value_type> data;
+    for (lariov::DBChannelID_t const ch : channels) {
+      data.emplace_back(long(ch));
+      if (ch % 2)
+        data.emplace_back(long(ch)); // real columns may hold integers
+      else
+        data.emplace_back(ch + 0.5);
+      data.emplace_back(long(ch % 3 == 0));
+      data.emplace_back(Text(("ch" + std::to_string(ch)).c_str()));
+      data.emplace_back(long(ch) * 1000000000L);
+    }
+    return lariov::DBDataset(lariov::IOVTimeStamp(1, 0),
+                             lariov::IOVTimeStamp(2, 0),
+                             {"channel", "gain", "quality", "label", "raw"},
+                             {"integer", "real", "boolean", "text", "bigint"},
+                             std::move(channels),
+                             std::move(data));
+  }
+
+} // local namespace
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(FindColumnTest)
+{
+  lariov::DBDataset const data = MakeDataset({0});
+  using lariov::FindSIOVColumn;
+  using lariov::SIOVColumnKind;
+
+  BOOST_TEST(FindSIOVColumn(data, "gain", SIOVColumnKind::Real) == 1U);
+  BOOST_TEST(FindSIOVColumn(data, "quality", SIOVColumnKind::Integer) == 2U);
+  BOOST_TEST(FindSIOVColumn(data, "label", SIOVColumnKind::Text) == 3U);
+  BOOST_TEST(FindSIOVColumn(data, "raw", SIOVColumnKind::Integer) == 4U);
+
+  // integer columns may be read as real, not the other way around
+  BOOST_TEST(FindSIOVColumn(data, "raw", SIOVColumnKind::Real) == 4U);
+  BOOST_CHECK_THROW(FindSIOVColumn(data, "gain", SIOVColumnKind::Integer), lariov::WebError);
+  BOOST_CHECK_THROW(FindSIOVColumn(data, "label", SIOVColumnKind::Real), lariov::WebError);
+  BOOST_CHECK_THROW(FindSIOVColumn(data, "raw", SIOVColumnKind::Text), lariov::WebError);
+
+  BOOST_CHECK_THROW(FindSIOVColumn(data, "pedestal", SIOVColumnKind::Real), lariov::WebError);
+} // BOOST_AUTO_TEST_CASE(FindColumnTest)
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(DecodeTest)
+{
+  Columns_t const columns({"gain", "quality", "label", "raw"});
+
+  Record prototype;
+  prototype.fLabel = "prototype";
+
+  lariov::SnapshotBuilder<lariov::Snapshot<Record>> rows;
+  columns.Decode(MakeDataset({3, 4, 7}), prototype, rows);
+  BOOST_TEST(rows.Size() == 3U);
+
+  lariov::Snapshot<Record> snapshot;
+  rows.Fill(snapshot);
+  auto const& records = snapshot.Data();
+  BOOST_TEST_REQUIRE(records.size() == 3U);
+
+  BOOST_TEST(records[0].Channel() == 3U);
+  BOOST_TEST(records[0].fGain == 3.f);
+  BOOST_TEST((records[0].fQuality == Quality::Good));
+  BOOST_TEST(records[0].fLabel == "ch3");
+  BOOST_TEST(records[0].fRaw == 3000000000L);
+
+  BOOST_TEST(records[1].Channel() == 4U);
+  BOOST_TEST(records[1].fGain == 4.5f);
+  BOOST_TEST((records[1].fQuality == Quality::Bad));
+  BOOST_TEST(records[1].fLabel == "ch4");
+
+  BOOST_TEST(records[2].Channel() == 7U);
+  BOOST_TEST(records[2].fRaw == 7000000000L);
+} // BOOST_AUTO_TEST_CASE(DecodeTest)
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(DecodeErrorTest)
+{
+  lariov::SnapshotBuilder<lariov::Snapshot<Record>> rows;
+
+  // missing column
+  BOOST_CHECK_THROW(Columns_t({"gain", "quality", "label", "pedestal"})
+                      .Decode(MakeDataset({1}), Record(), rows),
+                    lariov::WebError);
+
+  // text in a real column
+  BOOST_CHECK_THROW(Columns_t({"label", "quality", "label", "raw"})
+                      .Decode(MakeDataset({1}), Record(), rows),
+                    lariov::WebError);
+
+  // a dataset with no rows is not checked at all
+  Columns_t({"a", "b", "c", "d"}).Decode(lariov::DBDataset(), Record(), rows);
+  BOOST_TEST(rows.Size() == 0U);
+} // BOOST_AUTO_TEST_CASE(DecodeErrorTest)
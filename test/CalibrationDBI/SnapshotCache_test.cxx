@@ -0,0 +1,109 @@
+/**
+ * @file   SnapshotCache_test.cxx
+ * @brief  Test of the lookups and evictions of SnapshotCache
+ * @date   October 19th, 2026
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE (snapshot_cache_test)
+#include "boost/test/unit_test.hpp"
+
+// LArSoft libraries
+#include "larevt/CalibrationDBI/IOVData/IOVTimeStamp.h"
+#include "larevt/CalibrationDBI/IOVData/SnapshotCache.h"
+
+// C/C++ standard library
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using lariov::DBTimeStamp_t;
+using lariov::IOVTimeStamp;
+
+namespace {
+
+  /// Snapshot valid for [ 100 k, 100 (k + 1) ) seconds
+  class Interval {
+  public:
+    explicit Interval(DBTimeStamp_t k) : fStart(100 * k), fEnd(100 * (k + 1)) {}
+    IOVTimeStamp const& Start() const { return fStart; }
+    IOVTimeStamp const& End() const { return fEnd; }
+
+  private:
+    IOVTimeStamp fStart;
+    IOVTimeStamp fEnd;
+  };
+
+  using Cache_t = lariov::SnapshotCache<Interval>;
+
+  Cache_t::const_pointer Build(DBTimeStamp_t ts) { return std::make_shared<Interval>(ts / 100); }
+
+} // local namespace
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(LookupTest)
+{
+  Cache_t cache(2);
+  BOOST_TEST(cache.Size() == 0U);
+  BOOST_TEST(!cache.Find(150));
+
+  auto const first = Build(150);
+  cache.Insert(first);
+  BOOST_TEST(cache.Find(100) == first);
+  BOOST_TEST(cache.Find(199) == first);
+  BOOST_TEST(!cache.Find(200));
+  BOOST_TEST(!cache.Find(99));
+
+  unsigned int nBuilds = 0;
+  auto const counted = [&nBuilds](DBTimeStamp_t ts) {
+    ++nBuilds;
+    return Build(ts);
+  };
+  auto const second = cache.FindOrBuild(250, counted);
+  BOOST_TEST(nBuilds == 1U);
+  BOOST_TEST(cache.FindOrBuild(299, counted) == second);
+  BOOST_TEST(cache.FindOrBuild(120, counted) == first);
+  BOOST_TEST(nBuilds == 1U);
+  BOOST_TEST(cache.Size() == 2U);
+
+  // the oldest snapshot is evicted, but stays alive while held
+  auto const third = cache.FindOrBuild(350, counted);
+  BOOST_TEST(nBuilds == 2U);
+  BOOST_TEST(cache.Size() == 2U);
+  BOOST_TEST(!cache.Find(150));
+  BOOST_TEST(cache.Find(250) == second);
+  BOOST_TEST(first->Start().Stamp() == 100U);
+
+  cache.Clear();
+  BOOST_TEST(cache.Size() == 0U);
+  BOOST_TEST(!cache.Find(350));
+  BOOST_TEST(third.use_count() == 1);
+} // BOOST_AUTO_TEST_CASE(LookupTest)
+
+//------------------------------------------------------------------------------
+// Lookups run while other threads keep replacing the table: each returns the
+// snapshot covering its own time stamp.
+BOOST_AUTO_TEST_CASE(ConcurrentLookupTest)
+{
+  constexpr unsigned int nThreads = 4;
+  constexpr DBTimeStamp_t nIntervals = 6;
+
+  Cache_t cache(2);
+  std::atomic<unsigned int> nWrong{0};
+  std::vector<std::thread> threads;
+  for (unsigned int t = 0; t != nThreads; ++t) {
+    threads.emplace_back([&cache, &nWrong, t]() {
+      for (unsigned int i = 0; i != 20000; ++i) {
+        DBTimeStamp_t const ts = 100 + (i * 37 + t * 101) % (100 * nIntervals);
+        auto const snapshot = (i % 16 == t) ? cache.FindOrBuild(ts, Build) : cache.Find(ts);
+        if (snapshot && snapshot->Start().Stamp() != ts / 100 * 100) ++nWrong;
+      }
+    });
+  }
+  for (std::thread& thread : threads)
+    thread.join();
+
+  BOOST_TEST(nWrong == 0U);
+  BOOST_TEST(cache.Size() == 2U);
+} // BOOST_AUTO_TEST_CASE(ConcurrentLookupTest)
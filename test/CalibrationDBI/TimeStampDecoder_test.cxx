@@ -0,0 +1,96 @@
+/**
+ * @file   TimeStampDecoder_test.cxx
+ * @brief  Test of TimeStampDecoder::FirstTimeStampFrom()
+ * @date   October 19th, 2026
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE (time_stamp_decoder_test)
+#include "boost/test/unit_test.hpp"
+
+// LArSoft libraries
+#include "larevt/CalibrationDBI/IOVData/IOVTimeStamp.h"
+#include "larevt/CalibrationDBI/IOVData/TimeStampDecoder.h"
+
+// C/C++ standard library
+#include <limits>
+
+using lariov::DBTimeStamp_t;
+using lariov::IOVTimeStamp;
+using lariov::TimeStampDecoder;
+
+namespace {
+
+  DBTimeStamp_t const firstNs = 1000000000000000000ULL; // The first 19-digit value.
+
+  /// Returns whether DecodeTimeStamp() accepts ts
+  bool Decodable(DBTimeStamp_t ts)
+  {
+    return (ts > 0 && ts < 100000) || ts >= firstNs;
+  }
+
+  /// Checks that ts is the first time stamp decoding to iov or later
+  void CheckFirst(IOVTimeStamp const& iov, DBTimeStamp_t ts)
+  {
+    BOOST_TEST_CONTEXT("IOV time " << iov.DBStamp())
+    {
+      BOOST_TEST(TimeStampDecoder::FirstTimeStampFrom(iov) == ts);
+      BOOST_TEST((TimeStampDecoder::DecodeTimeStamp(ts) >= iov));
+      if (Decodable(ts - 1)) BOOST_TEST((TimeStampDecoder::DecodeTimeStamp(ts - 1) < iov));
+    }
+  }
+
+} // local namespace
+
+//------------------------------------------------------------------------------
+// Time stamps with fewer than 6 digits are seconds.
+BOOST_AUTO_TEST_CASE(ShortTimeStampTest)
+{
+  CheckFirst(IOVTimeStamp(1), 1);
+  CheckFirst(IOVTimeStamp(100), 100);
+  CheckFirst(IOVTimeStamp(99999), 99999);
+
+  // a sub-stamp moves to the next second
+  CheckFirst(IOVTimeStamp(100, 1), 101);
+  CheckFirst(IOVTimeStamp(99998, 999999), 99999);
+
+  // 0 is not a valid time stamp
+  BOOST_TEST(TimeStampDecoder::FirstTimeStampFrom(IOVTimeStamp(0)) == 1U);
+  BOOST_TEST(TimeStampDecoder::FirstTimeStampFrom(IOVTimeStamp(0, 5)) == 1U);
+} // BOOST_AUTO_TEST_CASE(ShortTimeStampTest)
+
+//------------------------------------------------------------------------------
+// Between the short time stamps and the nanoseconds from epoch, nothing decodes.
+BOOST_AUTO_TEST_CASE(GapTest)
+{
+  CheckFirst(IOVTimeStamp(99999, 1), firstNs);
+  CheckFirst(IOVTimeStamp(100000), firstNs);
+  CheckFirst(IOVTimeStamp(999999999, 999999), firstNs);
+  CheckFirst(IOVTimeStamp(1000000000), firstNs);
+  BOOST_TEST((TimeStampDecoder::DecodeTimeStamp(99999) < IOVTimeStamp(99999, 1)));
+} // BOOST_AUTO_TEST_CASE(GapTest)
+
+//------------------------------------------------------------------------------
+// Nanoseconds from epoch are truncated to microseconds.
+BOOST_AUTO_TEST_CASE(NanosecondTest)
+{
+  CheckFirst(IOVTimeStamp(1600000000), 1600000000000000000ULL);
+  CheckFirst(IOVTimeStamp(1600000000, 1), 1600000000000001000ULL);
+  CheckFirst(IOVTimeStamp(1600000000, 999999), 1600000000999999000ULL);
+
+  // all the nanoseconds of a microsecond decode to it
+  BOOST_TEST((TimeStampDecoder::DecodeTimeStamp(1600000000000001999ULL) ==
+              IOVTimeStamp(1600000000, 1)));
+} // BOOST_AUTO_TEST_CASE(NanosecondTest)
+
+//------------------------------------------------------------------------------
+// Times past the nanosecond range map to the largest value, as open ends do.
+BOOST_AUTO_TEST_CASE(MaxTimeStampTest)
+{
+  DBTimeStamp_t const max = std::numeric_limits<DBTimeStamp_t>::max();
+  BOOST_TEST(TimeStampDecoder::FirstTimeStampFrom(IOVTimeStamp(10000000000UL)) == max);
+  BOOST_TEST(TimeStampDecoder::FirstTimeStampFrom(IOVTimeStamp::MaxTimeStamp()) == max);
+
+  // the last second in range
+  CheckFirst(IOVTimeStamp(9999999999UL), 9999999999000000000ULL);
+} // BOOST_AUTO_TEST_CASE(MaxTimeStampTest)
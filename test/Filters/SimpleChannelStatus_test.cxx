@@ -33,6 +33,8 @@
 #include <memory> // std::unique_ptr<>
 #include <ostream>
 #include <set>
+#include <stdexcept> // std::logic_error
+#include <vector>
 
 namespace std {
 
@@ -192,6 +194,58 @@ void test_simple_status()
   BOOST_TEST(StatusGoodChannels.size() == GoodChannels.size());
   BOOST_TEST(StatusGoodChannels == GoodChannels);
 
+  // ChannelStatusBaseInterface bulk views
+  auto const GoodSpan = pStatus->GoodChannelSpan();
+  BOOST_TEST(std::set<raw::ChannelID_t>(GoodSpan.begin(), GoodSpan.end()) == GoodChannels);
+  BOOST_TEST(std::is_sorted(GoodSpan.begin(), GoodSpan.end()));
+
+  auto const BadSpan = pStatus->BadChannelSpan();
+  BOOST_TEST(std::set<raw::ChannelID_t>(BadSpan.begin(), BadSpan.end()) ==
+             statusCreator.fBadChannels);
+
+  auto const NoisySpan = pStatus->NoisyChannelSpan();
+  BOOST_TEST(std::set<raw::ChannelID_t>(NoisySpan.begin(), NoisySpan.end()) ==
+             statusCreator.fNoisyChannels);
+
+  auto const GoodMask = pStatus->GoodChannelMask();
+  auto const BadMask = pStatus->BadChannelMask();
+  auto const NoisyMask = pStatus->NoisyChannelMask();
+  BOOST_TEST(GoodMask.count() == GoodChannels.size());
+  for (raw::ChannelID_t channel = 0; channel <= statusCreator.fMaxChannel; ++channel) {
+    BOOST_TEST(GoodMask.test(channel) == (GoodChannels.count(channel) > 0));
+    BOOST_TEST(BadMask.test(channel) == (statusCreator.fBadChannels.count(channel) > 0));
+    BOOST_TEST(NoisyMask.test(channel) == (statusCreator.fNoisyChannels.count(channel) > 0));
+  } // for channel
+  BOOST_TEST(std::set<raw::ChannelID_t>(GoodMask.begin(), GoodMask.end()) == GoodChannels);
+
+  auto const GoodRanges = pStatus->GoodChannelRanges();
+  BOOST_TEST(GoodRanges.size() == GoodChannels.size());
+  BOOST_TEST(std::set<raw::ChannelID_t>(GoodRanges.begin(), GoodRanges.end()) == GoodChannels);
+  for (raw::ChannelID_t channel = 0; channel <= statusCreator.fMaxChannel; ++channel)
+    BOOST_TEST(GoodRanges.contains(channel) == (GoodChannels.count(channel) > 0));
+
+  // SimpleChannelStatus has no status values to list channels by
+  BOOST_CHECK_THROW(pStatus->ChannelsWithStatus(0), std::logic_error);
+
+  // ChannelStatusBaseInterface batch queries, on the channels in reverse order
+  using Provider_t = lariov::ChannelStatusProvider;
+  std::vector<raw::ChannelID_t> Channels;
+  for (raw::ChannelID_t channel = statusCreator.fMaxChannel + 1; channel-- > 0;)
+    Channels.push_back(channel);
+  std::vector<Provider_t::ResultWord_t> Present(Provider_t::ResultWords(Channels.size())),
+    Bad(Present.size()), Noisy(Present.size()), Good(Present.size());
+  pStatus->ArePresent(Channels.data(), Channels.size(), Present.data());
+  pStatus->AreBad(Channels.data(), Channels.size(), Bad.data());
+  pStatus->AreNoisy(Channels.data(), Channels.size(), Noisy.data());
+  pStatus->AreGood(Channels.data(), Channels.size(), Good.data());
+  for (std::size_t i = 0; i < Channels.size(); ++i) {
+    raw::ChannelID_t const channel = Channels[i];
+    BOOST_TEST(Provider_t::ResultBit(Present.data(), i) == pStatus->IsPresent(channel));
+    BOOST_TEST(Provider_t::ResultBit(Bad.data(), i) == pStatus->IsBad(channel));
+    BOOST_TEST(Provider_t::ResultBit(Noisy.data(), i) == pStatus->IsNoisy(channel));
+    BOOST_TEST(Provider_t::ResultBit(Good.data(), i) == pStatus->IsGood(channel));
+  } // for channel
+
 } // test_simple_status()
 
 //